@@ -10,5 +10,7 @@ public class DemoTarget : TargetRules
 		Type = TargetType.Game;
 		DefaultBuildSettings = BuildSettingsVersion.V2;
 		ExtraModuleNames.Add("Demo");
+		// The grapple state replication marks properties dirty through the push model (the editor target has it on already)
+		bWithPushModel = true;
 	}
 }
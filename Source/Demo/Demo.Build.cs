@@ -8,8 +8,8 @@ public class Demo : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "HeadMountedDisplay", "CableComponent" });
-		PrivateDependencyModuleNames.AddRange(new string[] { "CableComponent" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "HeadMountedDisplay", "NetCore", "SignificanceManager", "MassEntity", "MassCommon", "MassSpawner", "StructUtils" });
+		PrivateDependencyModuleNames.AddRange(new string[] { "RenderCore", "RHI", "Chaos", "PhysicsCore", "UMG", "AIModule" });
 
 
     }
@@ -3,3 +3,5 @@
 #pragma once
 
 #include "CoreMinimal.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogGrapple, Log, All);
@@ -0,0 +1,70 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleAnimInstance.h"
+#include "GrappleCharacter.h"
+#include "GrappleMovementComponent.h"
+
+namespace GrappleAnimInstance
+{
+	/** Slower than this counts as standing still */
+	constexpr float MovingSpeedThreshold = 3.f;
+}
+
+/*************************************
+* ANIM INSTANCE PROXY
+*************************************/
+void FGrappleAnimInstanceProxy::Initialize(UAnimInstance* InAnimInstance)
+{
+	FAnimInstanceProxy::Initialize(InAnimInstance);
+
+	Character = Cast<AGrappleCharacter>(InAnimInstance->GetOwningActor());
+}
+
+void FGrappleAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+	FAnimInstanceProxy::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	// the only place the character is touched, everything after this runs off the game thread
+	const AGrappleCharacter* CharacterLocal = Character.Get();
+	if (!CharacterLocal)
+	{
+		return;
+	}
+
+	bGrappleActive = CharacterLocal->GetGrappleActive();
+	bGrappleAttached = CharacterLocal->GetGrappleAttached();
+	bArrived = CharacterLocal->GetArrived();
+	bIsFirstPerson = CharacterLocal->GetIsIfFirstPerson();
+	bJumpTriggered = !bIsFirstPerson && CharacterLocal->GetJumpTriggered();
+	StartDirection = CharacterLocal->GetStartDirection();
+	Velocity = CharacterLocal->GetVelocity();
+	ActorRotation = CharacterLocal->GetActorRotation();
+	AimPitch = FRotator::NormalizeAxis(CharacterLocal->GetBaseAimRotation().Pitch);
+	const UGrappleMovementComponent* MovementLocal = CharacterLocal->GetGrappleMovement();
+	bIsFalling = MovementLocal && MovementLocal->IsFalling();
+}
+
+void FGrappleAnimInstanceProxy::Update(float DeltaSeconds)
+{
+	FAnimInstanceProxy::Update(DeltaSeconds);
+
+	GroundSpeed = Velocity.Size2D();
+	bIsMoving = GroundSpeed > GrappleAnimInstance::MovingSpeedThreshold;
+	Direction = bIsMoving ? FRotator::NormalizeAxis(Velocity.Rotation().Yaw - ActorRotation.Yaw) : 0.f;
+	bIsPulled = bGrappleAttached && !bArrived;
+}
+
+/*************************************
+* ANIM INSTANCE
+*************************************/
+FAnimInstanceProxy* UGrappleAnimInstance::CreateAnimInstanceProxy()
+{
+	// the proxy lives in the instance so the graph can read it as a member
+	return &Proxy;
+}
+
+void UGrappleAnimInstance::DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy)
+{
+	// owned by the instance, nothing to free
+}
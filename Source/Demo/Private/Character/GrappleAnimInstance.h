@@ -0,0 +1,112 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "GrappleAnimInstance.generated.h"
+
+class AGrappleCharacter;
+
+/**
+ * Animation state of a grapple character. PreUpdate copies the character's grapple and locomotion state once per frame on the game thread,
+ * Update derives the rest on the animation worker thread. Anim graphs read these members directly (Proxy.X), which stays on the fast path.
+ */
+USTRUCT(BlueprintType)
+struct FGrappleAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FGrappleAnimInstanceProxy() = default;
+	FGrappleAnimInstanceProxy(UAnimInstance* InAnimInstance) : FAnimInstanceProxy(InAnimInstance) {}
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+public:
+	/********************************
+	* SNAPSHOT (GAME THREAD)
+	********************************/
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Grappling")
+	bool bGrappleActive{ false };
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Grappling")
+	bool bGrappleAttached{ false };
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Grappling")
+	bool bArrived{ false };
+	/** Third person only, set from the jump press to its release */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Jump")
+	bool bJumpTriggered{ false };
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Movement")
+	bool bIsFalling{ false };
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Movement")
+	bool bIsFirstPerson{ false };
+	/** See AGrappleCharacter::StartDirection */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Movement")
+	int32 StartDirection{ 0 };
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Movement")
+	FVector Velocity{ 0.f };
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Movement")
+	FRotator ActorRotation{ 0.f };
+	/** Pitch of the aim, for aim offsets */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Movement")
+	float AimPitch{ 0.f };
+
+	/********************************
+	* DERIVED (WORKER THREAD)
+	********************************/
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Movement")
+	float GroundSpeed{ 0.f };
+	/** Yaw of the velocity relative to the actor (-180 to 180) */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Movement")
+	float Direction{ 0.f };
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Movement")
+	bool bIsMoving{ false };
+	/** Pulled along the cable (attached and not yet arrived) */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Grappling")
+	bool bIsPulled{ false };
+
+protected:
+	/** Owner, cached on initialization. Only read in PreUpdate (game thread) */
+	TWeakObjectPtr<AGrappleCharacter> Character;
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* INHERITED METHODS
+	********************************/
+protected:
+	virtual void Initialize(UAnimInstance* InAnimInstance) override;
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+	virtual void Update(float DeltaSeconds) override;
+};
+
+/**
+ * Native base for the grapple character anim blueprints. Everything the graph needs is in Proxy, so the whole update runs on a worker thread
+ * and nothing calls into the anim blueprint from gameplay code.
+ */
+UCLASS(Transient, Blueprintable)
+class UGrappleAnimInstance : public UAnimInstance
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Grappling", meta = (AllowPrivateAccess = "true"))
+	FGrappleAnimInstanceProxy Proxy;
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* INHERITED METHODS
+	********************************/
+protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override;
+
+	friend struct FGrappleAnimInstanceProxy;
+};
@@ -0,0 +1,129 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleBotController.h"
+#include "GrappleCharacter.h"
+#include "GrappleMovementComponent.h"
+#include "Grapple/GrappleAnchorSubsystem.h"
+#include "Grapple/GrappleStats.h"
+
+namespace GrappleBot
+{
+	/** How far past the target the bot traces, anchors sit on the surface they belong to */
+	constexpr float TraceOvershoot = 25.f;
+}
+
+AGrappleBotController::AGrappleBotController()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	bWantsPlayerState = false;
+}
+
+void AGrappleBotController::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (!GrappleCharacter || !HasAuthority())
+	{
+		return;
+	}
+
+	StateTime += DeltaSeconds;
+	if (GrappleCharacter->GetGrappleActive())
+	{
+		// hold at a high anchor for a while, give up on a grapple that doesn't get anywhere
+		ArrivedTime += GrappleCharacter->GetArrived() ? DeltaSeconds : 0.f;
+		if (ArrivedTime >= HoldTime || StateTime >= MaxGrappleTime)
+		{
+			GrappleCharacter->GetGrappleMovement()->RequestGrappleRelease();
+		}
+		return;
+	}
+
+	if (bGrappling)
+	{
+		// the grapple ended (broke off, dropped or was rejected), wait before the next one
+		bGrappling = false;
+		BeginIdle();
+		return;
+	}
+
+	if (StateTime >= IdleTime)
+	{
+		if (FireAtRandomTarget())
+		{
+			bGrappling = true;
+			StateTime = 0.f;
+			ArrivedTime = 0.f;
+		}
+		else
+		{
+			++NumMisses;
+			BeginIdle();
+		}
+	}
+}
+
+void AGrappleBotController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	GrappleCharacter = Cast<AGrappleCharacter>(InPawn);
+	bGrappling = false;
+	BeginIdle();
+}
+
+void AGrappleBotController::OnUnPossess()
+{
+	GrappleCharacter = nullptr;
+
+	Super::OnUnPossess();
+}
+
+void AGrappleBotController::SetRandomSeed(int32 Seed)
+{
+	RandomStream.Initialize(Seed);
+}
+
+bool AGrappleBotController::FireAtRandomTarget()
+{
+	const USceneComponent* GunLocal = GrappleCharacter->GetGrappleGun();
+	const FVector StartLocal = GunLocal ? GunLocal->GetComponentLocation() : GrappleCharacter->GetPawnViewLocation();
+	const float RangeLocal = GrappleCharacter->GetGrappleLength();
+
+	// a random anchor in range if the world has any, else a random direction ahead and up
+	FVector TargetLocal{ 0.f };
+	const UGrappleAnchorSubsystem* AnchorSubsystemLocal = GetWorld()->GetSubsystem<UGrappleAnchorSubsystem>();
+	if (!AnchorSubsystemLocal || !AnchorSubsystemLocal->FindAnchorInRange(StartLocal, RangeLocal, RandomStream, TargetLocal))
+	{
+		const FRotator AimLocal(RandomStream.FRandRange(MinAimPitch, MaxAimPitch), RandomStream.FRandRange(-180.f, 180.f), 0.f);
+		TargetLocal = StartLocal + (AimLocal.Vector() * RangeLocal);
+	}
+	++NumShots;
+
+	// turn to it like a player would, the aim replicates to the other machines
+	const FVector ToTargetLocal = TargetLocal - StartLocal;
+	const double DistanceLocal = ToTargetLocal.Size();
+	if (DistanceLocal <= KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+	SetControlRotation(ToTargetLocal.Rotation());
+
+	GRAPPLE_INC_COUNTER(Traces, 1);
+	FHitResult HitResultLocal;
+	const FVector EndLocal = StartLocal + (ToTargetLocal * ((DistanceLocal + GrappleBot::TraceOvershoot) / DistanceLocal));
+	if (!GetWorld()->LineTraceSingleByObjectType(HitResultLocal, StartLocal, EndLocal, GrappleCharacter->GetGrappleObjectQueryParams(), GrappleCharacter->GetGrappleQueryParams()))
+	{
+		return false;
+	}
+
+	GrappleCharacter->GetGrappleMovement()->RequestGrapple(HitResultLocal.Location, HitResultLocal.GetComponent());
+	return true;
+}
+
+void AGrappleBotController::BeginIdle()
+{
+	StateTime = 0.f;
+	IdleTime = RandomStream.FRandRange(MinIdleTime, FMath::Max(MinIdleTime, MaxIdleTime));
+}
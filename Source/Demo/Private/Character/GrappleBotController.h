@@ -0,0 +1,95 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "GrappleBotController.generated.h"
+
+class AGrappleCharacter;
+
+/**
+ * Grapple bot for soak and capacity runs: idles for a random time, turns to a random anchor in range (the anchor subsystem's, else a random
+ * direction ahead and up), fires if a trace reaches something grapplable, and lets go after holding for a while or when a grapple takes too long.
+ * It only issues the grapple movement requests, so bots go through the same movement path as players. Authority only.
+ */
+UCLASS()
+class AGrappleBotController : public AAIController
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	/********************************
+	* BOT SETTINGS
+	********************************/
+	/** Random wait between landing (or a missed shot) and the next shot */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Bot", meta = (ClampMin = "0.0"))
+	float MinIdleTime{ 0.5f };
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Bot", meta = (ClampMin = "0.0"))
+	float MaxIdleTime{ 2.f };
+	/** How long the bot holds at a high anchor before breaking off */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Bot", meta = (ClampMin = "0.0"))
+	float HoldTime{ 1.f };
+	/** A grapple running longer than this (stuck behind geometry) is released */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Bot", meta = (ClampMin = "0.0"))
+	float MaxGrappleTime{ 6.f };
+	/** Pitch range of the random directions tried when there is no anchor in range (degrees) */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Bot")
+	float MinAimPitch{ 10.f };
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Bot")
+	float MaxAimPitch{ 60.f };
+
+	/********************************
+	* BOT RUNTIME
+	********************************/
+	UPROPERTY(Transient)
+	TObjectPtr<AGrappleCharacter> GrappleCharacter;
+	FRandomStream RandomStream;
+	/** Time since the last shot or the start of the idle wait, and the idle time drawn for this wait */
+	float StateTime{ 0.f };
+	float IdleTime{ 0.f };
+	/** Time held at the current anchor */
+	float ArrivedTime{ 0.f };
+	/** A shot was requested and its grapple hasn't ended yet */
+	bool bGrappling{ false };
+	int32 NumShots{ 0 };
+	int32 NumMisses{ 0 };
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	AGrappleBotController();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual void Tick(float DeltaSeconds) override;
+
+protected:
+	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
+
+	/********************************
+	* MEMBER METHODS
+	********************************/
+public:
+	/** Seeds the bot's choices, so a run can be repeated */
+	void SetRandomSeed(int32 Seed);
+
+	FORCEINLINE int32 GetNumShots() const { return NumShots; }
+	FORCEINLINE int32 GetNumMisses() const { return NumMisses; }
+
+protected:
+	/** Picks a target and fires at it if a trace gets there. Returns false on a miss */
+	bool FireAtRandomTarget();
+	/** Starts a new idle wait */
+	void BeginIdle();
+};
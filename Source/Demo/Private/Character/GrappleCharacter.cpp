@@ -2,19 +2,56 @@
 
 
 #include "GrappleCharacter.h"
+#include "GrappleMovementComponent.h"
+#include "GrappleViewComponent.h"
 #include "Components/InputComponent.h"
-#include "GameFramework/CharacterMovementComponent.h"
-#include "Kismet/KismetSystemLibrary.h"
-#include "Kismet/GameplayStatics.h"
-#include "TimerManager.h"
+#include "Materials/MaterialInterface.h"
+#include "UObject/ConstructorHelpers.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "GrappleAnimationInterface.h"
+#include "Grapple/GrappleProfileSubsystem.h"
+#include "Grapple/GrappleSignificanceSubsystem.h"
+#include "Grapple/GrappleSolver.h"
+#include "Grapple/GrappleStats.h"
+
+namespace GrappleCharacter
+{
+	/** How close the aim assist verification trace must hit to the scored anchor (and how far past the anchor it traces) */
+	constexpr float AimAssistVerifyTolerance = 25.f;
+
+	/** Start direction for every whole degree of input yaw (index = yaw + 180). Sectors are 45 degrees wide, the upper bound of each sector is inclusive */
+	const TStaticArray<int16, 360> StartDirectionTable = []()
+	{
+		constexpr int32 SectorUpperBoundsLocal[] = { -156, -112, -66, -22, 21, 65, 111, 155, 179 };
+		constexpr int16 SectorDirectionsLocal[] = { -180, -135, -90, -45, 0, 45, 90, 135, 180 };
+
+		TStaticArray<int16, 360> TableLocal;
+		int32 SectorLocal = 0;
+		for (int32 YawLocal = -180; YawLocal < 180; ++YawLocal)
+		{
+			if (YawLocal > SectorUpperBoundsLocal[SectorLocal])
+			{
+				++SectorLocal;
+			}
+			TableLocal[YawLocal + 180] = SectorDirectionsLocal[SectorLocal];
+		}
+		return TableLocal;
+	}();
+}
 
 
 // Sets default values
-AGrappleCharacter::AGrappleCharacter()
+AGrappleCharacter::AGrappleCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UGrappleMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
+	GRAPPLE_LLM_SCOPE(Character);
+
  	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
+	// only turned on while there is per-frame work, see UpdateTickEnabled
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	// Update capsule
 	GetCapsuleComponent()->InitCapsuleSize(35.f, 90.0f);
@@ -33,16 +70,18 @@ AGrappleCharacter::AGrappleCharacter()
 	GrappleGun = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("GrappleGun"));
 	GrappleGun->SetupAttachment(GetMesh(), FName(TEXT("GripPoint")));
 
-	// Setup grapple cable
-	GrappleCable = CreateDefaultSubobject<UCableComponent>(TEXT("GrappleCable"));
+#if !UE_SERVER
+	// Cosmetic components, a dedicated server never builds them. Game instances only register them once needed (see PreRegisterAllComponents)
+	// Setup grapple cable (runs from the gun to the hook, detail follows the camera distance)
+	GrappleCable = CreateDefaultSubobject<UGrappleRopeComponent>(TEXT("GrappleCable"));
 	GrappleCable->SetupAttachment(GrappleGun);
-	GrappleCable->CableLength = 0.f;
-	GrappleCable->NumSegments = 6;
-	GrappleCable->SolverIterations = 3;
-	GrappleCable->CableWidth = 3.5;
-	GrappleCable->NumSides = 8;
-	GrappleCable->TileMaterial = 8.f;
-	GrappleCable->SetVisibility(false); 
+	GrappleCable->SetVisibility(false);
+	// the Blueprint override was saved against the old cable component class and doesn't load anymore, so the rope material lives here
+	static ConstructorHelpers::FObjectFinder<UMaterialInterface> RopeMaterialLocal(TEXT("/Game/Materials/MI_Rope.MI_Rope"));
+	if (RopeMaterialLocal.Succeeded())
+	{
+		GrappleCable->SetMaterial(0, RopeMaterialLocal.Object);
+	}
 
 	// Setup spring arm ((attaching to mesh instead of capsule))
 	SpringArm = CreateDefaultSubobject<USpringArmComponent>(TEXT("SpringArm"));
@@ -71,6 +110,16 @@ AGrappleCharacter::AGrappleCharacter()
 	FirstPersonMesh->SetRelativeRotation(FRotator(1.92, -19.91, 5.29));
 	FirstPersonMesh->CastShadow = false;
 	FirstPersonMesh->SetVisibility(false);
+	// the arms only animate in first person (see UGrappleViewComponent), never on other players' characters
+	FirstPersonMesh->PrimaryComponentTick.bStartWithTickEnabled = false;
+	FirstPersonMesh->bNoSkeletonUpdate = true;
+#endif
+
+	// View state (starts in third person)
+	ViewState = CreateDefaultSubobject<UGrappleViewComponent>(TEXT("ViewState"));
+
+	// Cache the grapple movement comp (hook flight and pull run inside its movement update)
+	GrappleMovement = Cast<UGrappleMovementComponent>(GetCharacterMovement());
 
 	// Update movement comp (general)
 	GetCharacterMovement()->GravityScale = 1.75f;
@@ -85,28 +134,142 @@ AGrappleCharacter::AGrappleCharacter()
 	// Update movement comp (Nav Movement)
 	GetCharacterMovement()->SetFixedBrakingDistance(200.f);
 
-	// Determine which grapple targets are allowed.
-	GrapplableTargets.Add(EObjectTypeQuery::ObjectTypeQuery1); // world static
-	GrapplableTargets.Add(EObjectTypeQuery::ObjectTypeQuery2); // world dyanmic
-	// To determine what the object type ewas use the collision channel, the engine auto coverts
-	// For more details look at EngineType.h
+	// Significance tiers, High keeps the full detail defaults
+	SignificanceSettings.SetNum(static_cast<int32>(EGrappleSignificance::MAX));
+	{
+		FGrappleSignificanceSettings& OffLocal = SignificanceSettings[static_cast<int32>(EGrappleSignificance::Off)];
+		OffLocal.TickInterval = 0.25f;
+		OffLocal.AnimationTickInterval = 0.25f;
+		OffLocal.bOnlyAnimateWhenRendered = true;
+		OffLocal.MaxGrappleSubsteps = 1;
 
-	// Determine which actors to ignore on grapple trace
-	ActorsToIgnore.Add(this); // technically this is not needed as one of the arguments is to ignore self
+		FGrappleSignificanceSettings& LowLocal = SignificanceSettings[static_cast<int32>(EGrappleSignificance::Low)];
+		LowLocal.TickInterval = 0.1f;
+		LowLocal.AnimationTickInterval = 0.1f;
+		LowLocal.bOnlyAnimateWhenRendered = true;
+		LowLocal.MaxGrappleSubsteps = 2;
+
+		FGrappleSignificanceSettings& MediumLocal = SignificanceSettings[static_cast<int32>(EGrappleSignificance::Medium)];
+		MediumLocal.TickInterval = 1.f / 30.f;
+		MediumLocal.AnimationTickInterval = 1.f / 30.f;
+		MediumLocal.MaxGrappleSubsteps = 4;
+	}
+
+	// Aim probe and aim assist results come back through these delegates
+	AimTraceDelegate.BindUObject(this, &AGrappleCharacter::OnAimProbeCompleted);
+	AimAssistTraceDelegate.BindUObject(this, &AGrappleCharacter::OnAimAssistTraceCompleted);
 }
 
 // Called when the game starts or when spawned
 void AGrappleCharacter::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	UpdateTickEnabled();
+
+	ProfileSubsystem = GetWorld()->GetSubsystem<UGrappleProfileSubsystem>();
+
+	if (UGrappleSignificanceSubsystem* SignificanceSubsystemLocal = GetWorld()->GetSubsystem<UGrappleSignificanceSubsystem>())
+	{
+		SignificanceSubsystemLocal->RegisterCharacter(this);
+	}
+}
+
+void AGrappleCharacter::PreRegisterAllComponents()
+{
+	Super::PreRegisterAllComponents();
+
+	// the class defaults and editor previews keep everything, game instances register the view components for the local player and the cable on its first grapple
+	UWorld* WorldLocal = GetWorld();
+	if (WorldLocal && WorldLocal->IsGameWorld())
+	{
+		for (UActorComponent* ComponentLocal : TArray<UActorComponent*>{ GrappleCable, SpringArm, ThirdPersonCamera, FirstPersonCamera, FirstPersonMesh })
+		{
+			if (ComponentLocal)
+			{
+				ComponentLocal->bAutoRegister = false;
+			}
+		}
+	}
+}
+
+void AGrappleCharacter::PostLoad()
+{
+	Super::PostLoad();
+
+	// Blueprints and placed characters saved before the grapple profile keep their targets as a per character override
+	if (GrapplableTargets_DEPRECATED.Num() > 0)
+	{
+		if (GrapplableTargets_DEPRECATED != GetDefault<UGrappleProfileDataAsset>()->GetGrapplableTargets())
+		{
+			GrapplableTargetsOverride = MoveTemp(GrapplableTargets_DEPRECATED);
+			bGrappleQueryParamsDirty = true;
+		}
+		GrapplableTargets_DEPRECATED.Empty();
+	}
+}
+
+void AGrappleCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	EndTether();
+	SetAnchorComponent(nullptr, FVector::ZeroVector);
+	if (UGrappleSignificanceSubsystem* SignificanceSubsystemLocal = GetWorld()->GetSubsystem<UGrappleSignificanceSubsystem>())
+	{
+		SignificanceSubsystemLocal->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
 void AGrappleCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
-	UpdateStartDirection(); // if wanted this could be branched so it only calls in third person. 
+
+	if (ShouldRunAimProbe())
+	{
+		UpdateStartDirection();
+		RequestAimProbe();
+		UpdateAimAssist();
+	}
+
+	if (GetLocalRole() == ROLE_SimulatedProxy && bGrappleActive && !bGrappleAttached)
+	{
+		UpdateProxyHookFlight();
+	}
+}
+
+void AGrappleCharacter::PossessedBy(AController* NewController)
+{
+	Super::PossessedBy(NewController);
+	UpdateTickEnabled();
+}
+
+void AGrappleCharacter::UnPossessed()
+{
+	Super::UnPossessed();
+	UpdateTickEnabled();
+}
+
+void AGrappleCharacter::OnRep_Controller()
+{
+	Super::OnRep_Controller();
+	UpdateTickEnabled();
+}
+
+void AGrappleCharacter::UpdateTickEnabled()
+{
+	const bool bRunAimProbeLocal = ShouldRunAimProbe();
+	if (!bRunAimProbeLocal)
+	{
+		// nothing keeps the probe or aim assist results current anymore
+		bAimProbeValid = false;
+		bHasAimAssistTarget = false;
+		AimAssistQuery.Reset();
+	}
+
+	const bool bProxyHookInFlightLocal = GetLocalRole() == ROLE_SimulatedProxy && bGrappleActive && !bGrappleAttached;
+	SetActorTickEnabled(bRunAimProbeLocal || bProxyHookInFlightLocal);
 }
 
 // Called to bind functionality to input
@@ -117,6 +280,9 @@ void AGrappleCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCo
 	// Check bindings
 	check(PlayerInputComponent);
 
+	// only ever called for the locally controlled player, the one character that needs its cameras
+	RegisterViewComponents();
+
 	// Axis events
 	PlayerInputComponent->BindAxis("Move Forward / Backward", this, &AGrappleCharacter::MoveForward);
 	PlayerInputComponent->BindAxis("Move Right / Left", this, &AGrappleCharacter::MoveRight);
@@ -133,83 +299,63 @@ void AGrappleCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCo
 }
 
 
-void AGrappleCharacter::UpdateStartDirection_Implementation()
+void AGrappleCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
-	int32 StartDirectionLocal = CalculateInputRotation().Yaw;
-	if (StartDirectionLocal >= 180 && StartDirectionLocal <= -156) // could use the inclusive in range tool but that is more BP based
-	{
-		StartDirection = -180;
-		return; // using returns to keep this tick function from checking other conditions; just trying to be safe
-	}
-	else if (StartDirectionLocal >= -155 && StartDirectionLocal <= -112)
-	{
-		StartDirection = -135;
-		return;
-	}
-	else if (StartDirectionLocal >= -111 && StartDirectionLocal <= -66)
-	{
-		StartDirection = -90;
-		return;
-	}
-	else if (StartDirectionLocal >= -65 && StartDirectionLocal <= -22)
-	{
-		StartDirection = -45; // good number to use for bounding grapple aim area 
-		return;
-	}
-	else if (StartDirectionLocal >= -21 && StartDirectionLocal <= 21)
-	{
-		StartDirection = 0; // directly ahead, used for grapple aim without AO
-		return;
-	}
-	else if (StartDirectionLocal >= 22  && StartDirectionLocal <= 65)
-	{
-		StartDirection = 45; // good number to use for bounding grapple aim area 
-		return;
-	}
-	else if (StartDirectionLocal >= 66 && StartDirectionLocal <= 111)
-	{
-		StartDirection = 90;
-		return;
-	}
-	else if (StartDirectionLocal >= 112 && StartDirectionLocal <= 155)
-	{
-		StartDirection = 135;
-		return;
-	}
-	else if (StartDirectionLocal >= 156 && StartDirectionLocal <= 179) // found that 179 works better than 180 as it willl flip to -180
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// owner predicts its own grapple, only other players need the cosmetic state
+	FDoRepLifetimeParams ParamsLocal;
+	ParamsLocal.bIsPushBased = true;
+	ParamsLocal.Condition = COND_SimulatedOnly;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AGrappleCharacter, GrappleRepState, ParamsLocal);
+}
+
+void AGrappleCharacter::UpdateStartDirection()
+{
+	const FRotator CameraRotationLocal = GetThirdPersonViewRotation();
+	const float CapsuleYawLocal = GetCapsuleComponent()->GetComponentRotation().Yaw;
+	if (!bStartDirectionDirty && CameraRotationLocal == StartDirectionCameraRotation && CapsuleYawLocal == StartDirectionCapsuleYaw)
 	{
-		StartDirection = 180;
 		return;
 	}
+	StartDirectionCameraRotation = CameraRotationLocal;
+	StartDirectionCapsuleYaw = CapsuleYawLocal;
+	bStartDirectionDirty = false;
+
+	// truncated like the original int conversion, 180 falls in the last sector as 179 (found that 179 works better than 180 as it will flip to -180)
+	const int32 YawLocal = FMath::Clamp(static_cast<int32>(CalculateInputRotation().Yaw), -180, 179);
+	StartDirection = GrappleCharacter::StartDirectionTable[YawLocal + 180];
 }
 
-void AGrappleCharacter::MoveForward_Implementation(float AxisValue)
+void AGrappleCharacter::MoveForward(float AxisValue)
 {
+	bStartDirectionDirty |= ForwardAxisRaw != AxisValue;
 	ForwardAxisRaw = AxisValue;
 	// setup abs for locomotion
-	if (!bGrappleActive) // prevent movement while using grapple
+	if (!bGrappleActive || IsTethered()) // prevent movement while using grapple (a tethered body is dragged around by walking)
 	{
 		AddMovementInput(GetCharacterDirectionForward(), ForwardAxisRaw, false);
 	}
 }
 
-void AGrappleCharacter::MoveRight_Implementation(float AxisValue)
+void AGrappleCharacter::MoveRight(float AxisValue)
 {
+	bStartDirectionDirty |= RightAxisRaw != AxisValue;
 	RightAxisRaw = AxisValue;
 	// setup abs for locomotion
-	if (!bGrappleActive) // prevent movement while using grapple
+	if (!bGrappleActive || IsTethered()) // prevent movement while using grapple (a tethered body is dragged around by walking)
 	{
 		AddMovementInput(GetCharacterDirectionRight(), RightAxisRaw, false);
 	}
 }
 
-void AGrappleCharacter::Turn_Implementation(float AxisValue)
+void AGrappleCharacter::Turn(float AxisValue)
 {
 	// store axis value for AO, when AO animations provided. Else just use the default pawn method.
 	AddControllerYawInput(AxisValue);
 }
 
-void AGrappleCharacter::LookUp_Implementation(float AxisValue)
+void AGrappleCharacter::LookUp(float AxisValue)
 {
 	// store axis value for AO, when AO animations provided. Else just use the default pawn method.
 	AddControllerPitchInput(AxisValue);
@@ -217,9 +363,10 @@ void AGrappleCharacter::LookUp_Implementation(float AxisValue)
 
 void AGrappleCharacter::StartJump_Implementation()
 {
+	// the release is applied inside the movement update (stop if still travelling, break off if arrived) so it is predicted and replayed on the server
 	if (bGrappleActive && !bArrived)
 	{
-		StopGrapple();
+		GrappleMovement->RequestGrappleRelease();
 		return;
 	}
 
@@ -227,24 +374,27 @@ void AGrappleCharacter::StartJump_Implementation()
 	{
 		// if grapple is active, break the grapple events off before jumping 
 		// this is also used to exit grapple when at attached locations above the GrappleAcceptedFallDistance
-		BreakGrapple();
+		GrappleMovement->RequestGrappleRelease();
 	}
 	Jump();
+	bJumpTriggered = true;
 	HandleThirdPersonAnimJump(true);
 }
 
 void AGrappleCharacter::EndJump_Implementation()
 {
 	StopJumping();
+	bJumpTriggered = false;
 	HandleThirdPersonAnimJump(false);
 }
 
 void AGrappleCharacter::HandleThirdPersonAnimJump(bool IsJumping)
 {
 	// if not in first person, pass to the animation instance (if valid target) the jump status
-	if (!bIsFirstPerson)
+	UAnimInstance* AnimInstanceLocal = GetMesh()->GetAnimInstance();
+	if (!bIsFirstPerson && AnimInstanceLocal && AnimInstanceLocal->Implements<UGrappleAnimationInterface>())
 	{
-		IGrappleAnimationInterface::Execute_SetJumpTriggered(GetMesh()->GetAnimInstance(), IsJumping);
+		IGrappleAnimationInterface::Execute_SetJumpTriggered(AnimInstanceLocal, IsJumping);
 	}
 }
 
@@ -254,40 +404,82 @@ void AGrappleCharacter::SwitchCamera_Implementation()
 	// improve by increasing FOV (OR reducing spring arm length) on lerp, to zoom (or "zoom") in/out on head before switching cameras 
 	// Alternatively use camera manager to help the transition.
 
-	FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, true);
+	// the aim probe in flight was traced from the old camera
+	bAimProbeValid = false;
 
+	bIsFirstPerson = !bIsFirstPerson;
+	bUseControllerRotationYaw = bIsFirstPerson;
+	ViewState->SetFirstPerson(bIsFirstPerson);
 
-	if (bIsFirstPerson) // switch to third person
-	{
-		FirstPersonCamera->SetActive(false);
-		ThirdPersonCamera->SetActive(true);
-		GetMesh()->SetVisibility(true);
-		FirstPersonMesh->SetVisibility(false);
-		GrappleGun->AttachToComponent(GetMesh(), AttachmentRules, FName(TEXT("GripPoint")));
-		bUseControllerRotationYaw = false;
-		RemoveAimingWidget();
-		bIsFirstPerson = false;
-	}
-	else // switch to first person
+	// without a native widget class the blueprint owns the widget
+	if (!ViewState->ShowAimingWidget(bIsFirstPerson))
 	{
-		ThirdPersonCamera->SetActive(false);
-		FirstPersonCamera->SetActive(true);
-		FirstPersonMesh->SetVisibility(true);
-		GetMesh()->SetVisibility(false);
-		GrappleGun->AttachToComponent(FirstPersonMesh, AttachmentRules, FName(TEXT("GripPoint")));
-		bUseControllerRotationYaw = true;
-		AddAimingWidget();
-		bIsFirstPerson = true;
+		if (bIsFirstPerson)
+		{
+			AddAimingWidget();
+		}
+		else
+		{
+			RemoveAimingWidget();
+		}
 	}
 }
 
 void AGrappleCharacter::Grapple_Implementation()
 {
-	// Calculate the line trace start and ends based on if in first or third person
-	// If in third person, ensure the camera is aimed forward
+	GRAPPLE_SCOPE_CYCLE_COUNTER(Fire);
+
+	// AI doesn't tick, bring the start direction up to date for the aim check
+	UpdateStartDirection();
 
 	FVector StartLocationLocal{ 0.f };
 	FVector EndLocationLocal{ 0.f };
+	if (!CalculateGrappleTrace(StartLocationLocal, EndLocationLocal))
+	{
+		// exit out as the character is not aiming forward
+		return;
+	}
+
+	// use the aim probe result if it is current (no scene query on the input frame), else run the trace now
+	FHitResult HitResultLocal;
+	bool bHitLocal = false;
+	if (bAimProbeValid)
+	{
+		HitResultLocal = AimHitResult;
+		bHitLocal = bHasAimTarget;
+	}
+	else
+	{
+		GRAPPLE_INC_COUNTER(Traces, 1);
+		bHitLocal = GetWorld()->LineTraceSingleByObjectType(HitResultLocal, StartLocationLocal, EndLocationLocal, GetGrappleObjectQueryParams(), GetGrappleQueryParams());
+	}
+
+	// aim missed, fall back to the verified aim assist anchor
+	if (!bHitLocal && bHasAimAssistTarget)
+	{
+		HitResultLocal = AimAssistHitResult;
+		bHitLocal = true;
+	}
+
+	// if blocking hit, start grapple events
+	if (bHitLocal)
+	{
+		// the grapple starts inside the next movement update (predicted locally, sent to the server with the move)
+		GrappleMovement->RequestGrapple(HitResultLocal.Location, HitResultLocal.GetComponent());
+	}
+	else // no blocking hit.
+	{
+		if (bGrappleActive && !bGrappleAttached)
+		{
+			GrappleMovement->RequestGrappleRelease();
+		}
+	}
+}
+
+bool AGrappleCharacter::CalculateGrappleTrace(FVector& OutStart, FVector& OutEnd) const
+{
+	// Calculate the line trace start and ends based on if in first or third person
+	// If in third person, ensure the camera is aimed forward
 	if (!bIsFirstPerson) // character is in third person
 	{
 		// ensure that if in third person, the player is aiming in front of the character mesh
@@ -296,183 +488,586 @@ void AGrappleCharacter::Grapple_Implementation()
 		if (StartDirection != 0) 
 //		if(StartDirection < -45 || StartDirection > 45)
 		{
-			// exit out as the character is not aiming forward
-			return; 
+			return false;
+		}
+
+		OutStart = GetThirdPersonViewLocation();
+		// Temp vector used to combine the mesh location and camera angle (would look better with AO animations)
+		const FVector CombinedVecLocal = FVector(GetMesh()->GetRightVector().X, GetMesh()->GetRightVector().Y, GetThirdPersonViewRotation().Vector().Z);
+		OutEnd = OutStart + (CombinedVecLocal * GetGrappleLength());
+	}
+	else // character is in first person
+	{
+		// the first person camera follows the control rotation from the eyes
+		const bool bCameraLocal = FirstPersonCamera && FirstPersonCamera->IsRegistered();
+		OutStart = bCameraLocal ? FirstPersonCamera->GetComponentLocation() : GetPawnViewLocation();
+		OutEnd = OutStart + ((bCameraLocal ? FirstPersonCamera->GetForwardVector() : GetBaseAimRotation().Vector()) * GetGrappleLength());
+	}
+	return true;
+}
+
+bool AGrappleCharacter::ShouldRunAimProbe() const
+{
+	return IsLocallyControlled() && IsPlayerControlled();
+}
+
+void AGrappleCharacter::RequestAimProbe()
+{
+	FVector StartLocationLocal{ 0.f };
+	FVector EndLocationLocal{ 0.f };
+	if (!CalculateGrappleTrace(StartLocationLocal, EndLocationLocal))
+	{
+		// not aiming forward, nothing to hit
+		bAimProbeValid = false;
+		if (bHasAimTarget)
+		{
+			bHasAimTarget = false;
+			OnAimTargetChanged(false);
+		}
+		return;
+	}
+
+	GRAPPLE_INC_COUNTER(Traces, 1);
+	GetWorld()->AsyncLineTraceByObjectType(EAsyncTraceType::Single, StartLocationLocal, EndLocationLocal, GetGrappleObjectQueryParams(), GetGrappleQueryParams(), &AimTraceDelegate);
+}
+
+void AGrappleCharacter::OnAimProbeCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	const bool bNewHasAimTargetLocal = TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit;
+	AimHitResult = bNewHasAimTargetLocal ? TraceDatum.OutHits[0] : FHitResult();
+	bAimProbeValid = true;
+
+	if (bNewHasAimTargetLocal != bHasAimTarget)
+	{
+		bHasAimTarget = bNewHasAimTargetLocal;
+		OnAimTargetChanged(bHasAimTarget);
+	}
+}
+
+void AGrappleCharacter::UpdateAimAssist()
+{
+	const UGrappleAnchorSubsystem* AnchorSubsystemLocal = GetWorld()->GetSubsystem<UGrappleAnchorSubsystem>();
+	if (!GetGrappleProfile().IsAimAssistEnabled() || !AnchorSubsystemLocal)
+	{
+		bHasAimAssistTarget = false;
+		return;
+	}
+
+	if (AimAssistQuery.IsValid())
+	{
+		if (!AimAssistQuery.IsComplete())
+		{
+			// only one query in flight per character
+			return;
+		}
+
+		if (AimAssistQuery.Result->bFound)
+		{
+			// verify only the winner, one trace no matter how many anchors were scored
+			FVector StartLocationLocal{ 0.f };
+			FVector EndLocationLocal{ 0.f };
+			if (CalculateGrappleTrace(StartLocationLocal, EndLocationLocal))
+			{
+				AimAssistCandidate = AimAssistQuery.Result->Best.Location;
+				const FVector TraceEndLocal = AimAssistCandidate + ((AimAssistCandidate - StartLocationLocal).GetSafeNormal() * GrappleCharacter::AimAssistVerifyTolerance);
+				GRAPPLE_INC_COUNTER(Traces, 1);
+				GetWorld()->AsyncLineTraceByObjectType(EAsyncTraceType::Single, StartLocationLocal, TraceEndLocal, GetGrappleObjectQueryParams(), GetGrappleQueryParams(), &AimAssistTraceDelegate);
+			}
 		}
 		else
 		{
-			StartLocationLocal = ThirdPersonCamera->GetComponentLocation();
-			// Temp vector used to combine the mesh location and camera angle (would look better with AO animations)
-			FVector CombinedVecLocal = FVector(GetMesh()->GetRightVector().X, GetMesh()->GetRightVector().Y, ThirdPersonCamera->GetForwardVector().Z);
-			EndLocationLocal = StartLocationLocal + (CombinedVecLocal * GrappleLength);
+			bHasAimAssistTarget = false;
 		}
+		AimAssistQuery.Reset();
 	}
-	else // character is in first person
+
+	FVector StartLocationLocal{ 0.f };
+	FVector EndLocationLocal{ 0.f };
+	if (!CalculateGrappleTrace(StartLocationLocal, EndLocationLocal))
 	{
-		StartLocationLocal = FirstPersonCamera->GetComponentLocation();
-		EndLocationLocal = StartLocationLocal + (FirstPersonCamera->GetForwardVector() * GrappleLength);
+		bHasAimAssistTarget = false;
+		return;
 	}
 
+	FGrappleAnchorCone ConeLocal;
+	ConeLocal.Origin = StartLocationLocal;
+	ConeLocal.Direction = (EndLocationLocal - StartLocationLocal).GetSafeNormal();
+	ConeLocal.MaxDistance = GetGrappleLength();
+	ConeLocal.HalfAngleDegrees = GetGrappleProfile().GetAimAssistHalfAngle();
+	AimAssistQuery = AnchorSubsystemLocal->StartConeQuery(ConeLocal);
+}
 
-	// run line trace and if blocking hit, start grapple events
-	FHitResult HitResultLocal;
-	if (UKismetSystemLibrary::LineTraceSingleForObjects(GetWorld(), StartLocationLocal, EndLocationLocal, GrapplableTargets, false, ActorsToIgnore, EDrawDebugTrace::None, HitResultLocal, true))
+void AGrappleCharacter::OnAimAssistTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	// the anchor counts if the first thing the trace hits is (close to) the anchor itself
+	const bool bHitLocal = TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit;
+	bHasAimAssistTarget = bHitLocal && FVector::DistSquared(TraceDatum.OutHits[0].Location, AimAssistCandidate) <= FMath::Square(GrappleCharacter::AimAssistVerifyTolerance);
+	AimAssistHitResult = bHasAimAssistTarget ? TraceDatum.OutHits[0] : FHitResult();
+}
+
+const FCollisionObjectQueryParams& AGrappleCharacter::GetGrappleObjectQueryParams() const
+{
+	GetGrappleQueryParams();
+	return GrappleObjectQueryParams;
+}
+
+const FCollisionQueryParams& AGrappleCharacter::GetGrappleQueryParams() const
+{
+	// a profile swap changes the targets without touching this character
+	const UGrappleProfileDataAsset* ProfileLocal = &GetGrappleProfile();
+	if (bGrappleQueryParamsDirty || ProfileLocal != GrappleQueryParamsProfile)
 	{
-		bGrappleActive = true;
-		bArrived = false;
-		AttachLocation = HitResultLocal.Location;
-		GrappleCable->SetVisibility(true);
-		GetWorld()->GetTimerManager().SetTimer(GrappleTH, this, &AGrappleCharacter::StartGrapple, 0.01f, true);
+		// same settings the kismet object trace used (simple collision, ignore self)
+		GrappleObjectQueryParams = FCollisionObjectQueryParams(GetGrapplableTargets());
+		GrappleQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(GrappleAim), false, this);
+		GrappleQueryParams.AddIgnoredActors(ActorsToIgnore);
+		GrappleQueryParamsProfile = ProfileLocal;
+		bGrappleQueryParamsDirty = false;
 	}
-	else // no blocking hit.
+	return GrappleQueryParams;
+}
+
+void AGrappleCharacter::HandleGrappleStarted(const FVector& NewAttachLocation, USceneComponent* NewAnchorComponent)
+{
+	bGrappleActive = true;
+	bArrived = false;
+	AttachLocation = NewAttachLocation;
+	// static and stationary components never move, their attach location is final
+	const bool bFollowAnchorLocal = NewAnchorComponent && NewAnchorComponent->Mobility == EComponentMobility::Movable;
+	SetAnchorComponent(bFollowAnchorLocal ? NewAnchorComponent : nullptr, bFollowAnchorLocal ? NewAnchorComponent->GetComponentTransform().InverseTransformPosition(NewAttachLocation) : FVector::ZeroVector);
+	ShowGrappleCable(true);
+	UpdateGrappleRepState(true);
+	if (ShouldBroadcastGrappleEvents())
+	{
+		GRAPPLE_TRACE_LIFECYCLE(this, Fire, AttachLocation);
+		OnGrappleFired(AttachLocation);
+	}
+}
+
+void AGrappleCharacter::HandleGrappleAttached()
+{
+	bGrappleAttached = true;
+	UpdateGrappleRepState();
+	if (ShouldBroadcastGrappleEvents())
+	{
+		GRAPPLE_TRACE_LIFECYCLE(this, Attach, AttachLocation);
+		OnGrappleAttached();
+	}
+}
+
+bool AGrappleCharacter::BeginTether()
+{
+	EndTether();
+	if (!GetGrappleProfile().ShouldTetherPhysicsBodies())
+	{
+		return false;
+	}
+
+	UPrimitiveComponent* BodyLocal = Cast<UPrimitiveComponent>(AnchorComponent.Get());
+	if (!BodyLocal || !BodyLocal->IsSimulatingPhysics())
+	{
+		return false;
+	}
+
+	TetherBody = BodyLocal;
+	if (HasAuthority())
 	{
-		if (!bGrappleAttached)
+		if (UGrappleTetherSubsystem* TetherSubsystemLocal = GetWorld()->GetSubsystem<UGrappleTetherSubsystem>())
 		{
-			StopGrapple();
+			TetherId = TetherSubsystemLocal->AddTether(BodyLocal, AttachLocation, GrappleGun, GetGrappleProfile().GetTetherSettings());
 		}
 	}
+	return true;
 }
 
-void AGrappleCharacter::StartGrapple_Implementation()
+void AGrappleCharacter::EndTether()
 {
-	// ensure the timer should be active.
-	if (bGrappleActive)
+	if (TetherId != INDEX_NONE)
 	{
-		// First (else) move grapple end part to attach location, then move character along grapple
-		if (bGrappleAttached)
+		if (UGrappleTetherSubsystem* TetherSubsystemLocal = GetWorld()->GetSubsystem<UGrappleTetherSubsystem>())
 		{
-			// once grapple is attached move player
-			MovePlayerToGrappledLocation();
-			// Update grapple cable's location (true on the sweep) - use player attach speed as at this point the grapple is moving with the player
-			GrappleCable->SetWorldLocation(UKismetMathLibrary::VInterpTo(GrappleCable->GetComponentLocation(), AttachLocation, UGameplayStatics::GetWorldDeltaSeconds(GetWorld()), PlayerGrappleSpeed), true);
+			TetherSubsystemLocal->RemoveTether(TetherId);
 		}
-		else
+		TetherId = INDEX_NONE;
+	}
+	TetherBody.Reset();
+}
+
+void AGrappleCharacter::HandleGrappleArrived()
+{
+	bArrived = true;
+	if (!GrappleMovement->IsFirstPersonMove()) // third person holds at the attach location facing the control rotation
+	{
+		bUseControllerRotationYaw = true;
+	}
+	UpdateGrappleRepState();
+	if (ShouldBroadcastGrappleEvents())
+	{
+		GRAPPLE_TRACE_LIFECYCLE(this, Arrive, GetActorLocation());
+		OnGrappleArrived();
+	}
+}
+
+void AGrappleCharacter::AdoptGrappleState(const FVector& InAttachLocation, const FVector& InHookLocation, bool bInAttached, bool bInArrived)
+{
+	HandleGrappleStarted(InAttachLocation, nullptr);
+	GrappleMovement->AdoptGrapple(InHookLocation, bInAttached, bInArrived);
+}
+
+void AGrappleCharacter::RestoreGrappleState(bool bInGrappleActive, bool bInGrappleAttached, bool bInArrived, const FVector& InAttachLocation, USceneComponent* InAnchorComponent, const FVector& InAnchorLocalOffset)
+{
+	bGrappleActive = bInGrappleActive;
+	bGrappleAttached = bInGrappleAttached;
+	bArrived = bInArrived;
+	AttachLocation = InAttachLocation;
+	SetAnchorComponent(InAnchorComponent, InAnchorLocalOffset);
+	ShowGrappleCable(bGrappleActive);
+}
+
+bool AGrappleCharacter::UpdateAnchor()
+{
+	if (AnchorComponent.IsExplicitlyNull())
+	{
+		return false;
+	}
+
+	const USceneComponent* AnchorComponentLocal = AnchorComponent.Get();
+	if (!AnchorComponentLocal || !AnchorComponentLocal->IsRegistered() || AnchorComponentLocal->IsBeingDestroyed())
+	{
+		// destroyed or streamed out, the last known location stays so nothing jumps
+		SetAnchorComponent(nullptr, FVector::ZeroVector);
+		if (bGrappleActive && IsLocallyControlled())
 		{
-			// Move grapple end to attach location. Once there it will set bGrappleAtttached to true
-			MoveGrappleTo();
+			// a remote client sees the component go as well and sends its own release
+			GrappleMovement->RequestGrappleRelease();
 		}
+		return false;
 	}
-	else
+
+	AttachLocation = AnchorComponentLocal->GetComponentTransform().TransformPosition(AnchorLocalOffset);
+	return true;
+}
+
+void AGrappleCharacter::SetAnchorComponent(USceneComponent* NewAnchorComponent, const FVector& NewAnchorLocalOffset)
+{
+	AnchorLocalOffset = NewAnchorLocalOffset;
+	USceneComponent* OldAnchorComponentLocal = AnchorComponent.Get();
+	if (NewAnchorComponent == OldAnchorComponentLocal)
+	{
+		// also forgets a component that is gone (its prerequisite went with it)
+		AnchorComponent = NewAnchorComponent;
+		return;
+	}
+
+	// the movement update reads the anchor transform, so it runs after whatever moves the anchor: the component itself or its owner's tick
+	if (OldAnchorComponentLocal)
 	{
-		// catch if the timer is active, when it shouldn't be and kill timer.
-		ClearGrappleTimer();
+		GrappleMovement->RemoveTickPrerequisiteComponent(OldAnchorComponentLocal);
+		if (AActor* OldAnchorOwnerLocal = OldAnchorComponentLocal->GetOwner())
+		{
+			GrappleMovement->RemoveTickPrerequisiteActor(OldAnchorOwnerLocal);
+		}
+	}
+	AnchorComponent = NewAnchorComponent;
+	if (NewAnchorComponent)
+	{
+		GrappleMovement->AddTickPrerequisiteComponent(NewAnchorComponent);
+		if (AActor* NewAnchorOwnerLocal = NewAnchorComponent->GetOwner())
+		{
+			GrappleMovement->AddTickPrerequisiteActor(NewAnchorOwnerLocal);
+		}
 	}
 }
 
-void AGrappleCharacter::MoveGrappleTo_Implementation()
+void AGrappleCharacter::SetGrappleSignificance(EGrappleSignificance NewSignificance)
 {
-	// GrappleCable->SetVisibility(true); // if for some reason the cable is not visible when this function gets called, uncomment
-	float VSizeLocal = UKismetMathLibrary::VSize(GrappleCable->GetComponentLocation() - AttachLocation); // could also try normal()/safenormal then use vector::size instead of this approach
-	
-	if (VSizeLocal <= 10.f) // could convert the literal to a variable but this is less a design or gameplay factor than the other variables
+	if (NewSignificance == GrappleSignificance || !SignificanceSettings.IsValidIndex(static_cast<int32>(NewSignificance)))
 	{
-		// Grapple end has reached the attach location
-		bGrappleAttached = true;
+		return;
 	}
-	else
+	GrappleSignificance = NewSignificance;
+	const FGrappleSignificanceSettings& SettingsLocal = SignificanceSettings[static_cast<int32>(NewSignificance)];
+
+	SetActorTickInterval(SettingsLocal.TickInterval);
+
+	GetMesh()->SetComponentTickInterval(SettingsLocal.AnimationTickInterval);
+	GetMesh()->VisibilityBasedAnimTickOption = SettingsLocal.bOnlyAnimateWhenRendered ? EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered : EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+	// players keep the substeps their client predicted with
+	GrappleMovement->SetGrappleSubstepLimit(IsPlayerControlled() ? 0 : SettingsLocal.MaxGrappleSubsteps);
+}
+
+void AGrappleCharacter::UpdateGrappleCable(const FVector& HookLocation)
+{
+	if (GrappleCable)
 	{
-		// grapple is travelling to the attach location - Update grapple cable's location (true on the sweep) - use grapple attach speed as the grapple is moving on its own
-		GrappleCable->SetWorldLocation(UKismetMathLibrary::VInterpTo(GrappleCable->GetComponentLocation(), AttachLocation, UGameplayStatics::GetWorldDeltaSeconds(GetWorld()), GrappleAttachSpeed), true);
-		bGrappleAttached = false;
+		GrappleCable->SetHookLocation(HookLocation);
 	}
 }
 
-void AGrappleCharacter::MovePlayerToGrappledLocation_Implementation()
+void AGrappleCharacter::UpdateGrappleCableWrapPoints(TConstArrayView<FVector> WrapPoints)
 {
-	if (bGrappleActive && bArrived && !bIsFirstPerson) // handles if the player arrived in third person to the attach location
+	if (GrappleCable)
 	{
-		GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Flying);
-		bUseControllerRotationYaw = true;
-		GetCharacterMovement()->Velocity = FVector{ 0 };
+		GrappleCable->SetWrapPoints(WrapPoints);
 	}
-	else
+}
+
+void AGrappleCharacter::ShowGrappleCable(bool bShow)
+{
+	if (!GrappleCable)
 	{
-		// Move character by launching them, towards the attach location
-		FVector LaunchVelocityLocal = (AttachLocation - GetActorLocation()) * (UGameplayStatics::GetWorldDeltaSeconds(GetWorld()) * PlayerGrappleSpeed);
-		LaunchCharacter(LaunchVelocityLocal, true, true);
+		return;
+	}
+	if (bShow && !GrappleCable->IsRegistered() && !IsNetMode(NM_DedicatedServer))
+	{
+		GrappleCable->RegisterComponent();
+	}
+	GrappleCable->SetVisibility(bShow);
+}
+
+FRotator AGrappleCharacter::GetThirdPersonViewRotation() const
+{
+	// the spring arm follows the control rotation, so does the camera at its end
+	return ThirdPersonCamera && ThirdPersonCamera->IsRegistered() ? ThirdPersonCamera->GetComponentRotation() : GetBaseAimRotation();
+}
+
+FVector AGrappleCharacter::GetThirdPersonViewLocation() const
+{
+	return ThirdPersonCamera && ThirdPersonCamera->IsRegistered() ? ThirdPersonCamera->GetComponentLocation() : GetPawnViewLocation();
+}
+
+void AGrappleCharacter::RegisterViewComponents()
+{
+	if (IsNetMode(NM_DedicatedServer))
+	{
+		return;
+	}
 
-		// yes the next check could have been done in C++ but the function exists and I am already using the library (kind of more wanting to show I know the API than C++ with this one)
-		// Check if the player has arrived, and if so, are they low enough to the ground to drop to it 
-		if (UKismetMathLibrary::EqualEqual_VectorVector(GetActorLocation(), AttachLocation, GrappleAcceptanceRadius))
+	// parents first, the attachment is only made on registration
+	for (UActorComponent* ComponentLocal : TArray<UActorComponent*>{ SpringArm, ThirdPersonCamera, FirstPersonCamera, FirstPersonMesh })
+	{
+		if (ComponentLocal && !ComponentLocal->IsRegistered())
 		{
-			FHitResult HitResultLocal;
-			FVector EndLocationLocal = GetActorLocation() - FVector(0.f, 0.f, GrappleAcceptedFallDistance);
-			if (GetWorld()->LineTraceSingleByChannel(HitResultLocal, GetActorLocation(), EndLocationLocal, ECollisionChannel::ECC_Visibility))
-			{
-				BreakGrapple();
-			}
-			else
-			{
-				// no blocking hit, the character is too high to automatically disconnect
-				bArrived = true;
-			}
+			ComponentLocal->RegisterComponent();
 		}
 	}
 }
 
+bool AGrappleCharacter::ShouldBroadcastGrappleEvents() const
+{
+	return !GrappleMovement->bClientUpdating;
+}
+
+void AGrappleCharacter::UpdateGrappleRepState(bool bFired)
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	FGrappleRepState NewStateLocal;
+	// proxies follow the anchor component themselves if they can resolve it, else they get the location it had when the state changed
+	USceneComponent* AnchorComponentLocal = AnchorComponent.Get();
+	if (AnchorComponentLocal && AnchorComponentLocal->IsSupportedForNetworking())
+	{
+		NewStateLocal.Anchor = AnchorLocalOffset;
+		NewStateLocal.AnchorComponent = AnchorComponentLocal;
+	}
+	else
+	{
+		NewStateLocal.Anchor = AttachLocation;
+	}
+	NewStateLocal.StateFlags = static_cast<uint8>((bGrappleActive ? EGrappleStateFlags::Active : EGrappleStateFlags::None)
+		| (bGrappleAttached ? EGrappleStateFlags::Attached : EGrappleStateFlags::None)
+		| (bArrived ? EGrappleStateFlags::Arrived : EGrappleStateFlags::None));
+	NewStateLocal.ServerFireTime = bFired ? GetWorld()->GetTimeSeconds() : GrappleRepState.ServerFireTime;
+
+	if (NewStateLocal != GrappleRepState)
+	{
+		GrappleRepState = NewStateLocal;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AGrappleCharacter, GrappleRepState, this);
+	}
+}
+
+void AGrappleCharacter::OnRep_GrappleRepState(const FGrappleRepState& PreviousState)
+{
+	bGrappleActive = GrappleRepState.HasFlag(EGrappleStateFlags::Active);
+	bGrappleAttached = GrappleRepState.HasFlag(EGrappleStateFlags::Attached);
+	bArrived = GrappleRepState.HasFlag(EGrappleStateFlags::Arrived);
+	if (USceneComponent* AnchorComponentLocal = bGrappleActive ? GrappleRepState.AnchorComponent.Get() : nullptr)
+	{
+		SetAnchorComponent(AnchorComponentLocal, GrappleRepState.Anchor);
+		AttachLocation = AnchorComponentLocal->GetComponentTransform().TransformPosition(AnchorLocalOffset);
+	}
+	else
+	{
+		SetAnchorComponent(nullptr, FVector::ZeroVector);
+		AttachLocation = GrappleRepState.Anchor;
+	}
+	ShowGrappleCable(bGrappleActive);
+
+	const bool bNewShotLocal = bGrappleActive && (!PreviousState.HasFlag(EGrappleStateFlags::Active) || PreviousState.ServerFireTime != GrappleRepState.ServerFireTime);
+	if (bNewShotLocal)
+	{
+		// new shot, the hook leaves the gun wherever it is on this machine
+		ProxyHookStart = GrappleGun->GetComponentLocation();
+	}
+	UpdateProxyHookFlight();
+	// tick only while the hook is in flight
+	UpdateTickEnabled();
+
+	// broadcast the transitions the replicated state went through
+	if (!bGrappleActive && PreviousState.HasFlag(EGrappleStateFlags::Active))
+	{
+		OnGrappleReleased();
+		return;
+	}
+	if (bNewShotLocal)
+	{
+		OnGrappleFired(AttachLocation);
+	}
+	if (bGrappleAttached && (bNewShotLocal || !PreviousState.HasFlag(EGrappleStateFlags::Attached)))
+	{
+		OnGrappleAttached();
+	}
+	if (bArrived && (bNewShotLocal || !PreviousState.HasFlag(EGrappleStateFlags::Arrived)))
+	{
+		OnGrappleArrived();
+	}
+}
+
+void AGrappleCharacter::UpdateProxyHookFlight()
+{
+	if (!bGrappleActive)
+	{
+		return;
+	}
+
+	if (bGrappleAttached)
+	{
+		UpdateGrappleCable(AttachLocation);
+		return;
+	}
+
+	// same exponential flight the movement component runs, evaluated at the time since the server fired
+	const AGameStateBase* GameStateLocal = GetWorld()->GetGameState();
+	const float FlightTimeLocal = GameStateLocal ? FMath::Max(0.f, static_cast<float>(GameStateLocal->GetServerWorldTimeSeconds() - GrappleRepState.ServerFireTime)) : 0.f;
+	UpdateGrappleCable(FGrappleSolver::GetHookLocation(ProxyHookStart, AttachLocation, GetGrappleAttachSpeed(), FlightTimeLocal));
+}
+
 void AGrappleCharacter::BreakGrapple_Implementation()
 {
-	LaunchCharacter(BreakOffGrappleVelocity, false, false);
+	if (bGrappleActive && ShouldBroadcastGrappleEvents())
+	{
+		GRAPPLE_TRACE_LIFECYCLE(this, Break, GetActorLocation());
+	}
+	LaunchCharacter(GetBreakOffGrappleVelocity(), false, false);
 	StopGrapple();
 }
 
 void AGrappleCharacter::StopGrapple_Implementation()
 {
-	ClearGrappleTimer();
+	const bool bWasActiveLocal = bGrappleActive;
 	bGrappleActive = false;
 	bGrappleAttached = false;
-	GrappleCable->SetVisibility(false);
+	EndTether();
+	SetAnchorComponent(nullptr, FVector::ZeroVector);
+	GrappleMovement->EndGrapple();
+	ShowGrappleCable(false);
+	UpdateGrappleRepState();
 	// reset location of grapple here if grapple is glitching on re-use
 	if (!bIsFirstPerson)
 	{
 		bUseControllerRotationYaw = false; //reset controller rotation 
 	}
+	if (bWasActiveLocal && ShouldBroadcastGrappleEvents())
+	{
+		GRAPPLE_TRACE_LIFECYCLE(this, Release, GetActorLocation());
+		OnGrappleReleased();
+	}
 }
 
-void AGrappleCharacter::ClearGrappleTimer()
+const UGrappleProfileDataAsset& AGrappleCharacter::GetGrappleProfile() const
 {
-	if (GetWorld()->GetTimerManager().TimerExists(GrappleTH))
+	if (ActiveProfile)
 	{
-		GetWorld()->GetTimerManager().ClearTimer(GrappleTH);
+		return *ActiveProfile;
 	}
+	if (const UGrappleProfileDataAsset* WorldProfileLocal = ProfileSubsystem ? ProfileSubsystem->GetWorldProfile() : nullptr)
+	{
+		return *WorldProfileLocal;
+	}
+	return GrappleProfile ? *GrappleProfile : *GetDefault<UGrappleProfileDataAsset>();
+}
+
+void AGrappleCharacter::SetGrappleProfile(const UGrappleProfileDataAsset* NewProfile)
+{
+	// the query params notice the change on their own
+	ActiveProfile = NewProfile;
+}
+
+void AGrappleCharacter::ClearProfileOverrides()
+{
+	ProfileOverrides = FGrappleProfileOverrides();
+	bGrappleQueryParamsDirty |= GrapplableTargetsOverride.Num() > 0;
+	GrapplableTargetsOverride.Empty();
 }
 
 void AGrappleCharacter::AddToGrappableTargets(const TEnumAsByte<EObjectTypeQuery>& NewTarget)
 {
-	GrapplableTargets.AddUnique(NewTarget);
+	if (GetGrapplableTargets().Contains(NewTarget))
+	{
+		return;
+	}
+	// copied from the profile on the first change, the profile itself is shared
+	if (GrapplableTargetsOverride.Num() == 0)
+	{
+		GrapplableTargetsOverride = GetGrappleProfile().GetGrapplableTargets();
+	}
+	GrapplableTargetsOverride.Add(NewTarget);
+	bGrappleQueryParamsDirty = true;
 }
 
 void AGrappleCharacter::AddActorsToIgnore(AActor* NewActor)
 {
+	const int32 NumActorsLocal = ActorsToIgnore.Num();
 	ActorsToIgnore.AddUnique(NewActor);
+	bGrappleQueryParamsDirty |= ActorsToIgnore.Num() != NumActorsLocal;
 }
 
 void AGrappleCharacter::SetGrappleLength(const float& NewLength)
 {
-	GrappleLength = NewLength;
+	ProfileOverrides.bOverride_GrappleLength = true;
+	ProfileOverrides.GrappleLength = NewLength;
 }
 
 void AGrappleCharacter::SetGrappleAttachSpeed(const float& NewSpeed)
 {
-	GrappleAttachSpeed = NewSpeed;
+	ProfileOverrides.bOverride_GrappleAttachSpeed = true;
+	ProfileOverrides.GrappleAttachSpeed = NewSpeed;
 }
 
 void AGrappleCharacter::SetPlayerGrappleSpeed(const float& NewSpeed)
 {
-	PlayerGrappleSpeed = NewSpeed;
+	ProfileOverrides.bOverride_PlayerGrappleSpeed = true;
+	ProfileOverrides.PlayerGrappleSpeed = NewSpeed;
 }
 
 void AGrappleCharacter::SetBreakOffGrappleVelocity(const FVector& NewVelocity)
 {
-	BreakOffGrappleVelocity = NewVelocity;
+	ProfileOverrides.bOverride_BreakOffGrappleVelocity = true;
+	ProfileOverrides.BreakOffGrappleVelocity = NewVelocity;
 }
 
 void AGrappleCharacter::SetGrappleAcceptanceRadius(const float& NewRadius)
 {
-	GrappleAcceptanceRadius = NewRadius;
+	ProfileOverrides.bOverride_GrappleAcceptanceRadius = true;
+	ProfileOverrides.GrappleAcceptanceRadius = NewRadius;
 }
 
 void AGrappleCharacter::SetGrappleAcceptedFallDistance(const float& NewDistance)
 {
-	GrappleAcceptedFallDistance = NewDistance;
+	ProfileOverrides.bOverride_GrappleAcceptedFallDistance = true;
+	ProfileOverrides.GrappleAcceptedFallDistance = NewDistance;
 }
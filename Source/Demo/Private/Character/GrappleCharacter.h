@@ -5,17 +5,30 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "Components/CapsuleComponent.h"
-#include "CableComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Camera/CameraComponent.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "GrappleTypes.h"
+#include "Grapple/GrappleAnchorSubsystem.h"
+#include "Grapple/GrappleProfileDataAsset.h"
+#include "Grapple/GrappleRopeComponent.h"
+#include "Grapple/GrappleTetherSubsystem.h"
 #include "GrappleCharacter.generated.h"
 
+class UGrappleMovementComponent;
+class UGrappleViewComponent;
+class UGrappleProfileSubsystem;
+
 UCLASS()
 class AGrappleCharacter : public ACharacter
 {
 	GENERATED_BODY()
 
+	/** Replays recorded input through the input handlers */
+	friend class UGrappleInputRecorderComponent;
+	/** Times the input handlers natively and through ProcessEvent */
+	friend class UGrappleDispatchBenchmarkCommandlet;
+
 /*************************************
 * ATTRIBUTES
 *************************************/
@@ -28,7 +41,7 @@ protected:
 	TObjectPtr<USkeletalMeshComponent> GrappleGun;
 	/** The cable that will represent the the grappling rope/cable */
 	UPROPERTY(BlueprintReadonly, EditDefaultsOnly, Category = "Components")
-	TObjectPtr<class UCableComponent> GrappleCable;
+	TObjectPtr<UGrappleRopeComponent> GrappleCable;
 	/** Camera spring arm */
 	UPROPERTY(BlueprintReadonly, EditDefaultsOnly, Category = "Components")
 	TObjectPtr<USpringArmComponent> SpringArm;
@@ -41,6 +54,12 @@ protected:
 	/** Arms mesh used for first person */
 	UPROPERTY(BlueprintReadonly, EditDefaultsOnly, Category = "Components")
 	TObjectPtr<USkeletalMeshComponent> FirstPersonMesh;
+	/** The character movement component cast to the grapple movement component (runs hook flight and the grapple pull) */
+	UPROPERTY(BlueprintReadonly, Transient, Category = "Components")
+	TObjectPtr<UGrappleMovementComponent> GrappleMovement;
+	/** First/third person view state (cameras, which mesh animates, aiming widget) */
+	UPROPERTY(BlueprintReadonly, EditDefaultsOnly, Category = "Components")
+	TObjectPtr<UGrappleViewComponent> ViewState;
 
 	/********************************
 	* CAMERA ATTRIBUTES
@@ -61,40 +80,52 @@ protected:
 	/** The "start direction" is used for locomotion (to determine on a 2D BS which way to rotate the character on start movement) and to determine, when in third person, if the player is aiming in front for grappling (only grappling part is implemented in this demo) */
 	UPROPERTY(BlueprintReadwrite, EditDefaultsOnly, Category = "Movement")
 	int32 StartDirection{ 0 };
+	/** Camera and capsule rotation StartDirection was last computed from (it is only recomputed when these or the input axes change) */
+	FRotator StartDirectionCameraRotation{ 0.f };
+	float StartDirectionCapsuleYaw{ 0.f };
+	/** Set when an input axis changed since StartDirection was last computed */
+	bool bStartDirectionDirty{ true };
+	/** Held from the jump press to its release (read by UGrappleAnimInstance, third person only) */
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "Movement")
+	bool bJumpTriggered{ false };
 
 	/********************************
 	* GRAPPLING ATTRIBUTES
 	********************************/
-	/** What targets can the player grapple onto. By default these will be world static and world dynamic. If you want to ensure just specific targets are allowed, create a custom object type 
-	Old style Enum (TEnumAsByte) used as this is what unreal uses for the line trace */
-	UPROPERTY(BlueprintReadwrite, EditDefaultsOnly, Category = "Grappling|Settings")
-	TArray<TEnumAsByte<EObjectTypeQuery>> GrapplableTargets;
-	/** When doing grapple checks, what actors should be ignored (default is self/this) 
-	using old pointer style to avoid conversion issues */
-	UPROPERTY(BlueprintReadwrite, EditDefaultsOnly, Category = "Grappling|Settings")
+	/** Grapple tuning shared with every character of the class. Falls back to the UGrappleProfileDataAsset defaults when not set */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Settings")
+	TObjectPtr<const UGrappleProfileDataAsset> GrappleProfile;
+	/** Profile swapped in at runtime (surfaces, power ups), takes precedence over the world and class profiles */
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "Grappling|Settings")
+	TObjectPtr<const UGrappleProfileDataAsset> ActiveProfile;
+	/** Cached for the world profile lookup on every access */
+	UPROPERTY(Transient)
+	TObjectPtr<UGrappleProfileSubsystem> ProfileSubsystem;
+	/** Per character changes on top of the profile */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Grappling|Settings")
+	FGrappleProfileOverrides ProfileOverrides;
+	/** Replaces the profile's grapplable targets once AddToGrappableTargets changed them for this character (or targets were migrated from GrapplableTargets_DEPRECATED), empty (no allocation) otherwise */
+	UPROPERTY(BlueprintReadOnly, Category = "Grappling|Settings")
+	TArray<TEnumAsByte<EObjectTypeQuery>> GrapplableTargetsOverride;
+	/** Targets set on the character before the profile existed, moved into GrapplableTargetsOverride on load */
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set the grapplable targets on the grapple profile"))
+	TArray<TEnumAsByte<EObjectTypeQuery>> GrapplableTargets_DEPRECATED;
+	/** When doing grapple checks, what actors should be ignored besides self
+	using old pointer style to avoid conversion issues. Change at runtime through AddActorsToIgnore so the cached query params are rebuilt */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Settings")
 	TArray<AActor*> ActorsToIgnore;
-	/** How long can the grapple cable get (how far can the player grapple) */
-	UPROPERTY(BlueprintReadwrite, EditDefaultsOnly, Category = "Grappling|Settings")
-	float GrappleLength{ 10000.f };
-	/** How fast does the cable launch from the character to the attach location */
-	UPROPERTY(BlueprintReadwrite, EditDefaultsOnly, Category = "Grappling|Settings")
-	float GrappleAttachSpeed{ 50.f };
-	/** How fast does the character travel along the grapple to the attach location */
-	UPROPERTY(BlueprintReadwrite, EditDefaultsOnly, Category = "Grappling|Settings")
-	float PlayerGrappleSpeed{ 250.f };
-	/** What velocity and direction does the character travel when they break off the grappling hook (there should be a Z value of some sort to give the appearance of detatching. Other values are optional) */
-	UPROPERTY(BlueprintReadwrite, EditDefaultsOnly, Category = "Grappling|Settings")
-	FVector BreakOffGrappleVelocity{ 0.f, 0.f, 750.f };
-	/** How close to the attach location must the character be for the movement to accepted (larger values are useful here depending on the thickness of meshes to which the player can attach - a minimum of 45. based on starter content is recommended) */
-	UPROPERTY(BlueprintReadwrite, EditDefaultsOnly, Category = "Grappling|Settings")
-	float GrappleAcceptanceRadius{ 45.f };
-	/** How far up from the ground can the character be before the grapple automatically releases them (when they arrived at the attach location). If using fall damage, this value should be SMALLER than the value used for fall damage */
-	UPROPERTY(BlueprintReadwrite, EditDefaultsOnly, Category = "Grappling|Settings")
-	float GrappleAcceptedFallDistance{ 150.f };
+	/** Query params built from the grapplable targets and ActorsToIgnore. Built on first use and rebuilt only when the setters change the arrays or the profile changes */
+	mutable FCollisionObjectQueryParams GrappleObjectQueryParams;
+	mutable FCollisionQueryParams GrappleQueryParams;
+	mutable const UGrappleProfileDataAsset* GrappleQueryParamsProfile{ nullptr };
+	mutable bool bGrappleQueryParamsDirty{ true };
 
 	/** Where is the grapple attached/where is the player travelling to */
 	UPROPERTY(BlueprintReadwrite, EditDefaultsOnly, Category = "Grappling|Runtime")
 	FVector AttachLocation{ 0.f };
+	/** Movable component the grapple is attached to (AttachLocation follows it once per frame) and where on it, in component space */
+	TWeakObjectPtr<USceneComponent> AnchorComponent;
+	FVector AnchorLocalOffset{ 0.f };
 
 	/** Has the player activated the grapple and has the grapple hit an acceptable attach location */
 	UPROPERTY(BlueprintReadwrite, EditDefaultsOnly, Category = "Grappling|States")
@@ -106,9 +137,47 @@ protected:
 	UPROPERTY(BlueprintReadwrite, EditDefaultsOnly, Category = "Grappling|States")
 	bool bArrived{ false };
 
-	/** The timer handle used to control the grapple and player movement  */
-	UPROPERTY(BlueprintReadwrite, EditDefaultsOnly, Category = "Grappling|Timer")
-	FTimerHandle GrappleTH;
+	/** What the character runs at each significance tier (indexed by EGrappleSignificance). The locally controlled player is always High */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, EditFixedSize, Category = "Significance")
+	TArray<FGrappleSignificanceSettings> SignificanceSettings;
+	/** Current significance tier, set by the grapple significance subsystem */
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "Significance")
+	EGrappleSignificance GrappleSignificance{ EGrappleSignificance::High };
+
+	/** Grapple states, anchor and fire time replicated to simulated proxies (push model, only dirtied when a grapple state changes) */
+	UPROPERTY(ReplicatedUsing = OnRep_GrappleRepState)
+	FGrappleRepState GrappleRepState;
+	/** Simulated proxies only: where the hook started its flight (proxies rebuild the hook flight locally from the fire time) */
+	FVector ProxyHookStart{ 0.f };
+
+	/** Body the hook is tethered to (it is also the anchor component, the cable end follows it like any moving anchor) */
+	TWeakObjectPtr<UPrimitiveComponent> TetherBody;
+	/** Authority only: the tether in the tether subsystem */
+	int32 TetherId{ INDEX_NONE };
+
+	/** Latest result of the per-frame async aim probe (locally controlled players only). Grapple() fires at this instead of tracing on the input frame */
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "Grappling|Aim")
+	FHitResult AimHitResult;
+	/** Did the latest aim probe hit something grapplable (the aiming widget can use this to show hit/miss) */
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "Grappling|Aim")
+	bool bHasAimTarget{ false };
+	/** Is the aim probe result from the current view. Cleared when the probe stops running or the camera switches, Grapple() then traces itself */
+	bool bAimProbeValid{ false };
+	/** Bound once to OnAimProbeCompleted */
+	FTraceDelegate AimTraceDelegate;
+
+	/** Latest verified aim assist target (locally controlled players only) */
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "Grappling|Aim Assist")
+	FHitResult AimAssistHitResult;
+	/** Did the latest aim assist candidate pass its verification trace */
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "Grappling|Aim Assist")
+	bool bHasAimAssistTarget{ false };
+	/** Candidate scored by the anchor subsystem, waiting on its verification trace */
+	FVector AimAssistCandidate{ 0.f };
+	/** Cone query being scored on a worker thread */
+	FGrappleAnchorQuery AimAssistQuery;
+	/** Bound once to OnAimAssistTraceCompleted */
+	FTraceDelegate AimAssistTraceDelegate;
 
 /*************************************
 * METHODS
@@ -118,7 +187,7 @@ protected:
 	********************************/
 public:
 	// Sets default values for this character's properties
-	AGrappleCharacter();
+	AGrappleCharacter(const FObjectInitializer& ObjectInitializer);
 
 	/********************************
 	* INHERITED METHODS
@@ -126,36 +195,47 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void PreRegisterAllComponents() override;
 
 public:	
-	// Called every frame
+	virtual void PostLoad() override;
+
+	// Called every frame (only while UpdateTickEnabled keeps it on)
 	virtual void Tick(float DeltaTime) override;
 
+	virtual void PossessedBy(AController* NewController) override;
+	virtual void UnPossessed() override;
+	virtual void OnRep_Controller() override;
+
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	
 	/********************************
 	* MEMBER METHODS
 	********************************/
 protected:
-	/** Calculates the start direction for locomotion (not implemented) and use with the grappling system to help determine if the player can shoot grapple in look direction */
-	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Movement|Tick")
-	void UpdateStartDirection();
+	/** Calculates the start direction for locomotion (not implemented) and use with the grappling system to help determine if the player can shoot grapple in look direction.
+	Only recomputed (from a lookup table) when the input axes, camera or capsule rotation changed */
+	UFUNCTION(BlueprintCallable, Category = "Movement|Tick")
+	virtual void UpdateStartDirection();
 	/* Gets the input rotation used to update start direction. Using FRotator return isntead of a ref based return to avoid seting yet another variable... already setting two in this just for readability - readability is needed, if these two variables cause an issue then something more profound is wrong than this inline method */
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Movement|Tick")
 	FRotator CalculateInputRotation() const
 	{
-		FRotator ALocal = UKismetMathLibrary::NormalizedDeltaRotator(ThirdPersonCamera->GetComponentRotation(), GetCapsuleComponent()->GetComponentRotation());
+		FRotator ALocal = UKismetMathLibrary::NormalizedDeltaRotator(GetThirdPersonViewRotation(), GetCapsuleComponent()->GetComponentRotation());
 		FRotator BLocal = UKismetMathLibrary::MakeRotFromX(FVector(ForwardAxisRaw, (-1.f * RightAxisRaw), 0.f));
 		return UKismetMathLibrary::NormalizedDeltaRotator(ALocal, BLocal);
 	}
 
 	/** Move forward/backwards input event */
-	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Input|Movement")
-	void MoveForward(float AxisValue);
+	UFUNCTION(BlueprintCallable, Category = "Input|Movement")
+	virtual void MoveForward(float AxisValue);
 	/** Move right/left input event */
-	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Input|Movement")
-	void MoveRight(float AxisValue);
+	UFUNCTION(BlueprintCallable, Category = "Input|Movement")
+	virtual void MoveRight(float AxisValue);
 	/** Calculates the forward vector based on control rotation. Using an FVector return instead of a ref based return to keep from having to store data in an yet another variable */
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Input|Movement")
 	FORCEINLINE FVector GetCharacterDirectionForward() const
@@ -169,11 +249,11 @@ protected:
 		return UKismetMathLibrary::GetRightVector(FRotator(0.f, GetControlRotation().Yaw, 0.f));
 	}
 	/** turn event */
-	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Input|Camera")
-	void Turn(float AxisValue);
+	UFUNCTION(BlueprintCallable, Category = "Input|Camera")
+	virtual void Turn(float AxisValue);
 	/** look up event */
-	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Input|Camera")
-	void LookUp(float AxisValue);
+	UFUNCTION(BlueprintCallable, Category = "Input|Camera")
+	virtual void LookUp(float AxisValue);
 
 
 	/** When the character jumps breaks out of grapple event if grappling is occuring, and/else jumps */
@@ -194,33 +274,107 @@ protected:
 	/** Turns off first person aiming widget - this is made implementable as the widget will have a C++ base and no reference will be stored in GrappleCharacter base class for the widget */
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable, Category = "Input|Camera")
 	void RemoveAimingWidget();
+	/** Called when the aim probe changes between hit and miss (used by the aiming widget to show if the grapple can attach) */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Input|Camera")
+	void OnAimTargetChanged(bool bNewHasAimTarget);
 	/** Starts the grapple events  */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Input|Grapple")
 	void Grapple();
+	/** Calculates the grapple trace start and end for the active camera. Returns false if in third person and the player is not aiming in front of the character */
+	bool CalculateGrappleTrace(FVector& OutStart, FVector& OutEnd) const;
+	/** Does this character run the per-frame aim probe (locally controlled players only, AI fires with a single trace) */
+	bool ShouldRunAimProbe() const;
+	/** Turns the actor tick on only while there is per-frame work: the aim probe of a local player or a simulated proxy's hook in flight */
+	void UpdateTickEnabled();
+	/** Starts this frame's async aim probe, the result arrives at the start of the next frame */
+	void RequestAimProbe();
+	/** Async aim probe result */
+	void OnAimProbeCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+	/** Collects the last cone query (verifying its best candidate with one async trace) and starts the next one */
+	void UpdateAimAssist();
+	/** Aim assist verification trace result */
+	void OnAimAssistTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
 
-	/** Timer event that runs the grapple system and starts/updates all other grapple events */
-	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Grapple")
-	void StartGrapple();
-	/** Moves the grapple cable's end part to the attach location (this happens before the player moves along the grapple cable) */
-	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Grapple")
-	void MoveGrappleTo();
-	/** Moves player along the grapple cable to the attached location , also handles what to do when the player arrives at the location (in third person) */
-	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Grapple")
-	void MovePlayerToGrappledLocation();
-	/** Breaks the character out of grappling state and then stops timer */
+public:
+	/** Breaks the character out of grappling state with the break off velocity and then stops the grapple */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Grapple")
 	void BreakGrapple();
-	/** Ends grapple timer and resets states */
+	/** Ends the grapple movement and resets states */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Grapple")
 	void StopGrapple();
-	/** Used by stop grapple to clear time and as a catch-all for the timer only. Ends the grapple timer in the case that it is active but the bool states are already false (this can happen if the timer is still firing when the bool states change or if the timer becomes out of sync) */
-	UFUNCTION(BlueprintCallable, Category = "Grapple")
-	void ClearGrappleTimer();
+
+	/** Called by the grapple movement component when a (predicted or server validated) grapple request is applied. The attach location follows NewAnchorComponent if it can move */
+	void HandleGrappleStarted(const FVector& NewAttachLocation, USceneComponent* NewAnchorComponent);
+	/** Called by the grapple movement component when the hook reaches the attach location (the character starts travelling along the cable) */
+	void HandleGrappleAttached();
+	/** Called by the grapple movement component when the hook attaches. Ties the hook to the anchor component if it simulates physics (the authority also starts pulling it), returns false if it doesn't and the character should be pulled instead */
+	bool BeginTether();
+	/** Unties the hook from its body */
+	void EndTether();
+	/** Called by the grapple movement component when the character reaches the accepted area around the attach location and is too high to drop off */
+	void HandleGrappleArrived();
+	/** Grapple state events for blueprints. Only transitions are broadcast (never per frame); the owning client doesn't re-broadcast them while replaying moves and simulated proxies broadcast them from the replicated state */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Grapple|Events")
+	void OnGrappleFired(const FVector& NewAttachLocation);
+	UFUNCTION(BlueprintImplementableEvent, Category = "Grapple|Events")
+	void OnGrappleAttached();
+	UFUNCTION(BlueprintImplementableEvent, Category = "Grapple|Events")
+	void OnGrappleArrived();
+	UFUNCTION(BlueprintImplementableEvent, Category = "Grapple|Events")
+	void OnGrappleReleased();
+
+	/** Server only: takes over a grapple simulated outside of the actor (Mass entity promotion) */
+	void AdoptGrappleState(const FVector& InAttachLocation, const FVector& InHookLocation, bool bInAttached, bool bInArrived);
+	/** Puts the grapple states back to a saved move's starting state when the owning client replays moves after a server correction */
+	void RestoreGrappleState(bool bInGrappleActive, bool bInGrappleAttached, bool bInArrived, const FVector& InAttachLocation, USceneComponent* InAnchorComponent, const FVector& InAnchorLocalOffset);
+	/**
+	 * Called by the grapple movement component once per frame, after the anchor component (and its owner) ticked: moves the attach location with the anchor component.
+	 * Lets go of a component that was destroyed or streamed out, keeping its last location and requesting a release if this machine controls the character.
+	 * Returns true if the attach location follows a component.
+	 */
+	bool UpdateAnchor();
+	/**
+	 * Registers the cameras, spring arm and first person arms. In game worlds they stay unregistered (no render state, transform updates or
+	 * animation) until the character is a locally controlled player; on a dedicated server they aren't even created.
+	 */
+	void RegisterViewComponents();
+	/** Applies the settings of a significance tier (tick rates, cable detail, animation rate, AI grapple substeps) */
+	void SetGrappleSignificance(EGrappleSignificance NewSignificance);
+
+	/** Moves the end of the grapple cable to the hook location (the grapple movement component owns the hook, the character owns the cable) */
+	void UpdateGrappleCable(const FVector& HookLocation);
+	/** Routes the grapple cable around the corners the rope is wrapped around (anchor end first) */
+	void UpdateGrappleCableWrapPoints(TConstArrayView<FVector> WrapPoints);
+
+protected:
+	/** Server only: rebuilds the replicated grapple state and marks it dirty if it changed. bFired stamps a new fire time */
+	void UpdateGrappleRepState(bool bFired = false);
+	/** Applies the replicated grapple state on simulated proxies */
+	UFUNCTION()
+	void OnRep_GrappleRepState(const FGrappleRepState& PreviousState);
+	/** False while the owning client replays saved moves (the transitions were already broadcast when first predicted) */
+	bool ShouldBroadcastGrappleEvents() const;
+	/** Simulated proxies only: places the hook along its flight from the replicated fire time */
+	void UpdateProxyHookFlight();
+	/** Shows or hides the grapple cable, registering it the first time it is shown (never on a dedicated server) */
+	void ShowGrappleCable(bool bShow);
+	/** Third person camera rotation/location, or what it would be when the camera isn't in use (AI, other players, dedicated servers) */
+	FRotator GetThirdPersonViewRotation() const;
+	FVector GetThirdPersonViewLocation() const;
+	/** Follows a new anchor component (nullptr for none), moving the grapple movement tick prerequisite from the previous one */
+	void SetAnchorComponent(USceneComponent* NewAnchorComponent, const FVector& NewAnchorLocalOffset);
 
 	/***********
 	* Setters
 	***********/
 public:
+	/** Swaps the profile of this character only (null goes back to the world/class profile) */
+	UFUNCTION(BlueprintCallable, Category = "Grapple|Setters")
+	void SetGrappleProfile(const UGrappleProfileDataAsset* NewProfile);
+	/** Drops the per character overrides the setters below made, back to the profile values */
+	UFUNCTION(BlueprintCallable, Category = "Grapple|Setters")
+	void ClearProfileOverrides();
+	/** The setters below override the profile for this character only */
 	UFUNCTION(BlueprintCallable, Category = "Grapple|Setters", meta = (AutoCreateRefTerm = "NewTarget"))
 	void AddToGrappableTargets(const TEnumAsByte<EObjectTypeQuery>& NewTarget);
 	UFUNCTION(BlueprintCallable, Category = "Grapple|Setters")
@@ -250,7 +404,7 @@ public:
 			return nullptr;
 	}
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Components|Getters")
-	FORCEINLINE class UCableComponent* GetGrappleCable() const 
+	FORCEINLINE UGrappleRopeComponent* GetGrappleCable() const 
 	{ 
 		if (GrappleCable) 
 			return GrappleCable;
@@ -299,6 +453,10 @@ public:
 		else
 			return nullptr;
 	}
+	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Components|Getters")
+	FORCEINLINE UGrappleMovementComponent* GetGrappleMovement() const { return GrappleMovement; }
+	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Components|Getters")
+	FORCEINLINE UGrappleViewComponent* GetViewState() const { return ViewState; }
 
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Camera|Getters")
 	FORCEINLINE bool GetIsIfFirstPerson() const { return bIsFirstPerson;  }
@@ -308,32 +466,54 @@ public:
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Movement|Getters")
 	FORCEINLINE float GetForwardAxisRaw() const { return ForwardAxisRaw; }
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Movement|Getters")
+	FORCEINLINE bool GetJumpTriggered() const { return bJumpTriggered; }
+	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Movement|Getters")
 	FORCEINLINE float GetRightAxisRaw() const { return RightAxisRaw; }
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Movement|Getters")
 	FORCEINLINE int32 GetStartDirection() const { return StartDirection; }
 
+	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Significance|Getters")
+	FORCEINLINE EGrappleSignificance GetGrappleSignificance() const { return GrappleSignificance; }
+
+	/** Profile in use: the runtime profile, else the world profile (UGrappleProfileSubsystem), else the class profile, else the defaults */
+	const UGrappleProfileDataAsset& GetGrappleProfile() const;
+	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Grappling|Getters", meta = (DisplayName = "Get Grapple Profile"))
+	FORCEINLINE const UGrappleProfileDataAsset* K2_GetGrappleProfile() const { return &GetGrappleProfile(); }
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Grappling|Getters")
-	FORCEINLINE TArray<TEnumAsByte<EObjectTypeQuery>> GetGrapplableTargets() const { return GrapplableTargets; }
+	FORCEINLINE const TArray<TEnumAsByte<EObjectTypeQuery>>& GetGrapplableTargets() const { return GrapplableTargetsOverride.Num() > 0 ? GrapplableTargetsOverride : GetGrappleProfile().GetGrapplableTargets(); }
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Grappling|Getters")
-	FORCEINLINE TArray<AActor*> GetActorsToIgnore() const { return ActorsToIgnore; }
+	FORCEINLINE const TArray<AActor*>& GetActorsToIgnore() const { return ActorsToIgnore; }
+	/** Cached object query params for grapple traces (rebuilt only if the grapplable targets changed) */
+	const FCollisionObjectQueryParams& GetGrappleObjectQueryParams() const;
+	/** Cached query params for grapple traces (rebuilt only if the actors to ignore changed) */
+	const FCollisionQueryParams& GetGrappleQueryParams() const;
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Grappling|Getters")
-	FORCEINLINE float GetGrappleLength() const { return GrappleLength; }
+	FORCEINLINE bool HasAimTarget() const { return bHasAimTarget; }
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Grappling|Getters")
-	FORCEINLINE float GetGrappleAttachSpeed() const { return GrappleAttachSpeed; }
+	FORCEINLINE FHitResult GetAimHitResult() const { return AimHitResult; }
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Grappling|Getters")
-	FORCEINLINE float GetPlayerGrappleSpeed() const { return PlayerGrappleSpeed; }
+	FORCEINLINE float GetGrappleLength() const { return ProfileOverrides.bOverride_GrappleLength ? ProfileOverrides.GrappleLength : GetGrappleProfile().GetGrappleLength(); }
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Grappling|Getters")
-	FORCEINLINE FVector GetBreakOffGrappleVelocity() const { return BreakOffGrappleVelocity; }
+	FORCEINLINE float GetGrappleAttachSpeed() const { return ProfileOverrides.bOverride_GrappleAttachSpeed ? ProfileOverrides.GrappleAttachSpeed : GetGrappleProfile().GetGrappleAttachSpeed(); }
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Grappling|Getters")
-	FORCEINLINE float GetGrappleAcceptanceRadius() const { return GrappleAcceptanceRadius; }
+	FORCEINLINE float GetPlayerGrappleSpeed() const { return ProfileOverrides.bOverride_PlayerGrappleSpeed ? ProfileOverrides.PlayerGrappleSpeed : GetGrappleProfile().GetPlayerGrappleSpeed(); }
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Grappling|Getters")
-	FORCEINLINE float GetGrappleAcceptedFallDistance() const { return GrappleAcceptedFallDistance; }
+	FORCEINLINE FVector GetBreakOffGrappleVelocity() const { return ProfileOverrides.bOverride_BreakOffGrappleVelocity ? ProfileOverrides.BreakOffGrappleVelocity : GetGrappleProfile().GetBreakOffGrappleVelocity(); }
+	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Grappling|Getters")
+	FORCEINLINE float GetGrappleAcceptanceRadius() const { return ProfileOverrides.bOverride_GrappleAcceptanceRadius ? ProfileOverrides.GrappleAcceptanceRadius : GetGrappleProfile().GetGrappleAcceptanceRadius(); }
+	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Grappling|Getters")
+	FORCEINLINE float GetGrappleAcceptedFallDistance() const { return ProfileOverrides.bOverride_GrappleAcceptedFallDistance ? ProfileOverrides.GrappleAcceptedFallDistance : GetGrappleProfile().GetGrappleAcceptedFallDistance(); }
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Grappling|Getters")
 	FORCEINLINE FVector GetAttachLocation() const { return AttachLocation; }
+	FORCEINLINE USceneComponent* GetAnchorComponent() const { return AnchorComponent.Get(); }
+	FORCEINLINE FVector GetAnchorLocalOffset() const { return AnchorLocalOffset; }
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Grappling|Getters")
 	FORCEINLINE bool GetGrappleActive() const { return bGrappleActive; }
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Grappling|Getters")
 	FORCEINLINE bool GetGrappleAttached() const { return bGrappleAttached; }
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Grappling|Getters")
 	FORCEINLINE bool GetArrived() const { return bArrived; }
+	/** Is the hook pulling a physics body rather than the character */
+	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Grappling|Getters")
+	FORCEINLINE bool IsTethered() const { return TetherBody.IsValid(); }
 };
@@ -0,0 +1,464 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleInputRecorderComponent.h"
+#include "GrappleCharacter.h"
+#include "GrappleMovementComponent.h"
+#include "Components/InputComponent.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Grapple/GrappleStats.h"
+#include "Demo.h"
+
+#if !UE_BUILD_SHIPPING
+namespace GrappleInputRecorder
+{
+	/** The first local player's grapple character */
+	AGrappleCharacter* GetLocalCharacter(UWorld* World)
+	{
+		APlayerController* PlayerControllerLocal = World ? World->GetFirstPlayerController() : nullptr;
+		return PlayerControllerLocal ? Cast<AGrappleCharacter>(PlayerControllerLocal->GetPawn()) : nullptr;
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs StartCommand(
+		TEXT("Grapple.Record.Start"),
+		TEXT("Starts recording the local grapple character's input"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+		{
+			AGrappleCharacter* CharacterLocal = GetLocalCharacter(World);
+			if (!CharacterLocal)
+			{
+				UE_LOG(LogGrapple, Warning, TEXT("Grapple.Record.Start: no local grapple character"));
+				return;
+			}
+			UGrappleInputRecorderComponent* RecorderLocal = CharacterLocal->FindComponentByClass<UGrappleInputRecorderComponent>();
+			if (!RecorderLocal)
+			{
+				RecorderLocal = NewObject<UGrappleInputRecorderComponent>(CharacterLocal);
+				RecorderLocal->RegisterComponent();
+			}
+			if (RecorderLocal->StartRecording())
+			{
+				UE_LOG(LogGrapple, Display, TEXT("Grapple.Record.Start: recording %s"), *CharacterLocal->GetName());
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs StopCommand(
+		TEXT("Grapple.Record.Stop"),
+		TEXT("Stops recording the local grapple character's input and saves it. Grapple.Record.Stop [File], by default Saved/InputRecordings/Grapple_<date>.grapplerec"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+		{
+			AGrappleCharacter* CharacterLocal = GetLocalCharacter(World);
+			UGrappleInputRecorderComponent* RecorderLocal = CharacterLocal ? CharacterLocal->FindComponentByClass<UGrappleInputRecorderComponent>() : nullptr;
+			if (!RecorderLocal || !RecorderLocal->IsRecording())
+			{
+				UE_LOG(LogGrapple, Warning, TEXT("Grapple.Record.Stop: not recording"));
+				return;
+			}
+			const FString FilenameLocal = Args.Num() > 0 ? Args[0] : FPaths::ProjectSavedDir() / TEXT("InputRecordings") / FString::Printf(TEXT("Grapple_%s.grapplerec"), *FDateTime::Now().ToString());
+			RecorderLocal->StopRecording(FilenameLocal);
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs ReplayCommand(
+		TEXT("Grapple.Replay.Start"),
+		TEXT("Replays a recording on the local grapple character, once it has one. Grapple.Replay.Start <File> [Report]: writes the correction counts to Report and quits when done"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+		{
+			FGrappleInputRecording RecordingLocal;
+			if (Args.Num() == 0 || !RecordingLocal.LoadFromFile(Args[0]) || RecordingLocal.Frames.Num() == 0)
+			{
+				UE_LOG(LogGrapple, Error, TEXT("Grapple.Replay.Start: no recording in %s"), Args.Num() > 0 ? *Args[0] : TEXT("(none)"));
+				return;
+			}
+			const FString ReportLocal = Args.Num() > 1 ? Args[1] : FString();
+
+			// a client running this from -ExecCmds is still connecting: wait on the core ticker (it outlives the map change) for a possessed character
+			FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([RecordingLocal, ReportLocal](float DeltaTime)
+			{
+				for (const FWorldContext& ContextLocal : GEngine->GetWorldContexts())
+				{
+					AGrappleCharacter* CharacterLocal = (ContextLocal.WorldType == EWorldType::Game || ContextLocal.WorldType == EWorldType::PIE) ? GetLocalCharacter(ContextLocal.World()) : nullptr;
+					if (!CharacterLocal || !CharacterLocal->HasActorBegunPlay())
+					{
+						continue;
+					}
+					UGrappleInputRecorderComponent* RecorderLocal = CharacterLocal->FindComponentByClass<UGrappleInputRecorderComponent>();
+					if (!RecorderLocal)
+					{
+						RecorderLocal = NewObject<UGrappleInputRecorderComponent>(CharacterLocal);
+						RecorderLocal->RegisterComponent();
+					}
+					if (RecorderLocal->StartReplay(RecordingLocal, ReportLocal))
+					{
+						UE_LOG(LogGrapple, Display, TEXT("Grapple.Replay.Start: replaying %d frames on %s"), RecordingLocal.Frames.Num(), *CharacterLocal->GetName());
+						return false;
+					}
+				}
+				return true;
+			}), 0.5f);
+		}));
+
+	/** Grapple.Net.MeasureBandwidth progress, shared by the ticks of one measurement */
+	struct FBandwidthMeasurement
+	{
+		double StartSeconds{ 0.0 };
+		int64 StartBytes{ 0 };
+		double IdleBytesPerSecond{ -1.0 };
+		bool bConnected{ false };
+	};
+
+	FAutoConsoleCommandWithWorldAndArgs MeasureBandwidthCommand(
+		TEXT("Grapple.Net.MeasureBandwidth"),
+		TEXT("Measures what a client receives from the server, in bytes/s: idle until another grapple character is in view, then with it for Seconds. Grapple.Net.MeasureBandwidth <Seconds> [Report]: writes both to Report and quits when done"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+		{
+			const double SecondsLocal = Args.Num() > 0 ? FCString::Atod(*Args[0]) : 0.0;
+			if (SecondsLocal <= 0.0)
+			{
+				UE_LOG(LogGrapple, Error, TEXT("Grapple.Net.MeasureBandwidth: no duration"));
+				return;
+			}
+			const FString ReportLocal = Args.Num() > 1 ? Args[1] : FString();
+
+			// like Grapple.Replay.Start, a client running this from -ExecCmds is still connecting
+			TSharedRef<FBandwidthMeasurement> MeasurementLocal = MakeShared<FBandwidthMeasurement>();
+			FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([MeasurementLocal, SecondsLocal, ReportLocal](float DeltaTime)
+			{
+				for (const FWorldContext& ContextLocal : GEngine->GetWorldContexts())
+				{
+					UWorld* WorldLocal = ContextLocal.WorldType == EWorldType::Game ? ContextLocal.World() : nullptr;
+					const UNetDriver* NetDriverLocal = WorldLocal ? WorldLocal->GetNetDriver() : nullptr;
+					const UNetConnection* ConnectionLocal = NetDriverLocal ? NetDriverLocal->ServerConnection.Get() : nullptr;
+					if (!ConnectionLocal || ConnectionLocal->State != USOCK_Open || !GetLocalCharacter(WorldLocal))
+					{
+						continue;
+					}
+					const double NowLocal = FPlatformTime::Seconds();
+					const int64 BytesLocal = ConnectionLocal->InTotalBytes;
+					if (!MeasurementLocal->bConnected)
+					{
+						MeasurementLocal->bConnected = true;
+						MeasurementLocal->StartSeconds = NowLocal;
+						MeasurementLocal->StartBytes = BytesLocal;
+						return true;
+					}
+
+					if (MeasurementLocal->IdleBytesPerSecond < 0.0)
+					{
+						bool bProxyLocal = false;
+						for (TActorIterator<AGrappleCharacter> ItLocal(WorldLocal); ItLocal && !bProxyLocal; ++ItLocal)
+						{
+							bProxyLocal = ItLocal->GetLocalRole() == ROLE_SimulatedProxy;
+						}
+						if (!bProxyLocal)
+						{
+							return true;
+						}
+						MeasurementLocal->IdleBytesPerSecond = (BytesLocal - MeasurementLocal->StartBytes) / FMath::Max(NowLocal - MeasurementLocal->StartSeconds, SMALL_NUMBER);
+						MeasurementLocal->StartSeconds = NowLocal;
+						MeasurementLocal->StartBytes = BytesLocal;
+						return true;
+					}
+
+					const double ElapsedLocal = NowLocal - MeasurementLocal->StartSeconds;
+					if (ElapsedLocal < SecondsLocal)
+					{
+						return true;
+					}
+					const double BytesPerSecondLocal = (BytesLocal - MeasurementLocal->StartBytes) / ElapsedLocal;
+					UE_LOG(LogGrapple, Display, TEXT("Grapple.Net.MeasureBandwidth: %.0f B/s idle, %.0f B/s over %.1f s with another grapple character in view"),
+						MeasurementLocal->IdleBytesPerSecond, BytesPerSecondLocal, ElapsedLocal);
+					if (ReportLocal.IsEmpty())
+					{
+						return false;
+					}
+					const FString LineLocal = FString::Printf(TEXT("Idle=%.1f InView=%.1f Seconds=%.1f\n"), MeasurementLocal->IdleBytesPerSecond, BytesPerSecondLocal, ElapsedLocal);
+					if (!FFileHelper::SaveStringToFile(LineLocal, *ReportLocal))
+					{
+						UE_LOG(LogGrapple, Error, TEXT("Grapple.Net.MeasureBandwidth: can't write %s"), *ReportLocal);
+					}
+					// the process was started for this report
+					FPlatformMisc::RequestExit(false);
+					return false;
+				}
+				return true;
+			}), 0.5f);
+		}));
+}
+#endif
+
+UGrappleInputRecorderComponent::UGrappleInputRecorderComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	// after the controller processed the input, before the character moves (both set as prerequisites while recording)
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UGrappleInputRecorderComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (bReplaying)
+	{
+		TickReplay(DeltaTime);
+		return;
+	}
+
+	const AGrappleCharacter* CharacterLocal = Cast<AGrappleCharacter>(GetOwner());
+	const AController* ControllerLocal = CharacterLocal ? CharacterLocal->GetController() : nullptr;
+	if (!bRecording || !ControllerLocal || ControllerLocal != RecordedController.Get())
+	{
+		// unpossessed, nothing more to record
+		StopCapture();
+		return;
+	}
+	GRAPPLE_LLM_SCOPE(Character);
+
+	FGrappleInputFrame& FrameLocal = Recording.Frames.AddDefaulted_GetRef();
+	FrameLocal.DeltaTime = DeltaTime;
+	FrameLocal.Forward = CharacterLocal->GetForwardAxisRaw();
+	FrameLocal.Right = CharacterLocal->GetRightAxisRaw();
+	FrameLocal.SetControlRotation(ControllerLocal->GetControlRotation());
+	FrameLocal.Actions = PendingActions;
+	PendingActions = EGrappleInputAction::None;
+	if (FGrappleInputRecording::IsCheckpoint(Recording.Frames.Num() - 1))
+	{
+		FrameLocal.Location = FVector3f(CharacterLocal->GetActorLocation());
+	}
+}
+
+void UGrappleInputRecorderComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopCapture();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+bool UGrappleInputRecorderComponent::StartRecording()
+{
+	AGrappleCharacter* CharacterLocal = Cast<AGrappleCharacter>(GetOwner());
+	AController* ControllerLocal = CharacterLocal ? CharacterLocal->GetController() : nullptr;
+	UInputComponent* InputLocal = CharacterLocal ? CharacterLocal->InputComponent.Get() : nullptr;
+	if (!ControllerLocal || !InputLocal || !CharacterLocal->IsLocallyControlled())
+	{
+		UE_LOG(LogGrapple, Warning, TEXT("GrappleInputRecorder: %s isn't a locally controlled grapple character with input"), *GetNameSafe(GetOwner()));
+		return false;
+	}
+
+	StopCapture();
+	Recording = FGrappleInputRecording();
+	Recording.MapName = UWorld::RemovePIEPrefix(GetWorld()->GetOutermost()->GetName());
+	Recording.CharacterClassPath = CharacterLocal->GetClass()->GetPathName();
+	Recording.StartLocation = CharacterLocal->GetActorLocation();
+	Recording.StartRotation = CharacterLocal->GetActorRotation();
+	Recording.StartControlRotation = ControllerLocal->GetControlRotation();
+	Recording.bStartFirstPerson = CharacterLocal->GetIsIfFirstPerson();
+	PendingActions = EGrappleInputAction::None;
+
+	// next to the character's own bindings, without consuming the keys (each binding is a reference into the input component's array, used before the next one is added)
+	auto BindLocal = [this, InputLocal](const FName ActionName, const EInputEvent KeyEvent, FInputActionHandlerSignature::TMethodPtr<UGrappleInputRecorderComponent> Handler)
+	{
+		FInputActionBinding& BindingLocal = InputLocal->BindAction(ActionName, KeyEvent, this, Handler);
+		BindingLocal.bConsumeInput = false;
+		ActionBindingHandles.Add(BindingLocal.GetHandle());
+	};
+	BindLocal(TEXT("Jump"), IE_Pressed, &UGrappleInputRecorderComponent::OnJumpPressed);
+	BindLocal(TEXT("Jump"), IE_Released, &UGrappleInputRecorderComponent::OnJumpReleased);
+	BindLocal(TEXT("SwitchCamera"), IE_Pressed, &UGrappleInputRecorderComponent::OnSwitchCamera);
+	BindLocal(TEXT("Grapple"), IE_Pressed, &UGrappleInputRecorderComponent::OnGrapple);
+
+	AddTickPrerequisiteActor(ControllerLocal);
+	CharacterLocal->GetCharacterMovement()->AddTickPrerequisiteComponent(this);
+	RecordedController = ControllerLocal;
+	SetComponentTickEnabled(true);
+	bRecording = true;
+	return true;
+}
+
+bool UGrappleInputRecorderComponent::StopRecording(const FString& Filename)
+{
+	StopCapture();
+	if (Recording.Frames.Num() == 0)
+	{
+		return false;
+	}
+
+	const bool bSavedLocal = Recording.SaveToFile(Filename);
+	if (bSavedLocal)
+	{
+		UE_LOG(LogGrapple, Display, TEXT("GrappleInputRecorder: %d frames (%.1f s) saved to %s"), Recording.Frames.Num(), Recording.GetDuration(), *Filename);
+	}
+	else
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleInputRecorder: can't write %s"), *Filename);
+	}
+	return bSavedLocal;
+}
+
+bool UGrappleInputRecorderComponent::StartReplay(const FGrappleInputRecording& InRecording, const FString& ReportFilename)
+{
+	AGrappleCharacter* CharacterLocal = Cast<AGrappleCharacter>(GetOwner());
+	AController* ControllerLocal = CharacterLocal ? CharacterLocal->GetController() : nullptr;
+	const UGrappleMovementComponent* MovementLocal = CharacterLocal ? CharacterLocal->GetGrappleMovement() : nullptr;
+	if (!ControllerLocal || !MovementLocal || !CharacterLocal->IsLocallyControlled() || InRecording.Frames.Num() == 0)
+	{
+		return false;
+	}
+
+	StopCapture();
+	Recording = InRecording;
+	ReplayReportFilename = ReportFilename;
+	ReplayFrameIndex = 0;
+	ReplayElapsedTime = 0.0;
+	ReplayRecordedTime = 0.0;
+	ReplayGrapples = 0;
+	ReplayStartCorrections = MovementLocal->GetNumClientCorrections();
+	ReplayStartGrappleCorrections = MovementLocal->GetNumGrappleCorrections();
+
+	// not BeginReplay: the location belongs to the server, only the view is the player's
+	ControllerLocal->SetControlRotation(Recording.StartControlRotation);
+	if (CharacterLocal->GetIsIfFirstPerson() != Recording.bStartFirstPerson)
+	{
+		CharacterLocal->SwitchCamera();
+	}
+
+	// each frame's input is in before the character moves with it
+	CharacterLocal->GetCharacterMovement()->AddTickPrerequisiteComponent(this);
+	SetComponentTickEnabled(true);
+	bReplaying = true;
+	return true;
+}
+
+void UGrappleInputRecorderComponent::TickReplay(float DeltaTime)
+{
+	AGrappleCharacter* CharacterLocal = Cast<AGrappleCharacter>(GetOwner());
+	if (!CharacterLocal || !CharacterLocal->GetController() || ReplayFrameIndex >= Recording.Frames.Num())
+	{
+		// done, or unpossessed (disconnected), report what was replayed
+		FinishReplay();
+		return;
+	}
+
+	// ahead of the recording: keep the last frame's movement input, no new actions. Behind it: one frame per tick, so no action is merged
+	ReplayElapsedTime += DeltaTime;
+	if (ReplayFrameIndex > 0 && ReplayElapsedTime < ReplayRecordedTime)
+	{
+		const FGrappleInputFrame& LastFrameLocal = Recording.Frames[ReplayFrameIndex - 1];
+		CharacterLocal->MoveForward(LastFrameLocal.Forward);
+		CharacterLocal->MoveRight(LastFrameLocal.Right);
+		return;
+	}
+	const FGrappleInputFrame& FrameLocal = Recording.Frames[ReplayFrameIndex++];
+	ReplayRecordedTime += FrameLocal.DeltaTime;
+	if (EnumHasAnyFlags(FrameLocal.Actions, EGrappleInputAction::Grapple))
+	{
+		++ReplayGrapples;
+	}
+	ReplayFrame(CharacterLocal, FrameLocal);
+}
+
+void UGrappleInputRecorderComponent::FinishReplay()
+{
+	const AGrappleCharacter* CharacterLocal = Cast<AGrappleCharacter>(GetOwner());
+	const UGrappleMovementComponent* MovementLocal = CharacterLocal ? CharacterLocal->GetGrappleMovement() : nullptr;
+	const int32 CorrectionsLocal = MovementLocal ? MovementLocal->GetNumClientCorrections() - ReplayStartCorrections : 0;
+	const int32 GrappleCorrectionsLocal = MovementLocal ? MovementLocal->GetNumGrappleCorrections() - ReplayStartGrappleCorrections : 0;
+	const int32 FramesLocal = ReplayFrameIndex;
+	StopCapture();
+
+	UE_LOG(LogGrapple, Display, TEXT("GrappleInputRecorder: replayed %d of %d frames, %d grapples, %d corrections (%d with the grapple active)"),
+		FramesLocal, Recording.Frames.Num(), ReplayGrapples, CorrectionsLocal, GrappleCorrectionsLocal);
+	if (ReplayReportFilename.IsEmpty())
+	{
+		return;
+	}
+
+	// one line FParse can read back, no key is part of another
+	const FString ReportLocal = FString::Printf(TEXT("Replayed=%d Recorded=%d Grapples=%d Corrections=%d WhileGrappling=%d\n"),
+		FramesLocal, Recording.Frames.Num(), ReplayGrapples, CorrectionsLocal, GrappleCorrectionsLocal);
+	if (!FFileHelper::SaveStringToFile(ReportLocal, *ReplayReportFilename))
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleInputRecorder: can't write %s"), *ReplayReportFilename);
+	}
+	// the process was started for this report
+	FPlatformMisc::RequestExit(false);
+}
+
+void UGrappleInputRecorderComponent::StopCapture()
+{
+	AGrappleCharacter* CharacterLocal = Cast<AGrappleCharacter>(GetOwner());
+	if (UInputComponent* InputLocal = CharacterLocal ? CharacterLocal->InputComponent.Get() : nullptr)
+	{
+		for (const int32 HandleLocal : ActionBindingHandles)
+		{
+			InputLocal->RemoveActionBindingForHandle(HandleLocal);
+		}
+	}
+	ActionBindingHandles.Reset();
+
+	if (AController* ControllerLocal = RecordedController.Get())
+	{
+		RemoveTickPrerequisiteActor(ControllerLocal);
+	}
+	if (UCharacterMovementComponent* MovementLocal = CharacterLocal ? CharacterLocal->GetCharacterMovement() : nullptr)
+	{
+		MovementLocal->RemoveTickPrerequisiteComponent(this);
+	}
+	RecordedController = nullptr;
+	SetComponentTickEnabled(false);
+	bRecording = false;
+	bReplaying = false;
+}
+
+void UGrappleInputRecorderComponent::BeginReplay(AGrappleCharacter* Character, const FGrappleInputRecording& InRecording)
+{
+	Character->SetActorLocationAndRotation(InRecording.StartLocation, InRecording.StartRotation, false, nullptr, ETeleportType::ResetPhysics);
+	if (AController* ControllerLocal = Character->GetController())
+	{
+		ControllerLocal->SetControlRotation(InRecording.StartControlRotation);
+	}
+	// the player had its cameras, the grapple trace starts from them
+	Character->RegisterViewComponents();
+	if (Character->GetIsIfFirstPerson() != InRecording.bStartFirstPerson)
+	{
+		Character->SwitchCamera();
+	}
+}
+
+void UGrappleInputRecorderComponent::ReplayFrame(AGrappleCharacter* Character, const FGrappleInputFrame& Frame)
+{
+	// actions, then axes, then the look, the order the player controller applies them in
+	if (EnumHasAnyFlags(Frame.Actions, EGrappleInputAction::JumpPressed))
+	{
+		Character->StartJump();
+	}
+	if (EnumHasAnyFlags(Frame.Actions, EGrappleInputAction::JumpReleased))
+	{
+		Character->EndJump();
+	}
+	if (EnumHasAnyFlags(Frame.Actions, EGrappleInputAction::SwitchCamera))
+	{
+		Character->SwitchCamera();
+	}
+	if (EnumHasAnyFlags(Frame.Actions, EGrappleInputAction::Grapple))
+	{
+		Character->Grapple();
+	}
+	Character->MoveForward(Frame.Forward);
+	Character->MoveRight(Frame.Right);
+	if (AController* ControllerLocal = Character->GetController())
+	{
+		ControllerLocal->SetControlRotation(Frame.GetControlRotation());
+	}
+}
@@ -0,0 +1,104 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GrappleInputRecording.h"
+#include "GrappleInputRecorderComponent.generated.h"
+
+class AGrappleCharacter;
+
+/**
+ * Records the local player's grapple character input into an FGrappleInputRecording, and feeds a recording back to a character for replays.
+ * Recording adds non consuming bindings for the character's actions next to its own and ticks after the controller processed the input
+ * (and before the character moves), reading the axis values the character stored and the resulting control rotation.
+ * Replay calls the character's own input handlers with the recorded values, so the character can't tell the difference; the look axes are
+ * replaced by the recorded control rotation. Only this character's input is recorded, the rest of the world must behave the same for a replay to match.
+ * Grapple.Record.Start / Grapple.Record.Stop [File] control the recording from the console (not in Shipping).
+ *
+ * Grapple.Replay.Start <File> [Report] replays a recording on the local player's character in a running game, paced by the recorded frame times and from wherever
+ * the character is (a client doesn't own its location, record from the player start). Meant for network clients: when the replay ends it logs the
+ * corrections the server sent, and with a report file given it writes them there and quits (what the GrappleNetCorrection commandlet waits for).
+ */
+UCLASS(ClassGroup = (Grapple))
+class UGrappleInputRecorderComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	FGrappleInputRecording Recording;
+	/** Actions pressed since the last recorded frame */
+	EGrappleInputAction PendingActions{ EGrappleInputAction::None };
+	/** Handles of the bindings added to the input component */
+	TArray<int32> ActionBindingHandles;
+	/** Controller this component ticks after while recording */
+	TWeakObjectPtr<AController> RecordedController;
+	bool bRecording{ false };
+
+	/** Live replay: next frame of Recording to feed, grapple presses fed so far and the movement component's correction counts when it started */
+	int32 ReplayFrameIndex{ 0 };
+	int32 ReplayGrapples{ 0 };
+	int32 ReplayStartCorrections{ 0 };
+	int32 ReplayStartGrappleCorrections{ 0 };
+	/** Live replay: game time since it started, and recorded time up to the end of the last fed frame */
+	double ReplayElapsedTime{ 0.0 };
+	double ReplayRecordedTime{ 0.0 };
+	/** Written when the live replay ends, empty for none */
+	FString ReplayReportFilename;
+	bool bReplaying{ false };
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleInputRecorderComponent();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/********************************
+	* MEMBER METHODS
+	********************************/
+public:
+	/** Starts a new recording of the owning character. Returns false if it isn't a locally controlled grapple character with its input set up */
+	UFUNCTION(BlueprintCallable, Category = "Grapple|Recording")
+	bool StartRecording();
+	/** Stops recording and saves it to Filename. Returns false if nothing was recorded or the file couldn't be written */
+	UFUNCTION(BlueprintCallable, Category = "Grapple|Recording")
+	bool StopRecording(const FString& Filename);
+	UFUNCTION(BlueprintPure, Category = "Grapple|Recording")
+	FORCEINLINE bool IsRecording() const { return bRecording; }
+	/** Replays InRecording on the owning locally controlled character from where it stands, writing the correction counts to ReportFilename (if any) when done */
+	bool StartReplay(const FGrappleInputRecording& InRecording, const FString& ReportFilename);
+	FORCEINLINE bool IsReplaying() const { return bReplaying; }
+
+	/** Replay: puts Character (spawned at the start location, possessed) in the state the recording starts from */
+	static void BeginReplay(AGrappleCharacter* Character, const FGrappleInputRecording& InRecording);
+	/** Replay: feeds one recorded frame to Character, call before ticking the world with the frame's delta time */
+	static void ReplayFrame(AGrappleCharacter* Character, const FGrappleInputFrame& Frame);
+
+protected:
+	void OnJumpPressed() { PendingActions |= EGrappleInputAction::JumpPressed; }
+	void OnJumpReleased() { PendingActions |= EGrappleInputAction::JumpReleased; }
+	void OnSwitchCamera() { PendingActions |= EGrappleInputAction::SwitchCamera; }
+	void OnGrapple() { PendingActions |= EGrappleInputAction::Grapple; }
+	/** Feeds the next frame of a live replay once its recorded time is reached, ends it after the last one */
+	void TickReplay(float DeltaTime);
+	/** Logs the live replay's correction counts, writes the report and quits if one was asked for */
+	void FinishReplay();
+	/** Removes the action bindings and the tick dependencies, ends recording and live replay */
+	void StopCapture();
+};
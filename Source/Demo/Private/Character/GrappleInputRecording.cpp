@@ -0,0 +1,166 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleInputRecording.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace GrappleInputRecording
+{
+	/** What a frame stores after its flags byte */
+	enum EFrameFlags : uint8
+	{
+		DeltaTimeChanged = 1 << 0,
+		ForwardChanged = 1 << 1,
+		RightChanged = 1 << 2,
+		PitchChanged = 1 << 3,
+		YawChanged = 1 << 4,
+		HasActions = 1 << 5,
+	};
+
+	/** Signed to unsigned so small deltas of either sign pack into few bytes */
+	FORCEINLINE uint32 ZigZag(int32 Value) { return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31); }
+	FORCEINLINE int32 UnZigZag(uint32 Value) { return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1); }
+
+	/** Frame time in whole microseconds, what the stream stores */
+	FORCEINLINE uint32 ToMicroseconds(float DeltaTime) { return static_cast<uint32>(FMath::RoundToInt(FMath::Max(DeltaTime, 0.f) * 1000000.f)); }
+
+	/** Writes or reads a 16 bit axis as the wrapped difference to the previous frame */
+	void SerializeAxisDelta(FArchive& Ar, uint16 Previous, uint16& Value)
+	{
+		uint32 PackedLocal = Ar.IsLoading() ? 0 : ZigZag(static_cast<int16>(Value - Previous));
+		Ar.SerializeIntPacked(PackedLocal);
+		if (Ar.IsLoading())
+		{
+			Value = static_cast<uint16>(Previous + UnZigZag(PackedLocal));
+		}
+	}
+}
+
+bool FGrappleInputRecording::SaveToFile(const FString& Filename)
+{
+	TArray<uint8> BytesLocal;
+	FMemoryWriter WriterLocal(BytesLocal);
+	Serialize(WriterLocal);
+	return FFileHelper::SaveArrayToFile(BytesLocal, *Filename);
+}
+
+bool FGrappleInputRecording::LoadFromFile(const FString& Filename)
+{
+	TArray<uint8> BytesLocal;
+	if (!FFileHelper::LoadFileToArray(BytesLocal, *Filename))
+	{
+		return false;
+	}
+	FMemoryReader ReaderLocal(BytesLocal);
+	Serialize(ReaderLocal);
+	return !ReaderLocal.IsError();
+}
+
+void FGrappleInputRecording::Serialize(FArchive& Ar)
+{
+	using namespace GrappleInputRecording;
+
+	uint32 MagicLocal = Magic;
+	uint16 VersionLocal = Version;
+	Ar << MagicLocal << VersionLocal;
+	if (MagicLocal != Magic || VersionLocal != Version)
+	{
+		Ar.SetError();
+		return;
+	}
+	Ar << MapName << CharacterClassPath << StartLocation << StartRotation << StartControlRotation << bStartFirstPerson;
+
+	int32 NumFramesLocal = Frames.Num();
+	Ar << NumFramesLocal;
+	if (Ar.IsLoading())
+	{
+		// a corrupt count must not allocate, every frame is at least its flags byte
+		if (NumFramesLocal < 0 || NumFramesLocal > Ar.TotalSize() - Ar.Tell())
+		{
+			Ar.SetError();
+			return;
+		}
+		Frames.SetNum(NumFramesLocal);
+	}
+
+	FGrappleInputFrame PreviousLocal;
+	uint32 PreviousMicrosecondsLocal = 0;
+	for (int32 FrameIndexLocal = 0; FrameIndexLocal < NumFramesLocal && !Ar.IsError(); ++FrameIndexLocal)
+	{
+		FGrappleInputFrame& FrameLocal = Frames[FrameIndexLocal];
+		uint32 MicrosecondsLocal = Ar.IsLoading() ? 0 : ToMicroseconds(FrameLocal.DeltaTime);
+
+		uint8 FlagsLocal = 0;
+		if (!Ar.IsLoading())
+		{
+			FlagsLocal |= MicrosecondsLocal != PreviousMicrosecondsLocal ? DeltaTimeChanged : 0;
+			FlagsLocal |= FrameLocal.Forward != PreviousLocal.Forward ? ForwardChanged : 0;
+			FlagsLocal |= FrameLocal.Right != PreviousLocal.Right ? RightChanged : 0;
+			FlagsLocal |= FrameLocal.Pitch != PreviousLocal.Pitch ? PitchChanged : 0;
+			FlagsLocal |= FrameLocal.Yaw != PreviousLocal.Yaw ? YawChanged : 0;
+			FlagsLocal |= FrameLocal.Actions != EGrappleInputAction::None ? HasActions : 0;
+		}
+		Ar << FlagsLocal;
+
+		if (FlagsLocal & DeltaTimeChanged)
+		{
+			uint32 PackedLocal = ZigZag(static_cast<int32>(MicrosecondsLocal - PreviousMicrosecondsLocal));
+			Ar.SerializeIntPacked(PackedLocal);
+			MicrosecondsLocal = PreviousMicrosecondsLocal + UnZigZag(PackedLocal);
+		}
+		else
+		{
+			MicrosecondsLocal = PreviousMicrosecondsLocal;
+		}
+		if (Ar.IsLoading())
+		{
+			// the replay runs on the stored microseconds, the same every time
+			FrameLocal.DeltaTime = MicrosecondsLocal / 1000000.f;
+			FrameLocal.Forward = PreviousLocal.Forward;
+			FrameLocal.Right = PreviousLocal.Right;
+			FrameLocal.Pitch = PreviousLocal.Pitch;
+			FrameLocal.Yaw = PreviousLocal.Yaw;
+		}
+		if (FlagsLocal & ForwardChanged)
+		{
+			Ar << FrameLocal.Forward;
+		}
+		if (FlagsLocal & RightChanged)
+		{
+			Ar << FrameLocal.Right;
+		}
+		if (FlagsLocal & PitchChanged)
+		{
+			SerializeAxisDelta(Ar, PreviousLocal.Pitch, FrameLocal.Pitch);
+		}
+		if (FlagsLocal & YawChanged)
+		{
+			SerializeAxisDelta(Ar, PreviousLocal.Yaw, FrameLocal.Yaw);
+		}
+		if (FlagsLocal & HasActions)
+		{
+			uint8 ActionsLocal = static_cast<uint8>(FrameLocal.Actions);
+			Ar << ActionsLocal;
+			FrameLocal.Actions = static_cast<EGrappleInputAction>(ActionsLocal);
+		}
+		if (IsCheckpoint(FrameIndexLocal))
+		{
+			Ar << FrameLocal.Location;
+		}
+
+		PreviousLocal = FrameLocal;
+		PreviousMicrosecondsLocal = MicrosecondsLocal;
+	}
+}
+
+double FGrappleInputRecording::GetDuration() const
+{
+	double DurationLocal = 0.0;
+	for (const FGrappleInputFrame& FrameLocal : Frames)
+	{
+		DurationLocal += FrameLocal.DeltaTime;
+	}
+	return DurationLocal;
+}
@@ -0,0 +1,68 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Input actions of one frame, replayed in this order (the order the character binds them in) */
+enum class EGrappleInputAction : uint8
+{
+	None = 0,
+	JumpPressed = 1 << 0,
+	JumpReleased = 1 << 1,
+	SwitchCamera = 1 << 2,
+	Grapple = 1 << 3,
+};
+ENUM_CLASS_FLAGS(EGrappleInputAction);
+
+/** Input of one frame */
+struct FGrappleInputFrame
+{
+	float DeltaTime{ 0.f };
+	/** Move Forward / Backward and Move Right / Left axis values */
+	float Forward{ 0.f };
+	float Right{ 0.f };
+	/** Control rotation after the frame's look input (pitch and yaw, 16 bit each). Replayed directly instead of the mouse axes: replays match each other exactly, the recorded session only to 16 bits */
+	uint16 Pitch{ 0 };
+	uint16 Yaw{ 0 };
+	EGrappleInputAction Actions{ EGrappleInputAction::None };
+	/** Character location at the start of the frame, only kept on checkpoint frames (every CheckpointInterval) to measure replay drift */
+	FVector3f Location{ 0.f };
+
+	FORCEINLINE FRotator GetControlRotation() const { return FRotator(FRotator::DecompressAxisFromShort(Pitch), FRotator::DecompressAxisFromShort(Yaw), 0.f); }
+	FORCEINLINE void SetControlRotation(const FRotator& Rotation)
+	{
+		Pitch = FRotator::CompressAxisToShort(Rotation.Pitch);
+		Yaw = FRotator::CompressAxisToShort(Rotation.Yaw);
+	}
+};
+
+/**
+ * A grapple character's input session: where it started and one FGrappleInputFrame per frame. Saved as a delta encoded binary stream:
+ * a flags byte per frame followed only by what changed since the previous frame (frame time as packed microseconds, axis values,
+ * zigzag packed rotation deltas, actions), plus the location on checkpoint frames. A keyboard and mouse session is a few bytes per frame.
+ */
+class FGrappleInputRecording
+{
+public:
+	static constexpr uint32 Magic = 0x52495247;
+	static constexpr uint16 Version = 1;
+	static constexpr int32 CheckpointInterval = 60;
+
+	/** Long package name of the map and path of the character class it was recorded with */
+	FString MapName;
+	FString CharacterClassPath;
+	FVector StartLocation{ 0.f };
+	FRotator StartRotation{ 0.f };
+	FRotator StartControlRotation{ 0.f };
+	bool bStartFirstPerson{ false };
+	TArray<FGrappleInputFrame> Frames;
+
+	static FORCEINLINE bool IsCheckpoint(int32 FrameIndex) { return FrameIndex % CheckpointInterval == 0; }
+
+	bool SaveToFile(const FString& Filename);
+	bool LoadFromFile(const FString& Filename);
+	void Serialize(FArchive& Ar);
+	/** Recorded time (s) */
+	double GetDuration() const;
+};
@@ -0,0 +1,746 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleMovementComponent.h"
+#include "GrappleCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Grapple/GrappleSignificanceSubsystem.h"
+#include "Grapple/GrappleStats.h"
+
+namespace GrappleMovement
+{
+	/** How close to the anchor the server's line of sight check must get for a client anchor to be accepted (anchor is quantized and the hit surface may be thin) */
+	constexpr float ServerAnchorLineOfSightTolerance = 50.f;
+	/** Wrap traces stop this short of the pivot so the surface the anchor (or a corner) sits on isn't hit */
+	constexpr float WrapTraceEndTolerance = 10.f;
+	/** The drawn rope sits this far off the surfaces it wraps around */
+	constexpr float WrapRopeSurfaceOffset = 2.f;
+
+	/** Rounds to the same 0.1 cm grid FVector_NetQuantize10 sends, so the client predicts against exactly the anchor the server receives */
+	FORCEINLINE FVector QuantizeAnchor(const FVector& Anchor)
+	{
+		return FVector(FMath::RoundToDouble(Anchor.X * 10.0) / 10.0, FMath::RoundToDouble(Anchor.Y * 10.0) / 10.0, FMath::RoundToDouble(Anchor.Z * 10.0) / 10.0);
+	}
+}
+
+/*************************************
+* NETWORK MOVE DATA
+*************************************/
+void FGrappleNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType)
+{
+	Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	const FSavedMove_Grapple& GrappleMoveLocal = static_cast<const FSavedMove_Grapple&>(ClientMove);
+	GrappleAnchor = GrappleMoveLocal.SavedGrappleAnchor;
+}
+
+bool FGrappleNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+	// the anchor only matters on the move that fires the grapple, every other move pays nothing for it
+	if (CompressedMoveFlags & FSavedMove_Character::FLAG_Custom_0)
+	{
+		bool bLocalSuccess = true;
+		GrappleAnchor.NetSerialize(Ar, PackageMap, bLocalSuccess);
+	}
+
+	return !Ar.IsError();
+}
+
+FGrappleNetworkMoveDataContainer::FGrappleNetworkMoveDataContainer()
+{
+	NewMoveData = &GrappleDefaultMoveData[0];
+	PendingMoveData = &GrappleDefaultMoveData[1];
+	OldMoveData = &GrappleDefaultMoveData[2];
+}
+
+/*************************************
+* SAVED MOVE
+*************************************/
+FSavedMove_Grapple::FSavedMove_Grapple()
+	: bSavedWantsToGrapple(false)
+	, bSavedWantsToReleaseGrapple(false)
+	, bSavedGrappleAttachedAfterMove(false)
+	, bSavedFirstPerson(false)
+	, bSavedStartGrappleActive(false)
+	, bSavedStartGrappleAttached(false)
+	, bSavedStartArrived(false)
+{
+}
+
+void FSavedMove_Grapple::Clear()
+{
+	Super::Clear();
+
+	bSavedWantsToGrapple = false;
+	bSavedWantsToReleaseGrapple = false;
+	bSavedGrappleAttachedAfterMove = false;
+	bSavedFirstPerson = false;
+	SavedGrappleAnchor = FVector::ZeroVector;
+	SavedGrappleAnchorComponent.Reset();
+	bSavedStartGrappleActive = false;
+	bSavedStartGrappleAttached = false;
+	bSavedStartArrived = false;
+	SavedStartAttachLocation = FVector::ZeroVector;
+	SavedStartAnchorComponent.Reset();
+	SavedStartAnchorLocalOffset = FVector::ZeroVector;
+	SavedStartHookLocation = FVector::ZeroVector;
+	SavedStartHookStartLocation = FVector::ZeroVector;
+	SavedStartHookFlightTime = 0.f;
+	SavedStartHookAttachTime = 0.f;
+	SavedStartWrapPoints.Reset();
+	SavedStartWrappedLength = 0.0;
+}
+
+uint8 FSavedMove_Grapple::GetCompressedFlags() const
+{
+	uint8 ResultLocal = Super::GetCompressedFlags();
+
+	if (bSavedWantsToGrapple)
+	{
+		ResultLocal |= FLAG_Custom_0;
+	}
+	if (bSavedGrappleAttachedAfterMove)
+	{
+		ResultLocal |= FLAG_Custom_1;
+	}
+	if (bSavedWantsToReleaseGrapple)
+	{
+		ResultLocal |= FLAG_Custom_2;
+	}
+	if (bSavedFirstPerson)
+	{
+		ResultLocal |= FLAG_Custom_3;
+	}
+
+	return ResultLocal;
+}
+
+bool FSavedMove_Grapple::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const
+{
+	const FSavedMove_Grapple* NewGrappleMoveLocal = static_cast<const FSavedMove_Grapple*>(NewMove.Get());
+
+	// grapple transitions must reach the server on the move they happened on
+	if (bSavedWantsToGrapple || NewGrappleMoveLocal->bSavedWantsToGrapple
+		|| bSavedWantsToReleaseGrapple != NewGrappleMoveLocal->bSavedWantsToReleaseGrapple
+		|| bSavedGrappleAttachedAfterMove != NewGrappleMoveLocal->bSavedGrappleAttachedAfterMove
+		|| bSavedFirstPerson != NewGrappleMoveLocal->bSavedFirstPerson)
+	{
+		return false;
+	}
+
+	return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+void FSavedMove_Grapple::SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData)
+{
+	Super::SetMoveFor(C, InDeltaTime, NewAccel, ClientData);
+
+	const AGrappleCharacter* GrappleCharacterLocal = Cast<AGrappleCharacter>(C);
+	const UGrappleMovementComponent* GrappleMovementLocal = GrappleCharacterLocal ? GrappleCharacterLocal->GetGrappleMovement() : nullptr;
+	if (!GrappleMovementLocal)
+	{
+		return;
+	}
+
+	bSavedWantsToGrapple = GrappleMovementLocal->bWantsToGrapple;
+	bSavedWantsToReleaseGrapple = GrappleMovementLocal->bWantsToReleaseGrapple;
+	SavedGrappleAnchor = GrappleMovementLocal->RequestedGrappleAnchor;
+	SavedGrappleAnchorComponent = GrappleMovementLocal->RequestedGrappleAnchorComponent;
+	bSavedFirstPerson = GrappleCharacterLocal->GetIsIfFirstPerson();
+
+	bSavedStartGrappleActive = GrappleCharacterLocal->GetGrappleActive();
+	bSavedStartGrappleAttached = GrappleCharacterLocal->GetGrappleAttached();
+	bSavedStartArrived = GrappleCharacterLocal->GetArrived();
+	SavedStartAttachLocation = GrappleCharacterLocal->GetAttachLocation();
+	SavedStartAnchorComponent = GrappleCharacterLocal->GetAnchorComponent();
+	SavedStartAnchorLocalOffset = GrappleCharacterLocal->GetAnchorLocalOffset();
+	SavedStartHookLocation = GrappleMovementLocal->HookLocation;
+	SavedStartHookStartLocation = GrappleMovementLocal->HookStartLocation;
+	SavedStartHookFlightTime = GrappleMovementLocal->HookFlightTime;
+	SavedStartHookAttachTime = GrappleMovementLocal->HookAttachTime;
+	SavedStartWrapPoints = GrappleMovementLocal->WrapPoints;
+	SavedStartWrappedLength = GrappleMovementLocal->WrappedLength;
+}
+
+void FSavedMove_Grapple::PostUpdate(ACharacter* C, EPostUpdateMode PostUpdateMode)
+{
+	Super::PostUpdate(C, PostUpdateMode);
+
+	if (PostUpdateMode == PostUpdate_Record)
+	{
+		if (const AGrappleCharacter* GrappleCharacterLocal = Cast<AGrappleCharacter>(C))
+		{
+			bSavedGrappleAttachedAfterMove = GrappleCharacterLocal->GetGrappleActive() && GrappleCharacterLocal->GetGrappleAttached();
+		}
+	}
+}
+
+void FSavedMove_Grapple::PrepMoveFor(ACharacter* C)
+{
+	Super::PrepMoveFor(C);
+
+	AGrappleCharacter* GrappleCharacterLocal = Cast<AGrappleCharacter>(C);
+	UGrappleMovementComponent* GrappleMovementLocal = GrappleCharacterLocal ? GrappleCharacterLocal->GetGrappleMovement() : nullptr;
+	if (!GrappleMovementLocal)
+	{
+		return;
+	}
+
+	// replaying after a correction, put the grapple back to how it was when this move was first made
+	RestoreStartState(GrappleCharacterLocal);
+	GrappleMovementLocal->bWantsToGrapple = bSavedWantsToGrapple;
+	GrappleMovementLocal->bWantsToReleaseGrapple = bSavedWantsToReleaseGrapple;
+	GrappleMovementLocal->RequestedGrappleAnchor = SavedGrappleAnchor;
+	GrappleMovementLocal->RequestedGrappleAnchorComponent = SavedGrappleAnchorComponent;
+}
+
+void FSavedMove_Grapple::CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC, const FVector& OldStartLocation)
+{
+	Super::CombineWith(OldMove, InCharacter, PC, OldStartLocation);
+
+	// the combined move runs again from where the old one started: without going back, the old move's hook flight time and
+	// rope wrapping would be simulated twice
+	const FSavedMove_Grapple* OldGrappleMoveLocal = static_cast<const FSavedMove_Grapple*>(OldMove);
+	bSavedStartGrappleActive = OldGrappleMoveLocal->bSavedStartGrappleActive;
+	bSavedStartGrappleAttached = OldGrappleMoveLocal->bSavedStartGrappleAttached;
+	bSavedStartArrived = OldGrappleMoveLocal->bSavedStartArrived;
+	SavedStartAttachLocation = OldGrappleMoveLocal->SavedStartAttachLocation;
+	SavedStartAnchorComponent = OldGrappleMoveLocal->SavedStartAnchorComponent;
+	SavedStartAnchorLocalOffset = OldGrappleMoveLocal->SavedStartAnchorLocalOffset;
+	SavedStartHookLocation = OldGrappleMoveLocal->SavedStartHookLocation;
+	SavedStartHookStartLocation = OldGrappleMoveLocal->SavedStartHookStartLocation;
+	SavedStartHookFlightTime = OldGrappleMoveLocal->SavedStartHookFlightTime;
+	SavedStartHookAttachTime = OldGrappleMoveLocal->SavedStartHookAttachTime;
+	SavedStartWrapPoints = OldGrappleMoveLocal->SavedStartWrapPoints;
+	SavedStartWrappedLength = OldGrappleMoveLocal->SavedStartWrappedLength;
+	if (AGrappleCharacter* GrappleCharacterLocal = Cast<AGrappleCharacter>(InCharacter))
+	{
+		RestoreStartState(GrappleCharacterLocal);
+	}
+}
+
+void FSavedMove_Grapple::RestoreStartState(AGrappleCharacter* GrappleCharacter) const
+{
+	UGrappleMovementComponent* GrappleMovementLocal = GrappleCharacter->GetGrappleMovement();
+	if (!GrappleMovementLocal)
+	{
+		return;
+	}
+
+	GrappleCharacter->RestoreGrappleState(bSavedStartGrappleActive, bSavedStartGrappleAttached, bSavedStartArrived, SavedStartAttachLocation, SavedStartAnchorComponent.Get(), SavedStartAnchorLocalOffset);
+	GrappleMovementLocal->HookLocation = SavedStartHookLocation;
+	GrappleMovementLocal->HookStartLocation = SavedStartHookStartLocation;
+	GrappleMovementLocal->HookFlightTime = SavedStartHookFlightTime;
+	GrappleMovementLocal->HookAttachTime = SavedStartHookAttachTime;
+	GrappleMovementLocal->WrapPoints = SavedStartWrapPoints;
+	GrappleMovementLocal->WrappedLength = SavedStartWrappedLength;
+	GrappleMovementLocal->UpdateCableWrapPoints();
+}
+
+FNetworkPredictionData_Client_Grapple::FNetworkPredictionData_Client_Grapple(const UCharacterMovementComponent& ClientMovement)
+	: Super(ClientMovement)
+{
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_Grapple::AllocateNewMove()
+{
+	return FSavedMovePtr(new FSavedMove_Grapple());
+}
+
+/*************************************
+* GRAPPLE MOVEMENT COMPONENT
+*************************************/
+UGrappleMovementComponent::UGrappleMovementComponent()
+	: bWantsToGrapple(false)
+	, bWantsToReleaseGrapple(false)
+	, bClientGrappleAttached(false)
+	, bMoveFirstPerson(false)
+{
+	SetNetworkMoveDataContainer(GrappleNetworkMoveDataContainer);
+}
+
+void UGrappleMovementComponent::SetUpdatedComponent(USceneComponent* NewUpdatedComponent)
+{
+	Super::SetUpdatedComponent(NewUpdatedComponent);
+
+	// CharacterOwner is (re)set by the parent, cache the grapple version so the movement update doesn't need to cast every frame
+	GrappleCharacterOwner = Cast<AGrappleCharacter>(CharacterOwner);
+}
+
+void UGrappleMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	// the anchor component already ticked (tick prerequisite), its transform is read once here for the whole frame
+	if (GrappleCharacterOwner && GrappleCharacterOwner->UpdateAnchor() && GrappleCharacterOwner->GetGrappleAttached())
+	{
+		HookLocation = GrappleCharacterOwner->GetAttachLocation();
+		GrappleCharacterOwner->UpdateGrappleCable(HookLocation);
+	}
+	if (GrappleCharacterOwner && GrappleCharacterOwner->GetGrappleActive())
+	{
+		GRAPPLE_INC_COUNTER(ActiveGrapples, 1);
+	}
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
+FNetworkPredictionData_Client* UGrappleMovementComponent::GetPredictionData_Client() const
+{
+	if (ClientPredictionData == nullptr)
+	{
+		UGrappleMovementComponent* MutableThisLocal = const_cast<UGrappleMovementComponent*>(this);
+		MutableThisLocal->ClientPredictionData = new FNetworkPredictionData_Client_Grapple(*this);
+	}
+
+	return ClientPredictionData;
+}
+
+void UGrappleMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
+{
+	Super::UpdateFromCompressedFlags(Flags);
+
+	bWantsToGrapple = (Flags & FSavedMove_Character::FLAG_Custom_0) != 0;
+	bClientGrappleAttached = (Flags & FSavedMove_Character::FLAG_Custom_1) != 0;
+	bWantsToReleaseGrapple = (Flags & FSavedMove_Character::FLAG_Custom_2) != 0;
+	bMoveFirstPerson = (Flags & FSavedMove_Character::FLAG_Custom_3) != 0;
+}
+
+void UGrappleMovementComponent::ServerMove_PerformMovement(const FCharacterNetworkMoveData& MoveData)
+{
+	// the container only ever holds grapple move data
+	RequestedGrappleAnchor = static_cast<const FGrappleNetworkMoveData&>(MoveData).GrappleAnchor;
+
+	Super::ServerMove_PerformMovement(MoveData);
+}
+
+void UGrappleMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
+{
+	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+
+	if (!GrappleCharacterOwner)
+	{
+		return;
+	}
+
+	if (bWantsToReleaseGrapple && GrappleCharacterOwner->GetGrappleActive())
+	{
+		if (GrappleCharacterOwner->GetArrived())
+		{
+			// this is also used to exit grapple when at attached locations above the GrappleAcceptedFallDistance
+			GrappleCharacterOwner->BreakGrapple();
+		}
+		else
+		{
+			GrappleCharacterOwner->StopGrapple();
+		}
+	}
+
+	if (bWantsToGrapple)
+	{
+		USceneComponent* AnchorComponentLocal = RequestedGrappleAnchorComponent.Get();
+		if (!IsServerForRemoteClient() || IsValidGrappleAnchor(RequestedGrappleAnchor, AnchorComponentLocal))
+		{
+			GrappleCharacterOwner->HandleGrappleStarted(RequestedGrappleAnchor, AnchorComponentLocal);
+			BeginGrapple();
+		}
+	}
+
+	if (GrappleCharacterOwner->GetGrappleActive() && !GrappleCharacterOwner->GetGrappleAttached())
+	{
+		UpdateHookFlight(DeltaSeconds);
+	}
+}
+
+void UGrappleMovementComponent::UpdateCharacterStateAfterMovement(float DeltaSeconds)
+{
+	Super::UpdateCharacterStateAfterMovement(DeltaSeconds);
+
+	// grapple requests are one-shot inputs, they were recorded in the saved move before this update ran
+	bWantsToGrapple = false;
+	bWantsToReleaseGrapple = false;
+}
+
+void UGrappleMovementComponent::PhysCustom(float deltaTime, int32 Iterations)
+{
+	if (CustomMovementMode == static_cast<uint8>(ECustomMovementMode::CMOVE_Grapple))
+	{
+		PhysGrapple(deltaTime, Iterations);
+		return;
+	}
+
+	Super::PhysCustom(deltaTime, Iterations);
+}
+
+void UGrappleMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
+{
+	Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
+
+	// the rope only wraps while pulling
+	if (!IsGrappling())
+	{
+		ClearWrapPoints();
+	}
+}
+
+void UGrappleMovementComponent::OnClientCorrectionReceived(FNetworkPredictionData_Client_Character& ClientData, float TimeStamp, FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase,
+	FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode)
+{
+	Super::OnClientCorrectionReceived(ClientData, TimeStamp, NewLocation, NewVelocity, NewBase, NewBaseBoneName, bHasBase, bBaseRelativePosition, ServerMovementMode);
+
+	// the grapple state the client predicted when the correction arrived, before the moves are replayed
+	++NumClientCorrections;
+	if (GrappleCharacterOwner && GrappleCharacterOwner->GetGrappleActive())
+	{
+		++NumGrappleCorrections;
+	}
+}
+
+void UGrappleMovementComponent::RequestGrapple(const FVector& Anchor, USceneComponent* AnchorComponent)
+{
+	bWantsToGrapple = true;
+	RequestedGrappleAnchor = GrappleMovement::QuantizeAnchor(Anchor);
+	RequestedGrappleAnchorComponent = AnchorComponent;
+}
+
+void UGrappleMovementComponent::RequestGrappleRelease()
+{
+	bWantsToReleaseGrapple = true;
+}
+
+void UGrappleMovementComponent::BeginGrapple()
+{
+	GRAPPLE_SCOPE_CYCLE_COUNTER(Begin);
+
+	ClearWrapPoints();
+	if (GrappleCharacterOwner->GetGrappleAttached())
+	{
+		// re-fired while already attached, the hook jumps straight to the new location and the pull continues
+		HookLocation = GrappleCharacterOwner->GetAttachLocation();
+		SetMovementMode(MOVE_Custom, static_cast<uint8>(ECustomMovementMode::CMOVE_Grapple));
+	}
+	else
+	{
+		LaunchHook(GrappleCharacterOwner->GetGrappleGun()->GetComponentLocation());
+	}
+	GrappleCharacterOwner->UpdateGrappleCable(HookLocation);
+}
+
+void UGrappleMovementComponent::EndGrapple()
+{
+	if (IsGrappling() || (MovementMode == MOVE_Flying && GrappleCharacterOwner && GrappleCharacterOwner->GetArrived()))
+	{
+		SetMovementMode(MOVE_Falling);
+	}
+}
+
+void UGrappleMovementComponent::AdoptGrapple(const FVector& InHookLocation, bool bAttached, bool bArrived)
+{
+	GrappleCharacterOwner->UpdateGrappleCable(InHookLocation);
+	if (!bAttached)
+	{
+		// the flight is memoryless, carrying on from where the entity's hook is gives the same path
+		LaunchHook(InHookLocation);
+		return;
+	}
+
+	AttachHook();
+	if (bArrived)
+	{
+		// same hold as an arrival inside CheckGrappleArrival
+		GrappleCharacterOwner->HandleGrappleArrived();
+		if (!IsFirstPersonMove())
+		{
+			Velocity = FVector::ZeroVector;
+			SetMovementMode(MOVE_Flying);
+		}
+	}
+}
+
+bool UGrappleMovementComponent::IsValidGrappleAnchor(const FVector& Anchor, USceneComponent*& OutAnchorComponent) const
+{
+	OutAnchorComponent = nullptr;
+	const FVector EyeLocationLocal = UpdatedComponent->GetComponentLocation() + FVector(0.f, 0.f, CharacterOwner->BaseEyeHeight);
+	if (FVector::DistSquared(EyeLocationLocal, Anchor) > FMath::Square(GrappleCharacterOwner->GetGrappleLength() + ServerAnchorDistanceTolerance))
+	{
+		return false;
+	}
+
+	// the client traced from its camera, the server makes sure nothing solid sits between the character and the anchor and that the anchor
+	// is on a grapplable surface. The trace reaches just past the anchor so it finds that surface; hitting nothing means the anchor is in the air
+	GRAPPLE_INC_COUNTER(Traces, 1);
+	FHitResult HitResultLocal;
+	const FVector TraceEndLocal = Anchor + ((Anchor - EyeLocationLocal).GetSafeNormal() * GrappleMovement::ServerAnchorLineOfSightTolerance);
+	if (!GetWorld()->LineTraceSingleByObjectType(HitResultLocal, EyeLocationLocal, TraceEndLocal, GrappleCharacterOwner->GetGrappleObjectQueryParams(), GrappleCharacterOwner->GetGrappleQueryParams()))
+	{
+		return false;
+	}
+	if (FVector::DistSquared(HitResultLocal.Location, Anchor) > FMath::Square(GrappleMovement::ServerAnchorLineOfSightTolerance))
+	{
+		return false;
+	}
+	OutAnchorComponent = HitResultLocal.GetComponent();
+	return true;
+}
+
+void UGrappleMovementComponent::LaunchHook(const FVector& Start)
+{
+	HookStartLocation = Start;
+	HookLocation = Start;
+	HookFlightTime = 0.f;
+	// the attach location is already known, so is the time the hook gets there
+	HookAttachTime = FGrappleSolver::GetHookAttachTime(FVector::Dist(Start, GrappleCharacterOwner->GetAttachLocation()), GrappleCharacterOwner->GetGrappleAttachSpeed(), HookAttachTolerance);
+}
+
+void UGrappleMovementComponent::UpdateHookFlight(float DeltaSeconds)
+{
+	GRAPPLE_SCOPE_CYCLE_COUNTER(HookFlight);
+	GRAPPLE_INC_COUNTER(HookFlightSteps, 1);
+
+	const FVector AttachLocationLocal = GrappleCharacterOwner->GetAttachLocation();
+
+	// evaluated from the flight time rather than stepped, so it doesn't matter how the time is sliced
+	HookFlightTime += DeltaSeconds;
+	HookLocation = FGrappleSolver::GetHookLocation(HookStartLocation, AttachLocationLocal, GrappleCharacterOwner->GetGrappleAttachSpeed(), HookFlightTime);
+
+	if (IsServerForRemoteClient())
+	{
+		// the owning client decides the exact move the hook attaches on (its hook starts from its own animated gun), the server only bounds it
+		if (bClientGrappleAttached && FGrappleSolver::IsHookAttached(HookLocation, AttachLocationLocal, ServerHookAttachTolerance))
+		{
+			AttachHook();
+		}
+	}
+	else if (HookFlightTime >= HookAttachTime)
+	{
+		AttachHook();
+	}
+	GrappleCharacterOwner->UpdateGrappleCable(HookLocation);
+}
+
+void UGrappleMovementComponent::AttachHook()
+{
+	// Grapple end has reached the attach location, start pulling the character
+	HookLocation = GrappleCharacterOwner->GetAttachLocation();
+	GrappleCharacterOwner->HandleGrappleAttached();
+	if (GrappleCharacterOwner->BeginTether())
+	{
+		// the hook pulls the body it landed on, the character keeps its movement mode
+		return;
+	}
+	SetMovementMode(MOVE_Custom, static_cast<uint8>(ECustomMovementMode::CMOVE_Grapple));
+}
+
+void UGrappleMovementComponent::PhysGrapple(float deltaTime, int32 Iterations)
+{
+	if (deltaTime < MIN_TICK_TIME)
+	{
+		return;
+	}
+
+	if (!GrappleCharacterOwner || !GrappleCharacterOwner->GetGrappleActive() || !GrappleCharacterOwner->GetGrappleAttached())
+	{
+		// grapple was released outside of the movement update
+		SetMovementMode(MOVE_Falling);
+		StartNewPhysics(deltaTime, Iterations);
+		return;
+	}
+
+	GRAPPLE_SCOPE_CYCLE_COUNTER(Pull);
+
+	const int32 MaxSubstepsLocal = GrappleSubstepLimit > 0 ? FMath::Min(GrappleSubstepLimit, MaxGrappleSubsteps) : MaxGrappleSubsteps;
+	int32 NumSubstepsLocal = FMath::Clamp(FMath::CeilToInt(deltaTime / MaxGrappleSubstepTime), 1, MaxSubstepsLocal);
+	if (!CharacterOwner->IsPlayerControlled())
+	{
+		// AI grapples share a per-frame budget, players are never throttled (their client predicted with the full substeps)
+		if (UGrappleSignificanceSubsystem* SignificanceSubsystemLocal = GetWorld()->GetSubsystem<UGrappleSignificanceSubsystem>())
+		{
+			NumSubstepsLocal = SignificanceSubsystemLocal->ConsumeGrappleSubsteps(NumSubstepsLocal);
+		}
+	}
+	const float SubstepTimeLocal = deltaTime / NumSubstepsLocal;
+	GRAPPLE_INC_COUNTER(PullSubsteps, NumSubstepsLocal);
+	// each substep closes the same fraction of the remaining distance, so splitting a frame differently gives the same trajectory
+	const float RemainingLocal = FGrappleSolver::GetPullRemaining(GrappleCharacterOwner->GetPlayerGrappleSpeed(), SubstepTimeLocal);
+
+	for (int32 SubstepLocal = 0; SubstepLocal < NumSubstepsLocal; ++SubstepLocal)
+	{
+		UpdateRopeWrap();
+		const FVector OldLocationLocal = UpdatedComponent->GetComponentLocation();
+		const FVector DeltaLocal = FGrappleSolver::ApproachAlongRope(OldLocationLocal, GetGrapplePivot(), WrappedLength, RemainingLocal) - OldLocationLocal;
+
+		Velocity = DeltaLocal / SubstepTimeLocal;
+
+		FHitResult HitLocal(1.f);
+		SafeMoveUpdatedComponent(DeltaLocal, UpdatedComponent->GetComponentQuat(), true, HitLocal);
+		if (HitLocal.IsValidBlockingHit())
+		{
+			HandleImpact(HitLocal, SubstepTimeLocal, DeltaLocal);
+			SlideAlongSurface(DeltaLocal, 1.f - HitLocal.Time, HitLocal.Normal, HitLocal, true);
+		}
+
+		if (!CheckGrappleArrival())
+		{
+			// state changed (arrived in third person or broke off), hand the rest of the frame to the new movement mode
+			const float RemainingTimeLocal = SubstepTimeLocal * (NumSubstepsLocal - SubstepLocal - 1);
+			if (RemainingTimeLocal >= MIN_TICK_TIME)
+			{
+				StartNewPhysics(RemainingTimeLocal, Iterations + 1);
+			}
+			return;
+		}
+	}
+}
+
+FVector UGrappleMovementComponent::GetGrapplePivot() const
+{
+	if (WrapPoints.Num() > 0)
+	{
+		return WrapPoints.Last().Location;
+	}
+	return GrappleCharacterOwner ? GrappleCharacterOwner->GetAttachLocation() : FVector::ZeroVector;
+}
+
+float UGrappleMovementComponent::GetGrappleRopeLength() const
+{
+	return static_cast<float>(WrappedLength + FVector::Dist(UpdatedComponent ? UpdatedComponent->GetComponentLocation() : FVector::ZeroVector, GetGrapplePivot()));
+}
+
+void UGrappleMovementComponent::UpdateRopeWrap()
+{
+	if (!bWrapAroundGeometry)
+	{
+		return;
+	}
+
+	const FVector LocationLocal = UpdatedComponent->GetComponentLocation();
+	const FVector PivotLocal = GetGrapplePivot();
+	const FVector PreviousPivotLocal = WrapPoints.Num() > 1 ? WrapPoints[WrapPoints.Num() - 2].Location : GrappleCharacterOwner->GetAttachLocation();
+
+	// swung back around the last corner, no trace needed
+	if (WrapPoints.Num() > 0 && FGrappleSolver::ShouldUnwrap(PreviousPivotLocal, WrapPoints.Last(), LocationLocal))
+	{
+		PopWrapPoint();
+		return;
+	}
+
+	// pulled onto the last corner: look past it, else look for a new corner between the character and the last one
+	const float CapsuleRadiusLocal = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius();
+	const bool bAtPivotLocal = WrapPoints.Num() > 0 && FVector::DistSquared(LocationLocal, PivotLocal) <= FMath::Square(CapsuleRadiusLocal);
+	const FVector TraceTargetLocal = bAtPivotLocal ? PreviousPivotLocal : PivotLocal;
+	const FVector ToTargetLocal = TraceTargetLocal - LocationLocal;
+	const double TargetDistanceLocal = ToTargetLocal.Size();
+	if (TargetDistanceLocal <= GrappleMovement::WrapTraceEndTolerance)
+	{
+		return;
+	}
+
+	GRAPPLE_SCOPE_CYCLE_COUNTER(RopeWrap);
+	GRAPPLE_INC_COUNTER(Traces, 1);
+	FHitResult HitResultLocal;
+	const FVector TraceEndLocal = LocationLocal + (ToTargetLocal * ((TargetDistanceLocal - GrappleMovement::WrapTraceEndTolerance) / TargetDistanceLocal));
+	const bool bHitLocal = GetWorld()->LineTraceSingleByObjectType(HitResultLocal, LocationLocal, TraceEndLocal, GrappleCharacterOwner->GetGrappleObjectQueryParams(), GrappleCharacterOwner->GetGrappleQueryParams());
+	if (bAtPivotLocal)
+	{
+		if (!bHitLocal)
+		{
+			PopWrapPoint();
+		}
+	}
+	else if (bHitLocal && !HitResultLocal.bStartPenetrating && WrapPoints.Num() < MaxWrapPoints)
+	{
+		PushWrapPoint(HitResultLocal.ImpactPoint, HitResultLocal.ImpactNormal, LocationLocal);
+	}
+}
+
+void UGrappleMovementComponent::PushWrapPoint(const FVector& ImpactPoint, const FVector& ImpactNormal, const FVector& Location)
+{
+	const FVector PivotLocal = GetGrapplePivot();
+	FGrappleSolver::FWrapPoint& WrapPointLocal = WrapPoints.AddDefaulted_GetRef();
+	WrapPointLocal.Location = ImpactPoint + (ImpactNormal * (CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius() + WrapSurfaceOffset));
+	WrapPointLocal.RopeLocation = ImpactPoint + (ImpactNormal * GrappleMovement::WrapRopeSurfaceOffset);
+	WrapPointLocal.BendNormal = FGrappleSolver::GetBendNormal(PivotLocal, WrapPointLocal.Location, Location);
+	WrappedLength += FVector::Dist(PivotLocal, WrapPointLocal.Location);
+	UpdateCableWrapPoints();
+}
+
+void UGrappleMovementComponent::PopWrapPoint()
+{
+	const FVector CornerLocal = WrapPoints.Pop(false).Location;
+	WrappedLength = WrapPoints.Num() > 0 ? FMath::Max(WrappedLength - FVector::Dist(GetGrapplePivot(), CornerLocal), 0.0) : 0.0;
+	UpdateCableWrapPoints();
+}
+
+void UGrappleMovementComponent::ClearWrapPoints()
+{
+	if (WrapPoints.Num() == 0)
+	{
+		return;
+	}
+	WrapPoints.Reset();
+	WrappedLength = 0.0;
+	UpdateCableWrapPoints();
+}
+
+void UGrappleMovementComponent::UpdateCableWrapPoints()
+{
+	if (!GrappleCharacterOwner)
+	{
+		return;
+	}
+
+	TArray<FVector, TInlineAllocator<8>> LocationsLocal;
+	for (const FGrappleSolver::FWrapPoint& WrapPointLocal : WrapPoints)
+	{
+		LocationsLocal.Add(WrapPointLocal.RopeLocation);
+	}
+	GrappleCharacterOwner->UpdateGrappleCableWrapPoints(LocationsLocal);
+}
+
+bool UGrappleMovementComponent::CheckGrappleArrival()
+{
+	const FVector LocationLocal = UpdatedComponent->GetComponentLocation();
+
+	if (!FGrappleSolver::HasArrived(LocationLocal, GrappleCharacterOwner->GetAttachLocation(), GrappleCharacterOwner->GetGrappleAcceptanceRadius()))
+	{
+		return true;
+	}
+
+	// Check if the player has arrived, and if so, are they low enough to the ground to drop to it
+	bool bGroundHitLocal = false;
+	{
+		GRAPPLE_SCOPE_CYCLE_COUNTER(ArrivalTrace);
+		GRAPPLE_INC_COUNTER(Traces, 1);
+		FHitResult HitResultLocal;
+		const FVector EndLocationLocal = LocationLocal - FVector(0.f, 0.f, GrappleCharacterOwner->GetGrappleAcceptedFallDistance());
+		FCollisionQueryParams QueryParamsLocal(SCENE_QUERY_STAT(GrappleArrivalGroundCheck), false, CharacterOwner);
+		bGroundHitLocal = GetWorld()->LineTraceSingleByChannel(HitResultLocal, LocationLocal, EndLocationLocal, ECollisionChannel::ECC_Visibility, QueryParamsLocal);
+	}
+	if (bGroundHitLocal)
+	{
+		GrappleCharacterOwner->BreakGrapple();
+		return false;
+	}
+
+	// no blocking hit, the character is too high to automatically disconnect
+	GrappleCharacterOwner->HandleGrappleArrived();
+	if (!IsFirstPersonMove())
+	{
+		// third person holds position at the attach location until the player jumps off
+		Velocity = FVector::ZeroVector;
+		SetMovementMode(MOVE_Flying);
+		return false;
+	}
+	return true;
+}
+
+bool UGrappleMovementComponent::IsFirstPersonMove() const
+{
+	// the camera is only switched on the owning client, the server learns it from the move
+	return IsServerForRemoteClient() || bClientUpdating ? bMoveFirstPerson : GrappleCharacterOwner->GetIsIfFirstPerson();
+}
+
+bool UGrappleMovementComponent::IsServerForRemoteClient() const
+{
+	return CharacterOwner && CharacterOwner->GetLocalRole() == ROLE_Authority && CharacterOwner->GetRemoteRole() == ROLE_AutonomousProxy && !CharacterOwner->IsLocallyControlled();
+}
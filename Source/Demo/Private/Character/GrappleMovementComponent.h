@@ -0,0 +1,284 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Grapple/GrappleSolver.h"
+#include "GrappleMovementComponent.generated.h"
+
+class AGrappleCharacter;
+
+/** Custom movement modes used by the grapple character (stored in CustomMovementMode when MovementMode is MOVE_Custom) */
+UENUM(BlueprintType)
+enum class ECustomMovementMode : uint8
+{
+	CMOVE_None		UMETA(Hidden),
+	CMOVE_Grapple	UMETA(DisplayName = "Grapple"),
+	CMOVE_MAX		UMETA(Hidden)
+};
+
+/** Move data sent to the server, adds the grapple anchor (only serialized when the move fires the grapple) */
+struct FGrappleNetworkMoveData : public FCharacterNetworkMoveData
+{
+	typedef FCharacterNetworkMoveData Super;
+
+	FVector_NetQuantize10 GrappleAnchor;
+
+	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+};
+
+struct FGrappleNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+{
+	FGrappleNetworkMoveDataContainer();
+
+	FGrappleNetworkMoveData GrappleDefaultMoveData[3];
+};
+
+/**
+ * Character movement component that runs the grapple (hook flight, pull, arrival check and break-off) inside the normal movement update.
+ * The hook flies while the character is still in its regular movement mode; once the hook is attached the character enters MOVE_Custom/CMOVE_Grapple
+ * and is pulled towards the attach location in substeps. Both phases are integrated analytically (exponential approach) so the result does not depend on the frame rate.
+ * The hook flight is evaluated from the time since it was fired and attaches at a time computed when firing, it runs no scene queries.
+ *
+ * While pulling, the rope wraps around corners between the character and the anchor. Only the span from the character to the nearest corner is traced
+ * (at most one trace per substep whatever the number of corners), the corners themselves are kept on a stack and the pull runs along the wrapped length.
+ *
+ * Grapple start, attach and release are carried in the saved move compressed flags (plus a quantized anchor in the move data) so the owning client
+ * predicts the whole grapple and the server replays it from the same inputs. The view mode rides along too, arrival holds differently in first person.
+ *
+ * Anchors on movable components are followed: the component (and its owner) is a tick prerequisite of this component, so its transform is read
+ * exactly once per frame, after it moved and before any grapple movement uses it.
+ */
+UCLASS()
+class UGrappleMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+	friend class FSavedMove_Grapple;
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	/********************************
+	* GRAPPLE SETTINGS
+	********************************/
+	/** Longest time a single grapple substep may cover. Frames longer than this are split so collision and arrival checks stay fine grained at low frame rates */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Settings", meta = (ClampMin = "0.001", UIMin = "0.001"))
+	float MaxGrappleSubstepTime{ 1.f / 120.f };
+	/** Upper bound on substeps per frame (frames longer than MaxGrappleSubsteps * MaxGrappleSubstepTime use longer substeps instead of more of them) */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Settings", meta = (ClampMin = "1", UIMin = "1"))
+	int32 MaxGrappleSubsteps{ 8 };
+	/** How close the hook must get to the attach location before it counts as attached */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Settings")
+	float HookAttachTolerance{ 10.f };
+
+	/********************************
+	* WRAPPING SETTINGS
+	********************************/
+	/** Wrap the rope around geometry between the character and the anchor while pulling. Off pulls in a straight line through anything in the way */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Wrapping")
+	bool bWrapAroundGeometry{ true };
+	/** Most corners the rope wraps around at once, further corners are ignored */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Wrapping", meta = (ClampMin = "0", UIMin = "0"))
+	int32 MaxWrapPoints{ 8 };
+	/** Corners are placed this far (on top of the capsule radius) off the surface the rope hit, so the capsule can reach them */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Wrapping", meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float WrapSurfaceOffset{ 5.f };
+
+	/********************************
+	* NETWORK SETTINGS
+	********************************/
+	/** Extra distance (on top of the grapple length) the server accepts between the character and a client requested anchor. Covers the third person camera sitting behind the character */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Network")
+	float ServerAnchorDistanceTolerance{ 500.f };
+	/** How far the server's own hook may still be from the anchor when the client reports the hook attached (hook start differs slightly between client and server as it comes from the animated gun) */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Network")
+	float ServerHookAttachTolerance{ 250.f };
+
+	/********************************
+	* GRAPPLE RUNTIME
+	********************************/
+	/** Current location of the hook (the end of the grapple cable) */
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "Grappling|Runtime")
+	FVector HookLocation{ 0.f };
+	/** Where the hook flight started */
+	FVector HookStartLocation{ 0.f };
+	/** Time the hook has been flying, and the flight time at which it attaches */
+	float HookFlightTime{ 0.f };
+	float HookAttachTime{ 0.f };
+
+	/** Corners the rope is wrapped around, from the anchor end to the character end (the last one is what the character is pulled towards) */
+	TArray<FGrappleSolver::FWrapPoint, TInlineAllocator<8>> WrapPoints;
+	/** Rope length from the last wrap point around the others to the anchor */
+	double WrappedLength{ 0.0 };
+
+	/** Cached grapple character that owns this component */
+	UPROPERTY(Transient, DuplicateTransient)
+	TObjectPtr<AGrappleCharacter> GrappleCharacterOwner;
+
+	/** Input: fire the grapple at RequestedGrappleAnchor on the next movement update (FLAG_Custom_0) */
+	uint8 bWantsToGrapple : 1;
+	/** Input: release the grapple on the next movement update, breaking off if arrived (FLAG_Custom_2) */
+	uint8 bWantsToReleaseGrapple : 1;
+	/** Server only: the client reported its hook as attached at the end of the move being processed (FLAG_Custom_1) */
+	uint8 bClientGrappleAttached : 1;
+	/** Remote client moves and client replays: the owner was in first person when the move was made, which decides how arrival holds (FLAG_Custom_3) */
+	uint8 bMoveFirstPerson : 1;
+	/** Substep cap from the owner's significance tier (0 = MaxGrappleSubsteps only) */
+	int32 GrappleSubstepLimit{ 0 };
+
+	/** Anchor sent with a grapple request (quantized to 0.1 cm when sent to the server) */
+	FVector RequestedGrappleAnchor{ 0.f };
+	/** Component the anchor sits on. Not sent: the server takes it from its own line of sight check */
+	TWeakObjectPtr<USceneComponent> RequestedGrappleAnchorComponent;
+
+	/** Move data container that carries the grapple anchor with client moves */
+	FGrappleNetworkMoveDataContainer GrappleNetworkMoveDataContainer;
+
+	/** Client only: corrections received from the server since spawning, and how many of them arrived with the grapple active */
+	int32 NumClientCorrections{ 0 };
+	int32 NumGrappleCorrections{ 0 };
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleMovementComponent();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual void SetUpdatedComponent(USceneComponent* NewUpdatedComponent) override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+
+protected:
+	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+	virtual void ServerMove_PerformMovement(const FCharacterNetworkMoveData& MoveData) override;
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+	virtual void UpdateCharacterStateAfterMovement(float DeltaSeconds) override;
+	virtual void PhysCustom(float deltaTime, int32 Iterations) override;
+	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
+	virtual void OnClientCorrectionReceived(FNetworkPredictionData_Client_Character& ClientData, float TimeStamp, FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase,
+		FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode) override;
+
+	/********************************
+	* MEMBER METHODS
+	********************************/
+public:
+	/** Asks to fire the grapple at Anchor, on AnchorComponent if it was hit. Applied (and predicted) on the next movement update */
+	void RequestGrapple(const FVector& Anchor, USceneComponent* AnchorComponent);
+	/** Asks to release the grapple. Applied on the next movement update: breaks off with the break off velocity if arrived, else just stops */
+	void RequestGrappleRelease();
+	/** Leaves the grapple movement mode (if active) so the character falls normally */
+	void EndGrapple();
+	/** Server only: picks up a grapple that was simulated elsewhere (e.g. a promoted Mass entity). The owner's grapple state must already be started */
+	void AdoptGrapple(const FVector& InHookLocation, bool bAttached, bool bArrived);
+	/** Caps the grapple substeps per frame below MaxGrappleSubsteps (0 removes the cap). AI controlled characters also draw them from the significance subsystem budget */
+	FORCEINLINE void SetGrappleSubstepLimit(int32 NewLimit) { GrappleSubstepLimit = FMath::Max(NewLimit, 0); }
+
+	UFUNCTION(BlueprintPure, Category = "Grappling|Getters")
+	FORCEINLINE bool IsGrappling() const { return MovementMode == MOVE_Custom && CustomMovementMode == static_cast<uint8>(ECustomMovementMode::CMOVE_Grapple); }
+	UFUNCTION(BlueprintPure, Category = "Grappling|Getters")
+	FORCEINLINE FVector GetHookLocation() const { return HookLocation; }
+	FORCEINLINE float GetHookAttachTolerance() const { return HookAttachTolerance; }
+	/** Point the character is pulled towards: the nearest wrapped corner, or the anchor */
+	UFUNCTION(BlueprintPure, Category = "Grappling|Getters")
+	FVector GetGrapplePivot() const;
+	/** Length of the rope from the character around the wrapped corners to the anchor */
+	UFUNCTION(BlueprintPure, Category = "Grappling|Getters")
+	float GetGrappleRopeLength() const;
+	UFUNCTION(BlueprintPure, Category = "Grappling|Getters")
+	FORCEINLINE int32 GetNumWrapPoints() const { return WrapPoints.Num(); }
+	FORCEINLINE int32 GetNumClientCorrections() const { return NumClientCorrections; }
+	FORCEINLINE int32 GetNumGrappleCorrections() const { return NumGrappleCorrections; }
+	/** View mode the current move runs with: the one sent with the move on the server and when replaying, the owner's camera for a new local move */
+	bool IsFirstPersonMove() const;
+
+protected:
+	/** Starts the hook flight towards the owner's attach location. The character keeps its current movement mode until the hook attaches */
+	void BeginGrapple();
+	/** Server side sanity check of a client requested anchor: in range, in line of sight and on a grapplable surface. Also finds the component it sits on */
+	bool IsValidGrappleAnchor(const FVector& Anchor, USceneComponent*& OutAnchorComponent) const;
+	/** Starts a hook flight from Start towards the owner's attach location */
+	void LaunchHook(const FVector& Start);
+	/** Advances the hook flight, attaches the hook once the flight time reaches the attach time */
+	void UpdateHookFlight(float DeltaSeconds);
+	/** Attaches the hook and switches to the grapple movement mode */
+	void AttachHook();
+	/** Pulls the character towards the attach location (MOVE_Custom/CMOVE_Grapple) */
+	void PhysGrapple(float deltaTime, int32 Iterations);
+	/** Wraps the rope around a new corner or unwraps the last one. One trace at most: the span to the last corner, or past it once the character reached it */
+	void UpdateRopeWrap();
+	/** Wraps around the surface hit by a wrap trace from Location */
+	void PushWrapPoint(const FVector& ImpactPoint, const FVector& ImpactNormal, const FVector& Location);
+	void PopWrapPoint();
+	void ClearWrapPoints();
+	/** Hands the wrapped corners to the owner's cable */
+	void UpdateCableWrapPoints();
+	/** Arrival check run after every pull substep. Returns false if the grapple state changed and the rest of the frame should use the new movement mode */
+	bool CheckGrappleArrival();
+	/** True when processing moves sent by a remote autonomous client */
+	bool IsServerForRemoteClient() const;
+};
+
+/** Saved move with the grapple inputs and the grapple state at the start of the move (restored when replaying after a correction) */
+class FSavedMove_Grapple : public FSavedMove_Character
+{
+public:
+	typedef FSavedMove_Character Super;
+
+	/** Grapple inputs */
+	uint8 bSavedWantsToGrapple : 1;
+	uint8 bSavedWantsToReleaseGrapple : 1;
+	/** Hook attached at the end of the move (filled in PostUpdate) */
+	uint8 bSavedGrappleAttachedAfterMove : 1;
+	/** Owner in first person when the move was made */
+	uint8 bSavedFirstPerson : 1;
+	FVector SavedGrappleAnchor{ 0.f };
+	TWeakObjectPtr<USceneComponent> SavedGrappleAnchorComponent;
+
+	/** Grapple state at the start of the move */
+	uint8 bSavedStartGrappleActive : 1;
+	uint8 bSavedStartGrappleAttached : 1;
+	uint8 bSavedStartArrived : 1;
+	FVector SavedStartAttachLocation{ 0.f };
+	TWeakObjectPtr<USceneComponent> SavedStartAnchorComponent;
+	FVector SavedStartAnchorLocalOffset{ 0.f };
+	FVector SavedStartHookLocation{ 0.f };
+	FVector SavedStartHookStartLocation{ 0.f };
+	float SavedStartHookFlightTime{ 0.f };
+	float SavedStartHookAttachTime{ 0.f };
+	TArray<FGrappleSolver::FWrapPoint, TInlineAllocator<8>> SavedStartWrapPoints;
+	double SavedStartWrappedLength{ 0.0 };
+
+	FSavedMove_Grapple();
+
+	virtual void Clear() override;
+	virtual uint8 GetCompressedFlags() const override;
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+	virtual void SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) override;
+	virtual void PostUpdate(ACharacter* C, EPostUpdateMode PostUpdateMode) override;
+	virtual void PrepMoveFor(ACharacter* C) override;
+	virtual void CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC, const FVector& OldStartLocation) override;
+
+	/** Puts the grapple back to its state at the start of the move */
+	void RestoreStartState(AGrappleCharacter* GrappleCharacter) const;
+};
+
+class FNetworkPredictionData_Client_Grapple : public FNetworkPredictionData_Client_Character
+{
+public:
+	typedef FNetworkPredictionData_Client_Character Super;
+
+	FNetworkPredictionData_Client_Grapple(const UCharacterMovementComponent& ClientMovement);
+
+	virtual FSavedMovePtr AllocateNewMove() override;
+};
@@ -0,0 +1,79 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "GrappleTypes.generated.h"
+
+/** Grapple states packed into FGrappleRepState::StateFlags */
+enum class EGrappleStateFlags : uint8
+{
+	None		= 0,
+	Active		= 1 << 0,
+	Attached	= 1 << 1,
+	Arrived		= 1 << 2,
+};
+ENUM_CLASS_FLAGS(EGrappleStateFlags);
+
+/**
+ * Cosmetic grapple state replicated to simulated proxies (the owning client predicts its own grapple through the movement component).
+ * Only sent when a grapple state changes: proxies rebuild the hook flight locally from the server fire time instead of receiving hook positions.
+ */
+USTRUCT()
+struct FGrappleRepState
+{
+	GENERATED_BODY()
+
+	/** Where the grapple is attached (0.1 cm precision is plenty for a cable end). Relative to AnchorComponent when there is one */
+	UPROPERTY()
+	FVector_NetQuantize10 Anchor{ 0.f };
+	/** Movable component the grapple is attached to, only set if it can be referenced over the network */
+	UPROPERTY()
+	TWeakObjectPtr<USceneComponent> AnchorComponent;
+	/** EGrappleStateFlags bits */
+	UPROPERTY()
+	uint8 StateFlags{ 0 };
+	/** Server world time the grapple was fired at, used by proxies to place the hook along its flight */
+	UPROPERTY()
+	float ServerFireTime{ 0.f };
+
+	FORCEINLINE bool HasFlag(EGrappleStateFlags Flag) const { return (StateFlags & static_cast<uint8>(Flag)) != 0; }
+
+	FORCEINLINE bool operator==(const FGrappleRepState& Other) const
+	{
+		return StateFlags == Other.StateFlags && ServerFireTime == Other.ServerFireTime && Anchor == Other.Anchor && AnchorComponent == Other.AnchorComponent;
+	}
+	FORCEINLINE bool operator!=(const FGrappleRepState& Other) const { return !(*this == Other); }
+};
+
+/** Significance tiers of a grapple character (see UGrappleSignificanceSubsystem), higher tiers are updated more often and in more detail */
+UENUM(BlueprintType)
+enum class EGrappleSignificance : uint8
+{
+	Off,
+	Low,
+	Medium,
+	High,
+	MAX UMETA(Hidden)
+};
+
+/** How much work a grapple character does at one significance tier */
+USTRUCT(BlueprintType)
+struct FGrappleSignificanceSettings
+{
+	GENERATED_BODY()
+
+	/** Actor tick interval (0 = every frame) */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Significance", meta = (ClampMin = "0.0"))
+	float TickInterval{ 0.f };
+	/** Tick interval of the character mesh, i.e. the animation update rate (0 = every frame) */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Significance", meta = (ClampMin = "0.0"))
+	float AnimationTickInterval{ 0.f };
+	/** Skip the animation update entirely while the mesh isn't rendered */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Significance")
+	bool bOnlyAnimateWhenRendered{ false };
+	/** Grapple movement substep cap. Only applied to AI controlled characters, players must run the substeps their client predicted with */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Significance", meta = (ClampMin = "1"))
+	int32 MaxGrappleSubsteps{ 8 };
+};
@@ -0,0 +1,129 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleViewComponent.h"
+#include "GrappleCharacter.h"
+#include "Blueprint/UserWidget.h"
+#include "GameFramework/PlayerController.h"
+#include "UObject/ConstructorHelpers.h"
+
+namespace GrappleView
+{
+	const FName GripSocketName(TEXT("GripPoint"));
+}
+
+UGrappleViewComponent::UGrappleViewComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	// the crosshair the character Blueprint used to create itself, Blueprints can still swap it
+	static ConstructorHelpers::FClassFinder<UUserWidget> AimingWidgetClassLocal(TEXT("/Game/Core/Widgets/WBP_AimingWidget"));
+	if (AimingWidgetClassLocal.Succeeded())
+	{
+		AimingWidgetClass = AimingWidgetClassLocal.Class;
+	}
+}
+
+void UGrappleViewComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (AimingWidget)
+	{
+		AimingWidget->RemoveFromParent();
+		AimingWidget = nullptr;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UGrappleViewComponent::SetFirstPerson(bool bNewFirstPerson)
+{
+	AGrappleCharacter* CharacterLocal = Cast<AGrappleCharacter>(GetOwner());
+	if (bNewFirstPerson == bFirstPerson || !CharacterLocal)
+	{
+		return;
+	}
+	// the cameras and arms are only registered for the player that looks through them (and don't exist on a dedicated server)
+	CharacterLocal->RegisterViewComponents();
+	if (!CharacterLocal->GetFirstPersonMesh() || !CharacterLocal->GetThirdPersonCamera() || !CharacterLocal->GetFirstPersonCamera())
+	{
+		return;
+	}
+	bFirstPerson = bNewFirstPerson;
+
+	USkeletalMeshComponent* BodyLocal = CharacterLocal->GetMesh();
+	USkeletalMeshComponent* ArmsLocal = CharacterLocal->GetFirstPersonMesh();
+	CharacterLocal->GetThirdPersonCamera()->SetActive(!bFirstPerson);
+	CharacterLocal->GetFirstPersonCamera()->SetActive(bFirstPerson);
+
+	// arms only exist in first person
+	ArmsLocal->SetVisibility(bFirstPerson);
+	SetMeshAnimated(ArmsLocal, bFirstPerson);
+
+	if (bFirstPerson && bBodyShadowInFirstPerson)
+	{
+		// out of the main pass but still casting its shadow, which doesn't need the full animation rate
+		BodyTickInterval = BodyLocal->PrimaryComponentTick.TickInterval;
+		BodyLocal->SetRenderInMainPass(false);
+		BodyLocal->SetComponentTickInterval(FMath::Max(BodyTickInterval, ShadowAnimationTickInterval));
+	}
+	else if (bFirstPerson)
+	{
+		BodyLocal->SetVisibility(false);
+		SetMeshAnimated(BodyLocal, false);
+	}
+	else
+	{
+		if (bBodyShadowInFirstPerson)
+		{
+			BodyLocal->SetRenderInMainPass(true);
+			BodyLocal->SetComponentTickInterval(BodyTickInterval);
+		}
+		BodyLocal->SetVisibility(true);
+		SetMeshAnimated(BodyLocal, true);
+	}
+
+	// only reattach when the gun really changes mesh
+	USkeletalMeshComponent* GunParentLocal = bFirstPerson ? ArmsLocal : BodyLocal;
+	USkeletalMeshComponent* GunLocal = CharacterLocal->GetGrappleGun();
+	if (GunLocal->GetAttachParent() != GunParentLocal || GunLocal->GetAttachSocketName() != GrappleView::GripSocketName)
+	{
+		GunLocal->AttachToComponent(GunParentLocal, FAttachmentTransformRules(EAttachmentRule::SnapToTarget, true), GrappleView::GripSocketName);
+	}
+}
+
+bool UGrappleViewComponent::ShowAimingWidget(bool bShow)
+{
+	if (!AimingWidgetClass)
+	{
+		return false;
+	}
+
+	if (!AimingWidget && bShow)
+	{
+		const APawn* PawnLocal = Cast<APawn>(GetOwner());
+		APlayerController* PlayerControllerLocal = PawnLocal ? Cast<APlayerController>(PawnLocal->GetController()) : nullptr;
+		if (!PlayerControllerLocal || !PlayerControllerLocal->IsLocalController())
+		{
+			return true;
+		}
+		// created and added once, later switches only change its visibility
+		AimingWidget = CreateWidget<UUserWidget>(PlayerControllerLocal, AimingWidgetClass);
+		if (AimingWidget)
+		{
+			AimingWidget->AddToViewport();
+		}
+	}
+
+	if (AimingWidget)
+	{
+		AimingWidget->SetVisibility(bShow ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+	}
+	return true;
+}
+
+void UGrappleViewComponent::SetMeshAnimated(USkeletalMeshComponent* Mesh, bool bAnimated)
+{
+	// the mesh tick drives its anim instance update and bone refresh, nothing else runs while it is off
+	Mesh->SetComponentTickEnabled(bAnimated);
+	Mesh->bNoSkeletonUpdate = !bAnimated;
+}
@@ -0,0 +1,81 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GrappleViewComponent.generated.h"
+
+class UUserWidget;
+class USkeletalMeshComponent;
+
+/**
+ * First/third person view state of a grapple character. The mesh that isn't seen stops ticking and animating: the first person arms outside
+ * of first person (always, so other players' characters never animate them), the third person body in first person unless it is kept for its
+ * shadow, in which case it only renders in the shadow pass at a lower animation rate. The gun only moves between meshes when the view actually
+ * changes, and the aiming widget is created once and shown/hidden afterwards.
+ */
+UCLASS(ClassGroup = (Grapple))
+class UGrappleViewComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	/********************************
+	* VIEW SETTINGS
+	********************************/
+	/** Keep the third person body casting its shadow in first person (shadow pass only). Off hides it and stops its animation entirely */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "View")
+	bool bBodyShadowInFirstPerson{ true };
+	/** Animation tick interval of the shadow-only body (the body's own interval is kept if longer) */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "View", meta = (ClampMin = "0.0", EditCondition = "bBodyShadowInFirstPerson"))
+	float ShadowAnimationTickInterval{ 1.f / 30.f };
+	/** First person aiming widget (WBP_AimingWidget by default), created once for the local player. Clearing it leaves the widget to AddAimingWidget/RemoveAimingWidget on the character */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "View")
+	TSubclassOf<UUserWidget> AimingWidgetClass;
+
+	/********************************
+	* VIEW RUNTIME
+	********************************/
+	UPROPERTY(Transient)
+	TObjectPtr<UUserWidget> AimingWidget;
+	/** Body tick interval before it went shadow-only, restored when back in third person */
+	float BodyTickInterval{ 0.f };
+	bool bFirstPerson{ false };
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleViewComponent();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/********************************
+	* MEMBER METHODS
+	********************************/
+public:
+	/** Switches cameras, meshes, gun attachment and aiming widget to the view. Does nothing if already in it */
+	void SetFirstPerson(bool bNewFirstPerson);
+	/** Shows or hides the pooled aiming widget. Returns false if there is no widget class (the character's blueprint events handle the widget) */
+	bool ShowAimingWidget(bool bShow);
+
+	UFUNCTION(BlueprintPure, Category = "View|Getters")
+	FORCEINLINE bool IsFirstPerson() const { return bFirstPerson; }
+	UFUNCTION(BlueprintPure, Category = "View|Getters")
+	FORCEINLINE UUserWidget* GetAimingWidget() const { return AimingWidget; }
+
+protected:
+	/** Turns a mesh's tick (and with it its animation) on or off */
+	static void SetMeshAnimated(USkeletalMeshComponent* Mesh, bool bAnimated);
+};
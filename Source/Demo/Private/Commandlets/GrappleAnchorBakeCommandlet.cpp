@@ -0,0 +1,409 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleAnchorBakeCommandlet.h"
+#include "GrappleCommandletUtils.h"
+#include "Character/GrappleCharacter.h"
+#include "Grapple/GrappleAnchorCellActor.h"
+#include "Grapple/GrappleAnchorSubsystem.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Rendering/StaticMeshVertexBuffer.h"
+#include "StaticMeshResources.h"
+#include "UObject/SavePackage.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#if WITH_EDITOR
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+#include "WorldPartition/WorldPartitionActorDesc.h"
+#include "WorldPartition/WorldPartitionHandle.h"
+#endif
+#include "Demo.h"
+
+namespace GrappleAnchorBake
+{
+	/** What one cell costs on disk and to stream in */
+	struct FCellReport
+	{
+		FIntVector Key{ 0, 0, 0 };
+		int32 NumAnchors{ 0 };
+		int32 Bytes{ 0 };
+		/** Medians over the load runs, in microseconds */
+		float DecodeUs{ 0.f };
+		float RegisterUs{ 0.f };
+	};
+}
+
+UGrappleAnchorBakeCommandlet::UGrappleAnchorBakeCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGrappleAnchorBakeCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString MapNameLocal;
+	if (!FParse::Value(*Params, TEXT("Map="), MapNameLocal))
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleAnchorBake: missing -Map=<long package name>"));
+		return 1;
+	}
+	FParse::Value(*Params, TEXT("CellSize="), CellSize);
+	FParse::Value(*Params, TEXT("Spacing="), Spacing);
+	CellSize = FMath::Max(CellSize, 100.f);
+	Spacing = FMath::Max(Spacing, 10.f);
+	// cells must fit the int16 quantization of the cell actor
+	CellSize = FMath::Min(CellSize, MAX_int16 * AGrappleAnchorCellActor::PositionQuantum * 2.f);
+	const bool bNoSaveLocal = FParse::Param(*Params, TEXT("NoSave"));
+	int32 NumLoadRunsLocal = 20;
+	FString ReportLocal;
+	FParse::Value(*Params, TEXT("LoadRuns="), NumLoadRunsLocal);
+	FParse::Value(*Params, TEXT("Report="), ReportLocal);
+	NumLoadRunsLocal = FMath::Max(NumLoadRunsLocal, 1);
+	if (ReportLocal.IsEmpty())
+	{
+		ReportLocal = FPaths::ProfilingDir() / TEXT("GrappleAnchorBake") / FString::Printf(TEXT("GrappleAnchorBake_%s_%s"), *FPackageName::GetShortName(MapNameLocal), *FDateTime::Now().ToString());
+	}
+
+	// grapplable object types come from the character (blueprint defaults if one is given)
+	FString CharacterClassNameLocal;
+	TSubclassOf<AGrappleCharacter> CharacterClassLocal = AGrappleCharacter::StaticClass();
+	if (FParse::Value(*Params, TEXT("Character="), CharacterClassNameLocal))
+	{
+		if (UClass* LoadedClassLocal = GrappleCommandletUtils::LoadCharacterClass(CharacterClassNameLocal))
+		{
+			CharacterClassLocal = LoadedClassLocal;
+		}
+	}
+	TArray<ECollisionChannel> ChannelsLocal;
+	for (const TEnumAsByte<EObjectTypeQuery>& ObjectTypeLocal : CharacterClassLocal->GetDefaultObject<AGrappleCharacter>()->GetGrapplableTargets())
+	{
+		ChannelsLocal.AddUnique(UEngineTypes::ConvertToCollisionChannel(ObjectTypeLocal));
+	}
+
+	UPackage* MapPackageLocal = LoadPackage(nullptr, *MapNameLocal, LOAD_None);
+	UWorld* WorldLocal = MapPackageLocal ? UWorld::FindWorldInPackage(MapPackageLocal) : nullptr;
+	if (!WorldLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleAnchorBake: can't load map %s"), *MapNameLocal);
+		return 1;
+	}
+
+	WorldLocal->WorldType = EWorldType::Editor;
+	WorldLocal->AddToRoot();
+	if (!WorldLocal->bIsWorldInitialized)
+	{
+		UWorld::InitializationValues InitValuesLocal;
+		InitValuesLocal.RequiresHitProxies(false);
+		InitValuesLocal.ShouldSimulatePhysics(false);
+		InitValuesLocal.EnableTraceCollision(false);
+		InitValuesLocal.CreateNavigation(false);
+		InitValuesLocal.CreateAISystem(false);
+		InitValuesLocal.AllowAudioPlayback(false);
+		InitValuesLocal.CreatePhysicsScene(true);
+		WorldLocal->InitWorld(InitValuesLocal);
+		WorldLocal->PersistentLevel->UpdateModelComponents();
+		WorldLocal->UpdateWorldComponents(true, false);
+	}
+
+	UWorldPartition* WorldPartitionLocal = WorldLocal->GetWorldPartition();
+	if (!WorldPartitionLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleAnchorBake: %s is not a World Partition map"), *MapNameLocal);
+		WorldLocal->RemoveFromRoot();
+		return 1;
+	}
+
+	const double BakeStartTimeLocal = FPlatformTime::Seconds();
+
+	// sample every grapplable static mesh, actors are loaded in batches
+	TMap<FIntVector, FBakedAnchor> VoxelsLocal;
+	TMap<FIntVector, FGuid> ExistingCellsLocal;
+	int32 NumComponentsLocal = 0;
+	FWorldPartitionHelpers::ForEachActorWithLoading(WorldPartitionLocal, AActor::StaticClass(), [this, &VoxelsLocal, &ExistingCellsLocal, &ChannelsLocal, &NumComponentsLocal](const FWorldPartitionActorDesc* ActorDesc)
+	{
+		const AActor* ActorLocal = ActorDesc->GetActor();
+		if (!ActorLocal)
+		{
+			return true;
+		}
+
+		if (ActorLocal->IsA<AGrappleAnchorCellActor>())
+		{
+			ExistingCellsLocal.Add(GetCellKey(ActorLocal->GetActorLocation()), ActorDesc->GetGuid());
+			return true;
+		}
+
+		TInlineComponentArray<UStaticMeshComponent*> ComponentsLocal(ActorLocal);
+		for (const UStaticMeshComponent* ComponentLocal : ComponentsLocal)
+		{
+			// movable geometry isn't baked, it needs a UGrappleAnchorComponent
+			if (ComponentLocal->Mobility == EComponentMobility::Movable || !ComponentLocal->IsQueryCollisionEnabled() || !ChannelsLocal.Contains(ComponentLocal->GetCollisionObjectType()))
+			{
+				continue;
+			}
+			SampleComponent(ComponentLocal, VoxelsLocal);
+			++NumComponentsLocal;
+		}
+		return true;
+	});
+
+	// bucket the anchors per cell
+	TMap<FIntVector, TArray<FBakedAnchor>> CellsLocal;
+	for (const TPair<FIntVector, FBakedAnchor>& VoxelLocal : VoxelsLocal)
+	{
+		CellsLocal.FindOrAdd(GetCellKey(VoxelLocal.Value.Location)).Add(VoxelLocal.Value);
+	}
+
+	// keeps reused cell actors loaded until they are saved
+	TArray<FWorldPartitionReference> CellReferencesLocal;
+	TArray<UPackage*> PackagesToSaveLocal;
+	TArray<FString> FilesToDeleteLocal;
+	TArray<const AGrappleAnchorCellActor*> CellActorsLocal;
+	TArray<GrappleAnchorBake::FCellReport> CellReportsLocal;
+	int64 TotalBytesLocal = 0;
+	for (TPair<FIntVector, TArray<FBakedAnchor>>& CellLocal : CellsLocal)
+	{
+		const FVector CellCenterLocal = GetCellCenter(CellLocal.Key);
+
+		// reuse the cell actor of a previous bake so only changed packages churn
+		AGrappleAnchorCellActor* CellActorLocal = nullptr;
+		FGuid ExistingGuidLocal;
+		if (ExistingCellsLocal.RemoveAndCopyValue(CellLocal.Key, ExistingGuidLocal))
+		{
+			const FWorldPartitionReference& ReferenceLocal = CellReferencesLocal.Emplace_GetRef(WorldPartitionLocal, ExistingGuidLocal);
+			CellActorLocal = Cast<AGrappleAnchorCellActor>(ReferenceLocal.IsValid() ? ReferenceLocal->GetActor() : nullptr);
+		}
+		if (!CellActorLocal)
+		{
+			FActorSpawnParameters SpawnParametersLocal;
+			SpawnParametersLocal.Name = MakeUniqueObjectName(WorldLocal->PersistentLevel, AGrappleAnchorCellActor::StaticClass(), *FString::Printf(TEXT("GrappleAnchors_%d_%d_%d"), CellLocal.Key.X, CellLocal.Key.Y, CellLocal.Key.Z));
+			CellActorLocal = WorldLocal->SpawnActor<AGrappleAnchorCellActor>(CellCenterLocal, FRotator::ZeroRotator, SpawnParametersLocal);
+			CellActorLocal->SetActorLabel(SpawnParametersLocal.Name.ToString());
+			CellActorLocal->SetFolderPath(TEXT("GrappleAnchors"));
+		}
+		CellActorLocal->SetActorLocation(CellCenterLocal);
+
+		TArray<FVector> LocationsLocal;
+		TArray<FVector> NormalsLocal;
+		LocationsLocal.Reserve(CellLocal.Value.Num());
+		NormalsLocal.Reserve(CellLocal.Value.Num());
+		for (const FBakedAnchor& AnchorLocal : CellLocal.Value)
+		{
+			LocationsLocal.Add(AnchorLocal.Location);
+			NormalsLocal.Add(AnchorLocal.Normal);
+		}
+		// stored in tree leaf order, the runtime only cuts the arrays into runs
+		UGrappleAnchorSubsystem::SortAnchorBlock(LocationsLocal, NormalsLocal);
+		CellActorLocal->Modify();
+		CellActorLocal->SetBakedAnchors(LocationsLocal, NormalsLocal);
+		PackagesToSaveLocal.Add(CellActorLocal->GetExternalPackage());
+
+		CellActorsLocal.Add(CellActorLocal);
+		GrappleAnchorBake::FCellReport& CellReportLocal = CellReportsLocal.AddDefaulted_GetRef();
+		CellReportLocal.Key = CellLocal.Key;
+		CellReportLocal.NumAnchors = CellActorLocal->GetNumAnchors();
+		CellReportLocal.Bytes = CellActorLocal->GetBakedDataSize();
+		TotalBytesLocal += CellReportLocal.Bytes;
+	}
+
+	// cells that no longer have anchors
+	for (const TPair<FIntVector, FGuid>& StaleCellLocal : ExistingCellsLocal)
+	{
+		FWorldPartitionReference ReferenceLocal(WorldPartitionLocal, StaleCellLocal.Value);
+		if (AActor* ActorLocal = ReferenceLocal.IsValid() ? ReferenceLocal->GetActor() : nullptr)
+		{
+			if (UPackage* PackageLocal = ActorLocal->GetExternalPackage())
+			{
+				FilesToDeleteLocal.Add(FPackageName::LongPackageNameToFilename(PackageLocal->GetName(), FPackageName::GetAssetPackageExtension()));
+			}
+			WorldLocal->EditorDestroyActor(ActorLocal, false);
+		}
+	}
+
+	const double BakeTimeLocal = FPlatformTime::Seconds() - BakeStartTimeLocal;
+
+	// load cost as AGrappleAnchorCellActor::BeginPlay pays it when the cells stream in: the decode, then the block registered with the cells
+	// before it already in. The whole map streams in LoadRuns times, the medians keep one slow run out
+	{
+		TArray<TArray<float>> DecodeUsLocal;
+		TArray<TArray<float>> RegisterUsLocal;
+		DecodeUsLocal.SetNum(CellActorsLocal.Num());
+		RegisterUsLocal.SetNum(CellActorsLocal.Num());
+		const FGrappleHeadlessWorld HeadlessWorldLocal;
+		UGrappleAnchorSubsystem* AnchorSubsystemLocal = HeadlessWorldLocal.Get()->GetSubsystem<UGrappleAnchorSubsystem>();
+		for (int32 RunLocal = 0; AnchorSubsystemLocal && RunLocal < NumLoadRunsLocal; ++RunLocal)
+		{
+			TArray<int32> BlockIdsLocal;
+			BlockIdsLocal.Reserve(CellActorsLocal.Num());
+			for (int32 IndexLocal = 0; IndexLocal < CellActorsLocal.Num(); ++IndexLocal)
+			{
+				TArray<FVector> LocationsLocal;
+				TArray<FVector> NormalsLocal;
+				const double DecodeStartTimeLocal = FPlatformTime::Seconds();
+				CellActorsLocal[IndexLocal]->DecodeAnchors(LocationsLocal, NormalsLocal);
+				const double RegisterStartTimeLocal = FPlatformTime::Seconds();
+				BlockIdsLocal.Add(AnchorSubsystemLocal->RegisterAnchorBlock(MoveTemp(LocationsLocal), MoveTemp(NormalsLocal)));
+				const double EndTimeLocal = FPlatformTime::Seconds();
+				DecodeUsLocal[IndexLocal].Add(static_cast<float>((RegisterStartTimeLocal - DecodeStartTimeLocal) * 1000000.0));
+				RegisterUsLocal[IndexLocal].Add(static_cast<float>((EndTimeLocal - RegisterStartTimeLocal) * 1000000.0));
+			}
+			for (const int32 BlockIdLocal : BlockIdsLocal)
+			{
+				AnchorSubsystemLocal->UnregisterAnchorBlock(BlockIdLocal);
+			}
+		}
+		for (int32 IndexLocal = 0; AnchorSubsystemLocal && IndexLocal < CellReportsLocal.Num(); ++IndexLocal)
+		{
+			DecodeUsLocal[IndexLocal].Sort();
+			RegisterUsLocal[IndexLocal].Sort();
+			CellReportsLocal[IndexLocal].DecodeUs = GrappleCommandletUtils::GetPercentile(DecodeUsLocal[IndexLocal], 0.5);
+			CellReportsLocal[IndexLocal].RegisterUs = GrappleCommandletUtils::GetPercentile(RegisterUsLocal[IndexLocal], 0.5);
+		}
+	}
+
+	double TotalDecodeUsLocal = 0.0;
+	double TotalRegisterUsLocal = 0.0;
+	int32 MaxBytesLocal = 0;
+	float MaxLoadUsLocal = 0.f;
+	FString CellsJsonLocal;
+	for (const GrappleAnchorBake::FCellReport& CellReportLocal : CellReportsLocal)
+	{
+		UE_LOG(LogGrapple, Display, TEXT("GrappleAnchorBake: cell (%d, %d, %d) %d anchors, %d bytes, decode %.1f us, register %.1f us"), CellReportLocal.Key.X, CellReportLocal.Key.Y, CellReportLocal.Key.Z,
+			CellReportLocal.NumAnchors, CellReportLocal.Bytes, CellReportLocal.DecodeUs, CellReportLocal.RegisterUs);
+		TotalDecodeUsLocal += CellReportLocal.DecodeUs;
+		TotalRegisterUsLocal += CellReportLocal.RegisterUs;
+		MaxBytesLocal = FMath::Max(MaxBytesLocal, CellReportLocal.Bytes);
+		MaxLoadUsLocal = FMath::Max(MaxLoadUsLocal, CellReportLocal.DecodeUs + CellReportLocal.RegisterUs);
+		CellsJsonLocal += FString::Printf(TEXT("%s\t\t{ \"cell\": [%d, %d, %d], \"anchors\": %d, \"bytes\": %d, \"decodeUs\": %.2f, \"registerUs\": %.2f }"), CellsJsonLocal.IsEmpty() ? TEXT("") : TEXT(",\n"),
+			CellReportLocal.Key.X, CellReportLocal.Key.Y, CellReportLocal.Key.Z, CellReportLocal.NumAnchors, CellReportLocal.Bytes, CellReportLocal.DecodeUs, CellReportLocal.RegisterUs);
+	}
+	const int32 NumCellsLocal = CellReportsLocal.Num();
+	const double BytesPerCellLocal = NumCellsLocal > 0 ? static_cast<double>(TotalBytesLocal) / NumCellsLocal : 0.0;
+	const double NsPerAnchorLocal = VoxelsLocal.Num() > 0 ? (TotalDecodeUsLocal + TotalRegisterUsLocal) * 1000.0 / VoxelsLocal.Num() : 0.0;
+	UE_LOG(LogGrapple, Display, TEXT("GrappleAnchorBake: %s, %d components, %d anchors in %d cells (%d removed), bake %.2f s"),
+		*MapNameLocal, NumComponentsLocal, VoxelsLocal.Num(), NumCellsLocal, ExistingCellsLocal.Num(), BakeTimeLocal);
+	UE_LOG(LogGrapple, Display, TEXT("GrappleAnchorBake: %lld bytes, %.1f bytes per cell (max %d), load %.3f ms for the map (decode %.3f, register %.3f), max %.1f us per cell, %.1f ns per anchor"),
+		TotalBytesLocal, BytesPerCellLocal, MaxBytesLocal, (TotalDecodeUsLocal + TotalRegisterUsLocal) / 1000.0, TotalDecodeUsLocal / 1000.0, TotalRegisterUsLocal / 1000.0, MaxLoadUsLocal, NsPerAnchorLocal);
+
+	double SaveTimeLocal = 0.0;
+	if (!bNoSaveLocal)
+	{
+		const double SaveStartTimeLocal = FPlatformTime::Seconds();
+		for (UPackage* PackageLocal : PackagesToSaveLocal)
+		{
+			if (!PackageLocal)
+			{
+				continue;
+			}
+			const FString FilenameLocal = FPackageName::LongPackageNameToFilename(PackageLocal->GetName(), FPackageName::GetAssetPackageExtension());
+			FSavePackageArgs SaveArgsLocal;
+			SaveArgsLocal.TopLevelFlags = RF_Standalone;
+			if (!UPackage::SavePackage(PackageLocal, nullptr, *FilenameLocal, SaveArgsLocal))
+			{
+				UE_LOG(LogGrapple, Error, TEXT("GrappleAnchorBake: failed to save %s"), *FilenameLocal);
+			}
+		}
+		for (const FString& FilenameLocal : FilesToDeleteLocal)
+		{
+			IFileManager::Get().Delete(*FilenameLocal, false, true);
+		}
+		SaveTimeLocal = FPlatformTime::Seconds() - SaveStartTimeLocal;
+	}
+
+	FString JsonLocal;
+	JsonLocal += TEXT("{\n");
+	JsonLocal += FString::Printf(TEXT("\t\"map\": \"%s\",\n\t\"cellSize\": %.0f,\n\t\"spacing\": %.0f,\n\t\"components\": %d,\n\t\"anchors\": %d,\n\t\"cells\": %d,\n"),
+		*MapNameLocal, CellSize, Spacing, NumComponentsLocal, VoxelsLocal.Num(), NumCellsLocal);
+	JsonLocal += FString::Printf(TEXT("\t\"bakeSeconds\": %.3f,\n\t\"saveSeconds\": %.3f,\n\t\"bytes\": %lld,\n\t\"bytesPerCell\": %.1f,\n\t\"maxBytesPerCell\": %d,\n"),
+		BakeTimeLocal, SaveTimeLocal, TotalBytesLocal, BytesPerCellLocal, MaxBytesLocal);
+	JsonLocal += FString::Printf(TEXT("\t\"loadRuns\": %d,\n\t\"loadMs\": { \"decode\": %.4f, \"register\": %.4f, \"maxCellUs\": %.2f, \"nsPerAnchor\": %.2f },\n"),
+		NumLoadRunsLocal, TotalDecodeUsLocal / 1000.0, TotalRegisterUsLocal / 1000.0, MaxLoadUsLocal, NsPerAnchorLocal);
+	JsonLocal += FString::Printf(TEXT("\t\"perCell\": [\n%s\n\t]\n}\n"), *CellsJsonLocal);
+	if (FFileHelper::SaveStringToFile(JsonLocal, *(ReportLocal + TEXT(".json"))))
+	{
+		UE_LOG(LogGrapple, Display, TEXT("GrappleAnchorBake: report written to %s.json"), *ReportLocal);
+	}
+	else
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleAnchorBake: can't write the report to %s"), *ReportLocal);
+	}
+
+	CellReferencesLocal.Empty();
+	WorldLocal->RemoveFromRoot();
+	return 0;
+#else
+	return 1;
+#endif
+}
+
+void UGrappleAnchorBakeCommandlet::SampleComponent(const UStaticMeshComponent* Component, TMap<FIntVector, FBakedAnchor>& Voxels) const
+{
+	const UStaticMesh* MeshLocal = Component->GetStaticMesh();
+	const FStaticMeshRenderData* RenderDataLocal = MeshLocal ? MeshLocal->GetRenderData() : nullptr;
+	if (!RenderDataLocal || RenderDataLocal->LODResources.Num() == 0)
+	{
+		return;
+	}
+
+	const FStaticMeshLODResources& LODLocal = RenderDataLocal->LODResources[0];
+	const FPositionVertexBuffer& PositionsLocal = LODLocal.VertexBuffers.PositionVertexBuffer;
+	const FIndexArrayView IndicesLocal = LODLocal.IndexBuffer.GetArrayView();
+	const FTransform& TransformLocal = Component->GetComponentTransform();
+	const double SampleAreaLocal = FMath::Square(static_cast<double>(Spacing));
+
+	for (int32 TriangleLocal = 0; TriangleLocal + 2 < IndicesLocal.Num(); TriangleLocal += 3)
+	{
+		const FVector VertexALocal = TransformLocal.TransformPosition(FVector(PositionsLocal.VertexPosition(IndicesLocal[TriangleLocal])));
+		const FVector VertexBLocal = TransformLocal.TransformPosition(FVector(PositionsLocal.VertexPosition(IndicesLocal[TriangleLocal + 1])));
+		const FVector VertexCLocal = TransformLocal.TransformPosition(FVector(PositionsLocal.VertexPosition(IndicesLocal[TriangleLocal + 2])));
+
+		// counter clockwise winding in Unreal's left handed space
+		const FVector CrossLocal = FVector::CrossProduct(VertexCLocal - VertexALocal, VertexBLocal - VertexALocal);
+		const double AreaLocal = CrossLocal.Size() * 0.5;
+		if (AreaLocal <= SMALL_NUMBER)
+		{
+			continue;
+		}
+		const FVector NormalLocal = CrossLocal / (AreaLocal * 2.0);
+
+		// deterministic per triangle so rebakes of unchanged geometry give the same anchors
+		FRandomStream StreamLocal(HashCombine(GetTypeHash(VertexALocal), GetTypeHash(VertexCLocal)));
+		const int32 NumSamplesLocal = FMath::Max(1, FMath::CeilToInt(AreaLocal / SampleAreaLocal));
+		for (int32 SampleLocal = 0; SampleLocal < NumSamplesLocal; ++SampleLocal)
+		{
+			// uniform point in the triangle
+			double ULocal = StreamLocal.GetFraction();
+			double VLocal = StreamLocal.GetFraction();
+			if (ULocal + VLocal > 1.0)
+			{
+				ULocal = 1.0 - ULocal;
+				VLocal = 1.0 - VLocal;
+			}
+			const FVector PointLocal = VertexALocal + (VertexBLocal - VertexALocal) * ULocal + (VertexCLocal - VertexALocal) * VLocal;
+			const FIntVector VoxelLocal(FMath::FloorToInt(PointLocal.X / Spacing), FMath::FloorToInt(PointLocal.Y / Spacing), FMath::FloorToInt(PointLocal.Z / Spacing));
+			if (!Voxels.Contains(VoxelLocal))
+			{
+				Voxels.Add(VoxelLocal, FBakedAnchor{ PointLocal, NormalLocal });
+			}
+		}
+	}
+}
+
+FIntVector UGrappleAnchorBakeCommandlet::GetCellKey(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellHeight));
+}
+
+FVector UGrappleAnchorBakeCommandlet::GetCellCenter(const FIntVector& CellKey) const
+{
+	return FVector((CellKey.X + 0.5) * CellSize, (CellKey.Y + 0.5) * CellSize, (CellKey.Z + 0.5) * CellHeight);
+}
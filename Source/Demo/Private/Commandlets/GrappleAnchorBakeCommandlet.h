@@ -0,0 +1,66 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GrappleAnchorBakeCommandlet.generated.h"
+
+class UStaticMeshComponent;
+
+/**
+ * Bakes grapple anchor candidates (point + surface normal) on the static geometry of a World Partition map into one AGrappleAnchorCellActor per cell.
+ * Only components whose collision object type is one of the character's GrapplableTargets are sampled; points are spread over the triangles
+ * and kept at most one per Spacing sized voxel.
+ * Logs and writes to -Report (.json, by default Saved/Profiling/GrappleAnchorBake) the bake and save time, the bytes per cell and the load cost:
+ * each cell's decode and block registration as it streams in, median of -LoadRuns loads of the whole map into an empty game world.
+ *
+ * UnrealEditor-Cmd.exe Demo.uproject -run=GrappleAnchorBake -Map=/Game/Maps/ThirdPersonMap [-Character=/Game/Core/Character/BP_GrappleCharacter] [-CellSize=12800] [-Spacing=200]
+ *   [-LoadRuns=20] [-Report=<path without extension>] [-NoSave]
+ */
+UCLASS()
+class UGrappleAnchorBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	struct FBakedAnchor
+	{
+		FVector Location;
+		FVector Normal;
+	};
+
+	/** Horizontal size of a bake cell, should match the runtime grid cell size */
+	float CellSize{ 12800.f };
+	/** Vertical size of a bake cell, keeps the quantized positions in range */
+	float CellHeight{ 25600.f };
+	/** Minimum distance between two anchors */
+	float Spacing{ 200.f };
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleAnchorBakeCommandlet();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual int32 Main(const FString& Params) override;
+
+	/********************************
+	* MEMBER METHODS
+	********************************/
+protected:
+	/** Samples the triangles of Component's LOD0 into Voxels (one anchor per voxel) */
+	void SampleComponent(const UStaticMeshComponent* Component, TMap<FIntVector, FBakedAnchor>& Voxels) const;
+	FIntVector GetCellKey(const FVector& Location) const;
+	FVector GetCellCenter(const FIntVector& CellKey) const;
+};
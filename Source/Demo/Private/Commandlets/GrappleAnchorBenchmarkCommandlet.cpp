@@ -0,0 +1,214 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleAnchorBenchmarkCommandlet.h"
+#include "GrappleCommandletUtils.h"
+#include "Grapple/GrappleAnchorSubsystem.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "Demo.h"
+
+namespace GrappleAnchorBenchmark
+{
+	/** Anchors are spread over a box this wide (cm), 200 m like a streamed in area around the players */
+	constexpr double AreaSize = 20000.0;
+	constexpr double AreaHeight = 3000.0;
+	/** How far a movable anchor drifts per frame (cm) */
+	constexpr double DriftPerFrame = 5.0;
+	/** Eye height of the querying characters */
+	constexpr double EyeHeight = 160.0;
+}
+
+UGrappleAnchorBenchmarkCommandlet::UGrappleAnchorBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGrappleAnchorBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 NumAnchorsLocal = 10000;
+	int32 NumCharactersLocal = 100;
+	int32 NumMovingLocal = 1000;
+	int32 NumFramesLocal = 300;
+	int32 SeedLocal = 1234;
+	FParse::Value(*Params, TEXT("Anchors="), NumAnchorsLocal);
+	FParse::Value(*Params, TEXT("Characters="), NumCharactersLocal);
+	FParse::Value(*Params, TEXT("Moving="), NumMovingLocal);
+	FParse::Value(*Params, TEXT("Frames="), NumFramesLocal);
+	FParse::Value(*Params, TEXT("Seed="), SeedLocal);
+	NumAnchorsLocal = FMath::Max(NumAnchorsLocal, 1);
+	NumCharactersLocal = FMath::Max(NumCharactersLocal, 1);
+	NumMovingLocal = FMath::Clamp(NumMovingLocal, 0, NumAnchorsLocal);
+	NumFramesLocal = FMath::Max(NumFramesLocal, 1);
+	FRandomStream RandomStreamLocal(SeedLocal);
+
+	const FGrappleHeadlessWorld HeadlessWorldLocal;
+	UWorld* WorldLocal = HeadlessWorldLocal.Get();
+
+	UGrappleAnchorSubsystem* AnchorSubsystemLocal = WorldLocal->GetSubsystem<UGrappleAnchorSubsystem>();
+	if (!AnchorSubsystemLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleAnchorBenchmark: no grapple anchor subsystem in the game world"));
+		return 1;
+	}
+
+	auto RandomLocationLocal = [&RandomStreamLocal]()
+	{
+		const float HalfSizeLocal = static_cast<float>(GrappleAnchorBenchmark::AreaSize * 0.5);
+		return FVector(RandomStreamLocal.FRandRange(-HalfSizeLocal, HalfSizeLocal), RandomStreamLocal.FRandRange(-HalfSizeLocal, HalfSizeLocal), RandomStreamLocal.FRandRange(0.f, static_cast<float>(GrappleAnchorBenchmark::AreaHeight)));
+	};
+
+	// the movable anchors are components like UGrappleAnchorComponent, the subsystem follows them through TransformUpdated
+	TArray<USceneComponent*> MovingComponentsLocal;
+	TArray<FVector> DriftsLocal;
+	MovingComponentsLocal.Reserve(NumMovingLocal);
+	DriftsLocal.Reserve(NumMovingLocal);
+	for (int32 IndexLocal = 0; IndexLocal < NumMovingLocal; ++IndexLocal)
+	{
+		AActor* ActorLocal = WorldLocal->SpawnActor<AActor>();
+		USceneComponent* ComponentLocal = NewObject<USceneComponent>(ActorLocal);
+		ComponentLocal->SetMobility(EComponentMobility::Movable);
+		ActorLocal->SetRootComponent(ComponentLocal);
+		ComponentLocal->RegisterComponent();
+		ComponentLocal->SetWorldLocation(RandomLocationLocal());
+		MovingComponentsLocal.Add(ComponentLocal);
+		DriftsLocal.Add(RandomStreamLocal.VRand() * GrappleAnchorBenchmark::DriftPerFrame);
+	}
+	TArray<FVector> FixedLocationsLocal;
+	FixedLocationsLocal.Reserve(NumAnchorsLocal - NumMovingLocal);
+	for (int32 IndexLocal = NumMovingLocal; IndexLocal < NumAnchorsLocal; ++IndexLocal)
+	{
+		FixedLocationsLocal.Add(RandomLocationLocal());
+	}
+
+	const double RegisterStartLocal = FPlatformTime::Seconds();
+	for (USceneComponent* ComponentLocal : MovingComponentsLocal)
+	{
+		AnchorSubsystemLocal->RegisterAnchorComponent(ComponentLocal);
+	}
+	for (const FVector& LocationLocal : FixedLocationsLocal)
+	{
+		AnchorSubsystemLocal->RegisterAnchorPoint(LocationLocal);
+	}
+	const double RegisterMsLocal = (FPlatformTime::Seconds() - RegisterStartLocal) * 1000.0;
+
+	// characters stand on the ground looking around, roughly level
+	TArray<FVector> EyesLocal;
+	TArray<float> YawsLocal;
+	for (int32 IndexLocal = 0; IndexLocal < NumCharactersLocal; ++IndexLocal)
+	{
+		FVector EyeLocal = RandomLocationLocal();
+		EyeLocal.Z = GrappleAnchorBenchmark::EyeHeight;
+		EyesLocal.Add(EyeLocal);
+		YawsLocal.Add(RandomStreamLocal.FRandRange(-180.f, 180.f));
+	}
+
+	double MoveMsLocal = 0.0;
+	double GatherMsLocal = 0.0;
+	double ScoreWaitMsLocal = 0.0;
+	double BruteForceMsLocal = 0.0;
+	int64 NumCandidatesLocal = 0;
+	int32 NumFoundLocal = 0;
+	int32 NumMismatchesLocal = 0;
+
+	TArray<FGrappleAnchorQuery> QueriesLocal;
+	TArray<FGrappleAnchorCone> ConesLocal;
+	TArray<FGrappleAnchorCandidate> AllCandidatesLocal;
+	QueriesLocal.SetNum(NumCharactersLocal);
+	ConesLocal.SetNum(NumCharactersLocal);
+	AllCandidatesLocal.SetNum(NumAnchorsLocal);
+	for (int32 FrameLocal = 0; FrameLocal < NumFramesLocal; ++FrameLocal)
+	{
+		const double MoveStartLocal = FPlatformTime::Seconds();
+		for (int32 IndexLocal = 0; IndexLocal < MovingComponentsLocal.Num(); ++IndexLocal)
+		{
+			USceneComponent* ComponentLocal = MovingComponentsLocal[IndexLocal];
+			FVector NewLocationLocal = ComponentLocal->GetComponentLocation() + DriftsLocal[IndexLocal];
+			// bounce off the area bounds so the anchors stay spread out
+			for (int32 AxisLocal = 0; AxisLocal < 3; ++AxisLocal)
+			{
+				const double MinLocal = AxisLocal == 2 ? 0.0 : -GrappleAnchorBenchmark::AreaSize * 0.5;
+				const double MaxLocal = AxisLocal == 2 ? GrappleAnchorBenchmark::AreaHeight : GrappleAnchorBenchmark::AreaSize * 0.5;
+				if (NewLocationLocal[AxisLocal] < MinLocal || NewLocationLocal[AxisLocal] > MaxLocal)
+				{
+					DriftsLocal[IndexLocal][AxisLocal] *= -1.0;
+					NewLocationLocal[AxisLocal] = FMath::Clamp(NewLocationLocal[AxisLocal], MinLocal, MaxLocal);
+				}
+			}
+			ComponentLocal->SetWorldLocation(NewLocationLocal);
+		}
+		MoveMsLocal += (FPlatformTime::Seconds() - MoveStartLocal) * 1000.0;
+
+		for (int32 IndexLocal = 0; IndexLocal < NumCharactersLocal; ++IndexLocal)
+		{
+			// everyone keeps turning a little and looks slightly up, where the anchors are
+			YawsLocal[IndexLocal] += 1.f;
+			FGrappleAnchorCone& ConeLocal = ConesLocal[IndexLocal];
+			ConeLocal.Origin = EyesLocal[IndexLocal];
+			ConeLocal.Direction = FRotator(10.f, YawsLocal[IndexLocal], 0.f).Vector();
+		}
+
+		// the aim assist path: gather on the game thread, score on workers, collect once complete
+		const double GatherStartLocal = FPlatformTime::Seconds();
+		FGraphEventArray TasksLocal;
+		for (int32 IndexLocal = 0; IndexLocal < NumCharactersLocal; ++IndexLocal)
+		{
+			QueriesLocal[IndexLocal] = AnchorSubsystemLocal->StartConeQuery(ConesLocal[IndexLocal]);
+			if (QueriesLocal[IndexLocal].Task.IsValid())
+			{
+				TasksLocal.Add(QueriesLocal[IndexLocal].Task);
+			}
+		}
+		const double ScoreStartLocal = FPlatformTime::Seconds();
+		GatherMsLocal += (ScoreStartLocal - GatherStartLocal) * 1000.0;
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(TasksLocal, ENamedThreads::GameThread);
+		ScoreWaitMsLocal += (FPlatformTime::Seconds() - ScoreStartLocal) * 1000.0;
+
+		// without the tree: every anchor scored for every character on the game thread
+		const double BruteForceStartLocal = FPlatformTime::Seconds();
+		for (int32 IndexLocal = 0; IndexLocal < MovingComponentsLocal.Num(); ++IndexLocal)
+		{
+			AllCandidatesLocal[IndexLocal].Location = MovingComponentsLocal[IndexLocal]->GetComponentLocation();
+		}
+		for (int32 IndexLocal = 0; IndexLocal < FixedLocationsLocal.Num(); ++IndexLocal)
+		{
+			AllCandidatesLocal[NumMovingLocal + IndexLocal].Location = FixedLocationsLocal[IndexLocal];
+		}
+		TArray<FGrappleAnchorQueryResult> BruteForceResultsLocal;
+		BruteForceResultsLocal.Reserve(NumCharactersLocal);
+		for (int32 IndexLocal = 0; IndexLocal < NumCharactersLocal; ++IndexLocal)
+		{
+			BruteForceResultsLocal.Add(UGrappleAnchorSubsystem::ScoreCandidates(ConesLocal[IndexLocal], AllCandidatesLocal));
+		}
+		BruteForceMsLocal += (FPlatformTime::Seconds() - BruteForceStartLocal) * 1000.0;
+
+		for (int32 IndexLocal = 0; IndexLocal < NumCharactersLocal; ++IndexLocal)
+		{
+			const FGrappleAnchorQueryResult& ResultLocal = *QueriesLocal[IndexLocal].Result;
+			const FGrappleAnchorQueryResult& ExpectedLocal = BruteForceResultsLocal[IndexLocal];
+			NumCandidatesLocal += ResultLocal.NumCandidates;
+			NumFoundLocal += ResultLocal.bFound ? 1 : 0;
+			if (ResultLocal.bFound != ExpectedLocal.bFound || (ResultLocal.bFound && !ResultLocal.Best.Location.Equals(ExpectedLocal.Best.Location)))
+			{
+				++NumMismatchesLocal;
+			}
+			QueriesLocal[IndexLocal].Reset();
+		}
+	}
+
+	const int64 NumQueriesLocal = static_cast<int64>(NumCharactersLocal) * NumFramesLocal;
+	UE_LOG(LogGrapple, Display, TEXT("GrappleAnchorBenchmark: %d anchors (%d movable), %d characters, %d frames"), NumAnchorsLocal, NumMovingLocal, NumCharactersLocal, NumFramesLocal);
+	UE_LOG(LogGrapple, Display, TEXT("GrappleAnchorBenchmark: register %.3f ms, tree update %.4f ms/frame (%d moves)"), RegisterMsLocal, MoveMsLocal / NumFramesLocal, NumMovingLocal);
+	UE_LOG(LogGrapple, Display, TEXT("GrappleAnchorBenchmark: tree gather %.4f ms/frame on the game thread, worker scoring wait %.4f ms/frame, %.1f candidates/query, %.1f%% found"),
+		GatherMsLocal / NumFramesLocal, ScoreWaitMsLocal / NumFramesLocal, static_cast<double>(NumCandidatesLocal) / NumQueriesLocal, 100.0 * NumFoundLocal / NumQueriesLocal);
+	UE_LOG(LogGrapple, Display, TEXT("GrappleAnchorBenchmark: brute force %.4f ms/frame on the game thread (%d candidates/query)"), BruteForceMsLocal / NumFramesLocal, NumAnchorsLocal);
+	if (NumMismatchesLocal > 0)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleAnchorBenchmark: %d of %lld queries picked a different anchor than the brute force"), NumMismatchesLocal, NumQueriesLocal);
+	}
+
+	return NumMismatchesLocal > 0 ? 1 : 0;
+}
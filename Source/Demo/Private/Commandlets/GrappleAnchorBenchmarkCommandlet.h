@@ -0,0 +1,36 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GrappleAnchorBenchmarkCommandlet.generated.h"
+
+/**
+ * Times UGrappleAnchorSubsystem in a new game world at aim assist scale: registers the anchors (fixed points plus movable components),
+ * then every frame moves the movable ones and runs one cone query per character, the way locally controlled characters do each tick.
+ * Logs the registration time, the tree update ms, the game thread gather ms, the worker scoring wait and the candidates per query,
+ * next to scoring every anchor for every character on the game thread. The best anchor of both is compared, any mismatch fails the run.
+ *
+ * UnrealEditor-Cmd.exe Demo.uproject -run=GrappleAnchorBenchmark [-Anchors=10000] [-Characters=100] [-Moving=1000] [-Frames=300] [-Seed=1234]
+ */
+UCLASS()
+class UGrappleAnchorBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleAnchorBenchmarkCommandlet();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual int32 Main(const FString& Params) override;
+};
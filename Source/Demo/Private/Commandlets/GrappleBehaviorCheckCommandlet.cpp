@@ -0,0 +1,107 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleBehaviorCheckCommandlet.h"
+#include "GrappleBehaviorScenarios.h"
+#include "GrappleCommandletUtils.h"
+#include "Engine/StaticMesh.h"
+#include "Demo.h"
+
+UGrappleBehaviorCheckCommandlet::UGrappleBehaviorCheckCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGrappleBehaviorCheckCommandlet::Main(const FString& Params)
+{
+	FString CharacterClassNameLocal(TEXT("/Game/Core/Character/BP_GrappleCharacter"));
+	FParse::Value(*Params, TEXT("Character="), CharacterClassNameLocal);
+	const bool bUpdateBaselineLocal = FParse::Param(*Params, TEXT("UpdateBaseline"));
+	int32 NumRunsLocal = 5;
+	FParse::Value(*Params, TEXT("Runs="), NumRunsLocal);
+	NumRunsLocal = FMath::Max(NumRunsLocal, 1);
+
+	UClass* CharacterClassLocal = GrappleCommandletUtils::LoadCharacterClass(CharacterClassNameLocal);
+	if (!CharacterClassLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleBehaviorCheck: can't load character class %s"), *CharacterClassNameLocal);
+		return 1;
+	}
+	UStaticMesh* MeshLocal = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!MeshLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleBehaviorCheck: can't load /Engine/BasicShapes/Cube"));
+		return 1;
+	}
+
+	int32 NumFailuresLocal = 0;
+	TArray<FGrappleBehaviorBaseline> MeasuredLocal;
+	for (const GrappleBehaviorCheck::FScenario& ScenarioLocal : GrappleBehaviorCheck::GetScenarios())
+	{
+		// the median of several runs, a single one is at the mercy of whatever else the machine does
+		TArray<float> WallMsLocal;
+		TArray<float> GameThreadMsPerFrameLocal;
+		int32 NumFramesLocal = 0;
+		int32 NumScenarioFailuresLocal = 0;
+		for (int32 RunIndexLocal = 0; RunIndexLocal < NumRunsLocal; ++RunIndexLocal)
+		{
+			const GrappleBehaviorCheck::FResult ResultLocal = GrappleBehaviorCheck::Run(ScenarioLocal, CharacterClassLocal, MeshLocal);
+			for (const FString& FailureLocal : ResultLocal.Failures)
+			{
+				UE_LOG(LogGrapple, Error, TEXT("GrappleBehaviorCheck: %s: %s"), ScenarioLocal.Name, *FailureLocal);
+			}
+			NumScenarioFailuresLocal += ResultLocal.Failures.Num();
+			WallMsLocal.Add(static_cast<float>(ResultLocal.WallMs));
+			GameThreadMsPerFrameLocal.Add(static_cast<float>(ResultLocal.GameThreadMs / FMath::Max(ResultLocal.NumFrames, 1)));
+			NumFramesLocal = ResultLocal.NumFrames;
+		}
+		NumFailuresLocal += NumScenarioFailuresLocal;
+		WallMsLocal.Sort();
+		GameThreadMsPerFrameLocal.Sort();
+
+		FGrappleBehaviorBaseline& RunLocal = MeasuredLocal.AddDefaulted_GetRef();
+		RunLocal.Scenario = ScenarioLocal.Name;
+		RunLocal.WallMs = GrappleCommandletUtils::GetPercentile(WallMsLocal, 0.5);
+		RunLocal.GameThreadMsPerFrame = GrappleCommandletUtils::GetPercentile(GameThreadMsPerFrameLocal, 0.5);
+		UE_LOG(LogGrapple, Display, TEXT("GrappleBehaviorCheck: %s %s, %d frames, median of %d runs %.2f ms wall (%.2f to %.2f), %.4f ms game thread per frame (%.4f to %.4f)"),
+			ScenarioLocal.Name, NumScenarioFailuresLocal > 0 ? TEXT("failed") : TEXT("passed"), NumFramesLocal, NumRunsLocal,
+			RunLocal.WallMs, WallMsLocal[0], WallMsLocal.Last(), RunLocal.GameThreadMsPerFrame, GameThreadMsPerFrameLocal[0], GameThreadMsPerFrameLocal.Last());
+
+		if (bUpdateBaselineLocal)
+		{
+			continue;
+		}
+		const FGrappleBehaviorBaseline* BaselineLocal = Baselines.FindByPredicate([&RunLocal](const FGrappleBehaviorBaseline& Other) { return Other.Scenario == RunLocal.Scenario; });
+		if (!BaselineLocal)
+		{
+			// an unchecked scenario would pass silently forever
+			UE_LOG(LogGrapple, Error, TEXT("GrappleBehaviorCheck: %s has no baseline in DefaultGame.ini, run with -UpdateBaseline to store one"), ScenarioLocal.Name);
+			++NumFailuresLocal;
+			continue;
+		}
+		const float ScaleLocal = 1.f + MaxRegression;
+		if (RunLocal.GameThreadMsPerFrame > BaselineLocal->GameThreadMsPerFrame * ScaleLocal)
+		{
+			UE_LOG(LogGrapple, Error, TEXT("GrappleBehaviorCheck: %s game thread regressed, %.4f ms per frame against a %.4f ms baseline"), ScenarioLocal.Name, RunLocal.GameThreadMsPerFrame, BaselineLocal->GameThreadMsPerFrame);
+			++NumFailuresLocal;
+		}
+		if (RunLocal.WallMs > BaselineLocal->WallMs * ScaleLocal)
+		{
+			UE_LOG(LogGrapple, Error, TEXT("GrappleBehaviorCheck: %s wall time regressed, %.2f ms against a %.2f ms baseline"), ScenarioLocal.Name, RunLocal.WallMs, BaselineLocal->WallMs);
+			++NumFailuresLocal;
+		}
+	}
+
+	if (bUpdateBaselineLocal)
+	{
+		Baselines = MoveTemp(MeasuredLocal);
+		TryUpdateDefaultConfigFile();
+		UE_LOG(LogGrapple, Display, TEXT("GrappleBehaviorCheck: baselines written to DefaultGame.ini"));
+	}
+
+	UE_LOG(LogGrapple, Display, TEXT("GrappleBehaviorCheck: %s (%d failures)"), NumFailuresLocal > 0 ? TEXT("FAILED") : TEXT("passed"), NumFailuresLocal);
+	return NumFailuresLocal > 0 ? 1 : 0;
+}
@@ -0,0 +1,64 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GrappleBehaviorCheckCommandlet.generated.h"
+
+/** Stored timings of one scenario (medians over the runs), a check slower than these by more than MaxRegression fails */
+USTRUCT()
+struct FGrappleBehaviorBaseline
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Config)
+	FString Scenario;
+	/** The grapple from the shot to the last check, world setup, settling and teardown excluded */
+	UPROPERTY(Config)
+	float WallMs{ 0.f };
+	/** World ticks of the same span, per frame */
+	UPROPERTY(Config)
+	float GameThreadMsPerFrame{ 0.f };
+};
+
+/**
+ * Headless check of the grapple feel: runs the GrappleBehaviorScenarios (the same ones the Demo.Grapple.Behavior automation spec runs), which
+ * check the hook attach time against the flight model, the arrival within the acceptance radius, holding at a high anchor, the automatic
+ * drop at an anchor lower than the accepted fall distance and the break off velocity. Each scenario's wall time and game thread ms per frame
+ * (medians over -Runs) are compared with the baselines in DefaultGame.ini (a scenario without one fails); -UpdateBaseline writes the measured
+ * ones there instead. Baselines only mean something on the machine that measured them, record them on the agent that gates the build.
+ * Returns non zero if anything failed, so it can gate a build.
+ *
+ * UnrealEditor-Cmd.exe Demo.uproject -run=GrappleBehaviorCheck -nullrhi -unattended [-Character=/Game/Core/Character/BP_GrappleCharacter] [-Runs=5] [-UpdateBaseline]
+ */
+UCLASS(Config = Game)
+class UGrappleBehaviorCheckCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	UPROPERTY(Config)
+	TArray<FGrappleBehaviorBaseline> Baselines;
+	/** Allowed slow down over the baselines (0.15 = 15%) */
+	UPROPERTY(Config)
+	float MaxRegression{ 0.15f };
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleBehaviorCheckCommandlet();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual int32 Main(const FString& Params) override;
+};
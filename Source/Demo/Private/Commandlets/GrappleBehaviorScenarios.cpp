@@ -0,0 +1,155 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleBehaviorScenarios.h"
+#include "GrappleCommandletUtils.h"
+#include "Character/GrappleCharacter.h"
+#include "Character/GrappleMovementComponent.h"
+#include "Grapple/GrappleSolver.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+
+namespace GrappleBehaviorCheck
+{
+	constexpr float DeltaTime = 1.f / 60.f;
+	/** Frames the character gets to land before firing, and the most any phase may take */
+	constexpr int32 SettleFrames = 30;
+	constexpr int32 MaxPhaseFrames = 600;
+
+	/** Spawns a static cube scaled to Size */
+	void SpawnBlock(UWorld* World, UStaticMesh* Mesh, const FVector& Location, const FVector& Size)
+	{
+		AStaticMeshActor* ActorLocal = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator);
+		UStaticMeshComponent* MeshComponentLocal = ActorLocal->GetStaticMeshComponent();
+		MeshComponentLocal->SetMobility(EComponentMobility::Movable);
+		MeshComponentLocal->SetStaticMesh(Mesh);
+		// the engine cube is 100 cm
+		ActorLocal->SetActorScale3D(Size / 100.0);
+	}
+
+	/** Ticks the world until Done returns true or MaxPhaseFrames passed, returns the frames ticked (INDEX_NONE on timeout) */
+	int32 TickUntil(UWorld* World, FResult& Result, TFunctionRef<bool()> Done)
+	{
+		for (int32 FrameLocal = 1; FrameLocal <= MaxPhaseFrames; ++FrameLocal)
+		{
+			const double StartLocal = FPlatformTime::Seconds();
+			World->Tick(LEVELTICK_All, DeltaTime);
+			Result.GameThreadMs += (FPlatformTime::Seconds() - StartLocal) * 1000.0;
+			++Result.NumFrames;
+			if (Done())
+			{
+				return FrameLocal;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	TConstArrayView<FScenario> GetScenarios()
+	{
+		// a tall block 20 m ahead with the anchor 15 m up (well above the accepted fall distance), and a low one with the anchor just under a meter up
+		static const FScenario Scenarios[] =
+		{
+			{ TEXT("HighAnchor"), FVector(2100.0, 0.0, 1000.0), FVector(200.0, 400.0, 2000.0), 1500.0, false },
+			{ TEXT("LowAnchor"), FVector(1600.0, 0.0, 50.0), FVector(200.0, 400.0, 100.0), 90.0, true },
+		};
+		return Scenarios;
+	}
+
+	FResult Run(const FScenario& Scenario, UClass* CharacterClass, UStaticMesh* Mesh)
+	{
+		FResult ResultLocal;
+
+		const FGrappleHeadlessWorld HeadlessWorldLocal;
+		UWorld* WorldLocal = HeadlessWorldLocal.Get();
+
+		// floor top at 0, the character stands at the origin facing +X towards the block
+		SpawnBlock(WorldLocal, Mesh, FVector(0.0, 0.0, -50.0), FVector(10000.0, 10000.0, 100.0));
+		SpawnBlock(WorldLocal, Mesh, Scenario.BlockLocation, Scenario.BlockSize);
+		const FVector AnchorLocal(Scenario.BlockLocation.X - (Scenario.BlockSize.X * 0.5), Scenario.BlockLocation.Y, Scenario.AnchorHeight);
+
+		FActorSpawnParameters SpawnParametersLocal;
+		SpawnParametersLocal.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		AGrappleCharacter* CharacterLocal = WorldLocal->SpawnActor<AGrappleCharacter>(CharacterClass, FVector(0.0, 0.0, 100.0), FRotator::ZeroRotator, SpawnParametersLocal);
+		UGrappleMovementComponent* MovementLocal = CharacterLocal ? Cast<UGrappleMovementComponent>(CharacterLocal->GetCharacterMovement()) : nullptr;
+		if (!MovementLocal)
+		{
+			ResultLocal.Failures.Add(TEXT("can't spawn the character"));
+		}
+		else
+		{
+			// nobody possesses it here
+			MovementLocal->bRunPhysicsWithNoController = true;
+			for (int32 FrameLocal = 0; FrameLocal < SettleFrames; ++FrameLocal)
+			{
+				WorldLocal->Tick(LEVELTICK_All, DeltaTime);
+			}
+			const double WallStartLocal = FPlatformTime::Seconds();
+
+			// fire: the hook leaves the gun and must attach when the flight model says so (to the frame)
+			const float ExpectedAttachTimeLocal = FGrappleSolver::GetHookAttachTime(FVector::Dist(CharacterLocal->GetGrappleGun()->GetComponentLocation(), AnchorLocal), CharacterLocal->GetGrappleAttachSpeed(), MovementLocal->GetHookAttachTolerance());
+			MovementLocal->RequestGrapple(AnchorLocal, nullptr);
+			const int32 AttachFramesLocal = TickUntil(WorldLocal, ResultLocal, [CharacterLocal]() { return CharacterLocal->GetGrappleAttached() || !CharacterLocal->GetGrappleActive(); });
+			if (AttachFramesLocal == INDEX_NONE || !CharacterLocal->GetGrappleAttached())
+			{
+				ResultLocal.Failures.Add(TEXT("the hook never attached"));
+			}
+			else if (FMath::Abs((AttachFramesLocal * DeltaTime) - ExpectedAttachTimeLocal) > DeltaTime + KINDA_SMALL_NUMBER)
+			{
+				ResultLocal.Failures.Add(FString::Printf(TEXT("attached after %.3f s, expected %.3f s"), AttachFramesLocal * DeltaTime, ExpectedAttachTimeLocal));
+			}
+
+			// pull: arrives within the acceptance radius, then holds (high anchor) or drops (low anchor)
+			FVector ArrivalLocationLocal{ 0.f };
+			const int32 PullFramesLocal = TickUntil(WorldLocal, ResultLocal, [CharacterLocal, &ArrivalLocationLocal]()
+			{
+				ArrivalLocationLocal = CharacterLocal->GetActorLocation();
+				return CharacterLocal->GetArrived() || !CharacterLocal->GetGrappleActive();
+			});
+			const float AcceptanceRadiusLocal = CharacterLocal->GetGrappleAcceptanceRadius();
+			const double ArrivalDistanceLocal = FVector::Dist(ArrivalLocationLocal, CharacterLocal->GetAttachLocation());
+			if (PullFramesLocal == INDEX_NONE)
+			{
+				ResultLocal.Failures.Add(TEXT("never arrived"));
+			}
+			else if (ArrivalDistanceLocal > AcceptanceRadiusLocal)
+			{
+				ResultLocal.Failures.Add(FString::Printf(TEXT("ended the pull %.1f cm from the anchor, acceptance radius is %.1f cm"), ArrivalDistanceLocal, AcceptanceRadiusLocal));
+			}
+			else if (Scenario.bExpectDrop && CharacterLocal->GetGrappleActive())
+			{
+				ResultLocal.Failures.Add(FString::Printf(TEXT("held at an anchor %.1f cm above the floor, accepted fall distance is %.1f cm"), Scenario.AnchorHeight, CharacterLocal->GetGrappleAcceptedFallDistance()));
+			}
+			else if (!Scenario.bExpectDrop && !CharacterLocal->GetArrived())
+			{
+				ResultLocal.Failures.Add(TEXT("dropped off a high anchor instead of holding"));
+			}
+
+			// break off from the hold: launched with the break off velocity (plus the gravity of the frames it took)
+			if (!Scenario.bExpectDrop && CharacterLocal->GetArrived())
+			{
+				MovementLocal->RequestGrappleRelease();
+				FVector LaunchVelocityLocal{ 0.f };
+				TickUntil(WorldLocal, ResultLocal, [CharacterLocal, MovementLocal, &LaunchVelocityLocal]()
+				{
+					LaunchVelocityLocal = MovementLocal->Velocity;
+					return !CharacterLocal->GetGrappleActive() && !LaunchVelocityLocal.IsNearlyZero();
+				});
+				const FVector ExpectedVelocityLocal = CharacterLocal->GetBreakOffGrappleVelocity();
+				const double ToleranceLocal = FMath::Abs(WorldLocal->GetGravityZ()) * DeltaTime * 2.0;
+				if (CharacterLocal->GetGrappleActive())
+				{
+					ResultLocal.Failures.Add(TEXT("didn't break off"));
+				}
+				else if (!LaunchVelocityLocal.Equals(ExpectedVelocityLocal, ToleranceLocal))
+				{
+					ResultLocal.Failures.Add(FString::Printf(TEXT("broke off at %s, expected %s"), *LaunchVelocityLocal.ToCompactString(), *ExpectedVelocityLocal.ToCompactString()));
+				}
+			}
+			ResultLocal.WallMs = (FPlatformTime::Seconds() - WallStartLocal) * 1000.0;
+		}
+
+		return ResultLocal;
+	}
+}
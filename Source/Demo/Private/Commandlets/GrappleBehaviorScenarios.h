@@ -0,0 +1,44 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UStaticMesh;
+
+/**
+ * The grapple feel scenarios shared by the GrappleBehaviorCheck commandlet (which also gates their timings) and the Demo.Grapple.Behavior
+ * automation spec: a floor and a block in a new headless game world, a grapple character fired at a known anchor on the block, then the hook
+ * attach time against the flight model, the arrival within the acceptance radius, holding at a high anchor or dropping at a low one, and the
+ * break off velocity.
+ */
+namespace GrappleBehaviorCheck
+{
+	/** One grapple at a block face */
+	struct FScenario
+	{
+		const TCHAR* Name{ nullptr };
+		/** Block centre and size (cm), the anchor is the middle of the face looking at the character */
+		FVector BlockLocation{ 0.f };
+		FVector BlockSize{ 0.f };
+		/** Height of the anchor on that face */
+		double AnchorHeight{ 0.0 };
+		/** The anchor is lower than the accepted fall distance, the character must drop instead of holding */
+		bool bExpectDrop{ false };
+	};
+
+	/** Outcome of one scenario. Timings and frames cover the grapple itself, from the shot to the last check (no world setup, settling or teardown) */
+	struct FResult
+	{
+		/** What went wrong, empty if the scenario passed */
+		TArray<FString> Failures;
+		double WallMs{ 0.0 };
+		double GameThreadMs{ 0.0 };
+		int32 NumFrames{ 0 };
+	};
+
+	/** The scenarios, in the order they run */
+	TConstArrayView<FScenario> GetScenarios();
+	/** Runs one scenario in its own world with a character of CharacterClass, blocks made of Mesh (the engine cube) */
+	FResult Run(const FScenario& Scenario, UClass* CharacterClass, UStaticMesh* Mesh);
+}
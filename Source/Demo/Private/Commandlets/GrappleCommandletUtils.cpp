@@ -0,0 +1,108 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleCommandletUtils.h"
+#include "Character/GrappleCharacter.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#if WITH_EDITOR
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+#include "WorldPartition/WorldPartitionActorDesc.h"
+#endif
+#include "Demo.h"
+
+FGrappleHeadlessWorld::FGrappleHeadlessWorld(bool bWithGameMode)
+{
+	World = UWorld::CreateWorld(EWorldType::Game, false);
+	BeginPlay(bWithGameMode);
+}
+
+FGrappleHeadlessWorld::FGrappleHeadlessWorld(const FString& MapName, bool bWithGameMode)
+{
+	UPackage* MapPackageLocal = LoadPackage(nullptr, *MapName, LOAD_None);
+	World = MapPackageLocal ? UWorld::FindWorldInPackage(MapPackageLocal) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleHeadlessWorld: can't load map %s"), *MapName);
+		return;
+	}
+
+	World->WorldType = EWorldType::Game;
+	World->AddToRoot();
+	bLoadedMap = true;
+	if (!World->bIsWorldInitialized)
+	{
+		UWorld::InitializationValues InitValuesLocal;
+		InitValuesLocal.RequiresHitProxies(false);
+		InitValuesLocal.AllowAudioPlayback(false);
+		World->InitWorld(InitValuesLocal);
+	}
+#if WITH_EDITOR
+	// like a dedicated server, the whole map rather than the cells around a viewer
+	if (UWorldPartition* WorldPartitionLocal = World->GetWorldPartition())
+	{
+		FWorldPartitionHelpers::ForEachActorDesc(WorldPartitionLocal, AActor::StaticClass(), [this, WorldPartitionLocal](const FWorldPartitionActorDesc* ActorDesc)
+		{
+			ActorReferences.Emplace(WorldPartitionLocal, ActorDesc->GetGuid());
+			return true;
+		});
+	}
+#endif
+	World->UpdateWorldComponents(true, false);
+	BeginPlay(bWithGameMode);
+}
+
+FGrappleHeadlessWorld::~FGrappleHeadlessWorld()
+{
+	if (!World)
+	{
+		return;
+	}
+
+#if WITH_EDITOR
+	ActorReferences.Empty();
+#endif
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	if (bLoadedMap)
+	{
+		World->RemoveFromRoot();
+	}
+}
+
+void FGrappleHeadlessWorld::BeginPlay(bool bWithGameMode)
+{
+	FWorldContext& WorldContextLocal = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContextLocal.SetCurrentWorld(World);
+	if (bWithGameMode)
+	{
+		World->SetGameMode(FURL());
+	}
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+}
+
+namespace GrappleCommandletUtils
+{
+	float GetPercentile(TConstArrayView<float> SortedValues, double Percentile)
+	{
+		if (SortedValues.Num() == 0)
+		{
+			return 0.f;
+		}
+		const int32 IndexLocal = FMath::Clamp(FMath::CeilToInt(Percentile * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+		return SortedValues[IndexLocal];
+	}
+
+	UClass* LoadCharacterClass(const FString& ClassPath)
+	{
+		FString ClassPathLocal = ClassPath;
+		if (!ClassPathLocal.EndsWith(TEXT("_C")) && !ClassPathLocal.StartsWith(TEXT("/Script/")))
+		{
+			ClassPathLocal += FString::Printf(TEXT(".%s_C"), *FPackageName::GetShortName(ClassPathLocal));
+		}
+		return LoadClass<AGrappleCharacter>(nullptr, *ClassPathLocal);
+	}
+}
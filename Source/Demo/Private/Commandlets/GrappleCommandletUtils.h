@@ -0,0 +1,62 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#if WITH_EDITOR
+#include "WorldPartition/WorldPartitionHandle.h"
+#endif
+
+class UWorld;
+
+/**
+ * Game world of a headless commandlet or test, playing from construction until the scope ends: a new empty world, or a map loaded whole
+ * (World Partition cells aren't streamed, every actor of the map is in). IsValid() is false if the map can't be loaded.
+ * bWithGameMode spawns the world's game mode first, player controllers only get a player state with one.
+ */
+class FGrappleHeadlessWorld : public FNoncopyable
+{
+/*************************************
+* ATTRIBUTES
+*************************************/
+private:
+	UWorld* World{ nullptr };
+	/** The world belongs to a loaded map package and is kept in the root set while playing */
+	bool bLoadedMap{ false };
+#if WITH_EDITOR
+	/** Keeps every World Partition actor of the map loaded */
+	TArray<FWorldPartitionReference> ActorReferences;
+#endif
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	explicit FGrappleHeadlessWorld(bool bWithGameMode = false);
+	/** Loads MapName (long package name) */
+	explicit FGrappleHeadlessWorld(const FString& MapName, bool bWithGameMode = false);
+	~FGrappleHeadlessWorld();
+
+	/********************************
+	* MEMBER METHODS
+	********************************/
+public:
+	FORCEINLINE UWorld* Get() const { return World; }
+	FORCEINLINE bool IsValid() const { return World != nullptr; }
+
+private:
+	/** Gives the world a context and begins play */
+	void BeginPlay(bool bWithGameMode);
+};
+
+/** Helpers shared by the grapple commandlets */
+namespace GrappleCommandletUtils
+{
+	/** Nearest rank percentile of sorted values */
+	float GetPercentile(TConstArrayView<float> SortedValues, double Percentile);
+	/** Loads a grapple character class from a Blueprint asset path (/Game/Core/Character/BP_GrappleCharacter), its generated class path (..._C) or a native class path (/Script/...) */
+	UClass* LoadCharacterClass(const FString& ClassPath);
+}
@@ -0,0 +1,127 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleDispatchBenchmarkCommandlet.h"
+#include "GrappleCommandletUtils.h"
+#include "Character/GrappleCharacter.h"
+#include "Engine/World.h"
+#include "Algo/Find.h"
+#include "Demo.h"
+
+namespace GrappleDispatchBenchmark
+{
+	constexpr float DeltaTime = 1.f / 60.f;
+	constexpr double Spacing = 300.0;
+	/** The handlers the input bindings call every frame, in the order the character runs them */
+	const TCHAR* const AxisFunctionNames[] = { TEXT("MoveForward"), TEXT("MoveRight"), TEXT("Turn"), TEXT("LookUp") };
+}
+
+UGrappleDispatchBenchmarkCommandlet::UGrappleDispatchBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGrappleDispatchBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString CharacterClassNameLocal(TEXT("/Game/Core/Character/BP_GrappleCharacter"));
+	int32 NumCharactersLocal = 100;
+	int32 NumFramesLocal = 300;
+	FParse::Value(*Params, TEXT("Character="), CharacterClassNameLocal);
+	FParse::Value(*Params, TEXT("Characters="), NumCharactersLocal);
+	FParse::Value(*Params, TEXT("Frames="), NumFramesLocal);
+	NumCharactersLocal = FMath::Max(NumCharactersLocal, 1);
+	NumFramesLocal = FMath::Max(NumFramesLocal, 1);
+
+	UClass* CharacterClassLocal = GrappleCommandletUtils::LoadCharacterClass(CharacterClassNameLocal);
+	if (!CharacterClassLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleDispatchBenchmark: can't load character class %s"), *CharacterClassNameLocal);
+		return 1;
+	}
+
+	UFunction* AxisFunctionsLocal[UE_ARRAY_COUNT(GrappleDispatchBenchmark::AxisFunctionNames)];
+	for (int32 IndexLocal = 0; IndexLocal < UE_ARRAY_COUNT(GrappleDispatchBenchmark::AxisFunctionNames); ++IndexLocal)
+	{
+		AxisFunctionsLocal[IndexLocal] = AGrappleCharacter::StaticClass()->FindFunctionByName(GrappleDispatchBenchmark::AxisFunctionNames[IndexLocal]);
+	}
+	UFunction* StartDirectionFunctionLocal = AGrappleCharacter::StaticClass()->FindFunctionByName(TEXT("UpdateStartDirection"));
+	if (!StartDirectionFunctionLocal || Algo::Find(AxisFunctionsLocal, nullptr))
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleDispatchBenchmark: an input handler is no longer a UFUNCTION"));
+		return 1;
+	}
+	// blueprint calls get their parameters the way the VM would, zeroed frame memory with the axis value first
+	TArray<uint8> ParmsLocal;
+	ParmsLocal.SetNumZeroed(FMath::Max<int32>(AxisFunctionsLocal[0]->ParmsSize, sizeof(float)));
+
+	const FGrappleHeadlessWorld HeadlessWorldLocal;
+	UWorld* WorldLocal = HeadlessWorldLocal.Get();
+
+	TArray<AGrappleCharacter*> CharactersLocal;
+	for (int32 IndexLocal = 0; IndexLocal < NumCharactersLocal; ++IndexLocal)
+	{
+		FActorSpawnParameters SpawnParametersLocal;
+		SpawnParametersLocal.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		if (AGrappleCharacter* CharacterLocal = WorldLocal->SpawnActor<AGrappleCharacter>(CharacterClassLocal, FVector(IndexLocal * GrappleDispatchBenchmark::Spacing, 0.0, 100.0), FRotator::ZeroRotator, SpawnParametersLocal))
+		{
+			CharactersLocal.Add(CharacterLocal);
+		}
+	}
+	if (CharactersLocal.Num() == 0)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleDispatchBenchmark: no character spawned"));
+		return 1;
+	}
+	WorldLocal->Tick(LEVELTICK_All, GrappleDispatchBenchmark::DeltaTime);
+
+	// alternating frames so both paths see the same world state and cache pressure, only the handler calls are timed
+	TArray<float> NativeMsLocal;
+	TArray<float> ProcessEventMsLocal;
+	NativeMsLocal.Reserve(NumFramesLocal);
+	ProcessEventMsLocal.Reserve(NumFramesLocal);
+	for (int32 FrameLocal = 0; FrameLocal < NumFramesLocal * 2; ++FrameLocal)
+	{
+		const bool bNativeLocal = (FrameLocal & 1) == 0;
+		// the stick moves every frame so UpdateStartDirection recomputes instead of taking its early out
+		const float AxisValueLocal = FMath::Sin(FrameLocal * 0.1f);
+		const double StartLocal = FPlatformTime::Seconds();
+		for (AGrappleCharacter* CharacterLocal : CharactersLocal)
+		{
+			if (bNativeLocal)
+			{
+				CharacterLocal->MoveForward(AxisValueLocal);
+				CharacterLocal->MoveRight(AxisValueLocal);
+				CharacterLocal->Turn(AxisValueLocal);
+				CharacterLocal->LookUp(AxisValueLocal);
+				CharacterLocal->UpdateStartDirection();
+			}
+			else
+			{
+				for (UFunction* FunctionLocal : AxisFunctionsLocal)
+				{
+					FunctionLocal->InitializeStruct(ParmsLocal.GetData());
+					*reinterpret_cast<float*>(ParmsLocal.GetData()) = AxisValueLocal;
+					CharacterLocal->ProcessEvent(FunctionLocal, ParmsLocal.GetData());
+					FunctionLocal->DestroyStruct(ParmsLocal.GetData());
+				}
+				CharacterLocal->ProcessEvent(StartDirectionFunctionLocal, nullptr);
+			}
+		}
+		(bNativeLocal ? NativeMsLocal : ProcessEventMsLocal).Add(static_cast<float>((FPlatformTime::Seconds() - StartLocal) * 1000.0));
+		WorldLocal->Tick(LEVELTICK_All, GrappleDispatchBenchmark::DeltaTime);
+	}
+
+	NativeMsLocal.Sort();
+	ProcessEventMsLocal.Sort();
+	const double NativeP50Local = GrappleCommandletUtils::GetPercentile(NativeMsLocal, 0.5);
+	const double ProcessEventP50Local = GrappleCommandletUtils::GetPercentile(ProcessEventMsLocal, 0.5);
+	const double PerCharacterUsLocal = (ProcessEventP50Local - NativeP50Local) * 1000.0 / CharactersLocal.Num();
+	UE_LOG(LogGrapple, Display, TEXT("GrappleDispatchBenchmark: %d characters, %d frames each, 5 handlers per character per frame"), CharactersLocal.Num(), NumFramesLocal);
+	UE_LOG(LogGrapple, Display, TEXT("GrappleDispatchBenchmark: native %.4f ms per frame (p95 %.4f), ProcessEvent %.4f ms per frame (p95 %.4f), dispatch costs %.3f us per character per frame"),
+		NativeP50Local, GrappleCommandletUtils::GetPercentile(NativeMsLocal, 0.95), ProcessEventP50Local, GrappleCommandletUtils::GetPercentile(ProcessEventMsLocal, 0.95), PerCharacterUsLocal);
+
+	return 0;
+}
@@ -0,0 +1,35 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GrappleDispatchBenchmarkCommandlet.generated.h"
+
+/**
+ * Measures what the native input path saves: spawns grapple characters in an empty game world and runs their per frame handlers (MoveForward,
+ * MoveRight, Turn, LookUp and UpdateStartDirection) every frame, once as the native virtuals they are now and once through ProcessEvent, the
+ * way the BlueprintNativeEvent thunks called them. Logs the game thread ms per frame of both and the difference per character.
+ *
+ * UnrealEditor-Cmd.exe Demo.uproject -run=GrappleDispatchBenchmark [-Character=/Game/Core/Character/BP_GrappleCharacter] [-Characters=100] [-Frames=300]
+ */
+UCLASS()
+class UGrappleDispatchBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleDispatchBenchmarkCommandlet();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual int32 Main(const FString& Params) override;
+};
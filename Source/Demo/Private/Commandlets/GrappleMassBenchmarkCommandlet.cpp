@@ -0,0 +1,160 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleMassBenchmarkCommandlet.h"
+#include "GrappleCommandletUtils.h"
+#include "Grapple/GrappleAnchorSubsystem.h"
+#include "Grapple/GrappleStats.h"
+#include "Mass/GrappleMassTypes.h"
+#include "MassEntitySubsystem.h"
+#include "MassCommonFragments.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Demo.h"
+
+namespace GrappleMassBenchmark
+{
+	constexpr float DeltaTime = 1.f / 30.f;
+	/** Agents and anchors are spread over a square this wide (cm), the anchors up to AreaHeight above the floor */
+	constexpr double AreaSize = 40000.0;
+	constexpr double AreaHeight = 3000.0;
+	/** Frames ticked before measuring, long enough for every agent to have fired once */
+	constexpr int32 WarmUpFrames = 90;
+}
+
+UGrappleMassBenchmarkCommandlet::UGrappleMassBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGrappleMassBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 NumAgentsLocal = 5000;
+	int32 NumAnchorsLocal = 2000;
+	int32 NumFramesLocal = 300;
+	float BudgetMsLocal = 4.f;
+	int32 SeedLocal = 1234;
+	FParse::Value(*Params, TEXT("Agents="), NumAgentsLocal);
+	FParse::Value(*Params, TEXT("Anchors="), NumAnchorsLocal);
+	FParse::Value(*Params, TEXT("Frames="), NumFramesLocal);
+	FParse::Value(*Params, TEXT("BudgetMs="), BudgetMsLocal);
+	FParse::Value(*Params, TEXT("Seed="), SeedLocal);
+	NumAgentsLocal = FMath::Max(NumAgentsLocal, 1);
+	NumAnchorsLocal = FMath::Max(NumAnchorsLocal, 1);
+	NumFramesLocal = FMath::Max(NumFramesLocal, 1);
+	FRandomStream RandomStreamLocal(SeedLocal);
+
+	UStaticMesh* MeshLocal = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!MeshLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleMassBenchmark: can't load /Engine/BasicShapes/Cube"));
+		return 1;
+	}
+
+	const FGrappleHeadlessWorld HeadlessWorldLocal;
+	UWorld* WorldLocal = HeadlessWorldLocal.Get();
+	UMassEntitySubsystem* EntitySubsystemLocal = WorldLocal->GetSubsystem<UMassEntitySubsystem>();
+	UGrappleAnchorSubsystem* AnchorSubsystemLocal = WorldLocal->GetSubsystem<UGrappleAnchorSubsystem>();
+	if (!EntitySubsystemLocal || !AnchorSubsystemLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleMassBenchmark: no Mass entity or grapple anchor subsystem in the game world"));
+		return 1;
+	}
+
+	// floor top at 0 for the arrival ground checks (the engine cube is 100 cm)
+	AStaticMeshActor* FloorLocal = WorldLocal->SpawnActor<AStaticMeshActor>(FVector(0.0, 0.0, -50.0), FRotator::ZeroRotator);
+	FloorLocal->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+	FloorLocal->GetStaticMeshComponent()->SetStaticMesh(MeshLocal);
+	FloorLocal->SetActorScale3D(FVector(GrappleMassBenchmark::AreaSize / 100.0, GrappleMassBenchmark::AreaSize / 100.0, 1.0));
+
+	const float HalfSizeLocal = static_cast<float>(GrappleMassBenchmark::AreaSize * 0.5);
+	for (int32 IndexLocal = 0; IndexLocal < NumAnchorsLocal; ++IndexLocal)
+	{
+		AnchorSubsystemLocal->RegisterAnchorPoint(FVector(RandomStreamLocal.FRandRange(-HalfSizeLocal, HalfSizeLocal), RandomStreamLocal.FRandRange(-HalfSizeLocal, HalfSizeLocal),
+			RandomStreamLocal.FRandRange(0.f, static_cast<float>(GrappleMassBenchmark::AreaHeight))));
+	}
+
+	// the fragments UGrappleMassTrait gives an entity config, with the default parameters
+	const FGrappleMassParameters ParametersLocal;
+	FMassArchetypeSharedFragmentValues SharedValuesLocal;
+	SharedValuesLocal.AddConstSharedFragment(EntitySubsystemLocal->GetOrCreateConstSharedFragment<FGrappleMassParameters>(UE::StructUtils::GetStructCrc32(FConstStructView::Make(ParametersLocal)), ParametersLocal));
+	SharedValuesLocal.Sort();
+	const FMassArchetypeHandle ArchetypeLocal = EntitySubsystemLocal->CreateArchetype({ FTransformFragment::StaticStruct(), FGrappleMassFragment::StaticStruct(), FGrappleMassActorFragment::StaticStruct() });
+
+	const double CreateStartLocal = FPlatformTime::Seconds();
+	TArray<FMassEntityHandle> EntitiesLocal;
+	EntitySubsystemLocal->BatchCreateEntities(ArchetypeLocal, SharedValuesLocal, NumAgentsLocal, EntitiesLocal);
+	for (const FMassEntityHandle& EntityLocal : EntitiesLocal)
+	{
+		EntitySubsystemLocal->GetFragmentDataChecked<FTransformFragment>(EntityLocal).GetMutableTransform().SetLocation(
+			FVector(RandomStreamLocal.FRandRange(-HalfSizeLocal, HalfSizeLocal), RandomStreamLocal.FRandRange(-HalfSizeLocal, HalfSizeLocal), ParametersLocal.CapsuleHalfHeight));
+		// spread the first shots over the idle time so the agents don't all fire the same frame
+		EntitySubsystemLocal->GetFragmentDataChecked<FGrappleMassFragment>(EntityLocal).PhaseTime = RandomStreamLocal.FRandRange(0.f, ParametersLocal.IdleTime);
+	}
+	const double CreateMsLocal = (FPlatformTime::Seconds() - CreateStartLocal) * 1000.0;
+
+	for (int32 FrameLocal = 0; FrameLocal < GrappleMassBenchmark::WarmUpFrames; ++FrameLocal)
+	{
+		WorldLocal->Tick(LEVELTICK_All, GrappleMassBenchmark::DeltaTime);
+	}
+
+#if GRAPPLE_INSTRUMENTATION_ENABLED
+	FGrappleStatTotals::Reset();
+	FGrappleStatTotals::SetEnabled(true);
+#endif
+	TArray<float> FrameMsLocal;
+	FrameMsLocal.Reserve(NumFramesLocal);
+	for (int32 FrameLocal = 0; FrameLocal < NumFramesLocal; ++FrameLocal)
+	{
+		const double StartLocal = FPlatformTime::Seconds();
+		WorldLocal->Tick(LEVELTICK_All, GrappleMassBenchmark::DeltaTime);
+		FrameMsLocal.Add(static_cast<float>((FPlatformTime::Seconds() - StartLocal) * 1000.0));
+	}
+#if GRAPPLE_INSTRUMENTATION_ENABLED
+	FGrappleStatTotals::SetEnabled(false);
+	const double PerFrameLocal = 1.0 / NumFramesLocal;
+	const double MovementMsLocal = FGrappleStatTotals::GetScopeMs(EGrappleStatScope::MassMovement) * PerFrameLocal;
+	const double QueriesMsLocal = FGrappleStatTotals::GetScopeMs(EGrappleStatScope::MassQueries) * PerFrameLocal;
+	const double PromotionMsLocal = FGrappleStatTotals::GetScopeMs(EGrappleStatScope::MassPromotion) * PerFrameLocal;
+#else
+	const double MovementMsLocal = 0.0;
+	const double QueriesMsLocal = 0.0;
+	const double PromotionMsLocal = 0.0;
+	UE_LOG(LogGrapple, Warning, TEXT("GrappleMassBenchmark: grapple instrumentation is compiled out, only the world tick is measured"));
+#endif
+
+	int32 NumPerPhaseLocal[static_cast<int32>(EGrappleMassPhase::Arrived) + 1]{};
+	for (const FMassEntityHandle& EntityLocal : EntitiesLocal)
+	{
+		++NumPerPhaseLocal[static_cast<int32>(EntitySubsystemLocal->GetFragmentDataChecked<FGrappleMassFragment>(EntityLocal).Phase)];
+	}
+
+	double TotalFrameMsLocal = 0.0;
+	for (const float FrameMsValueLocal : FrameMsLocal)
+	{
+		TotalFrameMsLocal += FrameMsValueLocal;
+	}
+	const double AverageFrameMsLocal = TotalFrameMsLocal / NumFramesLocal;
+	FrameMsLocal.Sort();
+	const bool bWithinBudgetLocal = AverageFrameMsLocal <= BudgetMsLocal;
+
+	UE_LOG(LogGrapple, Display, TEXT("GrappleMassBenchmark: %d agents created in %.2f ms, %d anchors, %d frames at %.0f Hz"),
+		EntitiesLocal.Num(), CreateMsLocal, NumAnchorsLocal, NumFramesLocal, 1.f / GrappleMassBenchmark::DeltaTime);
+	UE_LOG(LogGrapple, Display, TEXT("GrappleMassBenchmark: world tick %.3f ms per frame (p50 %.3f p95 %.3f max %.3f), processors movement %.3f queries %.3f promotion %.3f ms per frame (summed over threads)"),
+		AverageFrameMsLocal, GrappleCommandletUtils::GetPercentile(FrameMsLocal, 0.5), GrappleCommandletUtils::GetPercentile(FrameMsLocal, 0.95), FrameMsLocal.Last(),
+		MovementMsLocal, QueriesMsLocal, PromotionMsLocal);
+	UE_LOG(LogGrapple, Display, TEXT("GrappleMassBenchmark: last frame idle %d, hook flight %d, pull %d, ground check %d, arrived %d"),
+		NumPerPhaseLocal[static_cast<int32>(EGrappleMassPhase::Idle)], NumPerPhaseLocal[static_cast<int32>(EGrappleMassPhase::HookFlight)], NumPerPhaseLocal[static_cast<int32>(EGrappleMassPhase::Pull)],
+		NumPerPhaseLocal[static_cast<int32>(EGrappleMassPhase::GroundCheck)], NumPerPhaseLocal[static_cast<int32>(EGrappleMassPhase::Arrived)]);
+	if (!bWithinBudgetLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleMassBenchmark: %.3f ms per frame is over the %.1f ms budget"), AverageFrameMsLocal, BudgetMsLocal);
+	}
+
+	return bWithinBudgetLocal ? 0 : 1;
+}
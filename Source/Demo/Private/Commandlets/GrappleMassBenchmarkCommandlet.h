@@ -0,0 +1,35 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GrappleMassBenchmarkCommandlet.generated.h"
+
+/**
+ * Crowd grappler cost: creates Mass grappler entities (the fragments of UGrappleMassTrait) over a floor with random anchor points in an empty
+ * game world and ticks it, the Mass processors running as they do in game. Logs the world tick and each grapple processor in ms per frame
+ * (from FGrappleStatTotals, so not in Shipping) and how many entities were in each phase, and fails if the world tick exceeds -BudgetMs.
+ *
+ * UnrealEditor-Cmd.exe Demo.uproject -run=GrappleMassBenchmark -nullrhi -unattended [-Agents=5000] [-Anchors=2000] [-Frames=300] [-BudgetMs=4] [-Seed=1234]
+ */
+UCLASS()
+class UGrappleMassBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleMassBenchmarkCommandlet();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual int32 Main(const FString& Params) override;
+};
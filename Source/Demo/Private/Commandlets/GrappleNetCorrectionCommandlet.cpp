@@ -0,0 +1,253 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleNetCorrectionCommandlet.h"
+#include "Character/GrappleInputRecording.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Demo.h"
+
+namespace GrappleNetCorrection
+{
+	/** Scripted session timing, in 60 Hz frames */
+	constexpr float ScriptDeltaTime = 1.f / 60.f;
+	constexpr int32 ScriptTurnFrames = 30;
+	constexpr int32 ScriptHoldFrames = 150;
+	constexpr int32 ScriptJumpFrames = 10;
+	constexpr int32 ScriptWalkFrames = 90;
+	/** Looking up this much finds anchors above the surrounding geometry */
+	constexpr float ScriptPitch = 25.f;
+
+	/**
+	 * A session that needs no recorded file: turns to a new heading, fires, hangs on for the pull and the arrival hold, jumps off
+	 * and walks on, NumGrapples times. Switches to first person halfway, both views arrive differently.
+	 */
+	FGrappleInputRecording MakeScriptedRecording(const FString& MapName, int32 NumGrapples)
+	{
+		FGrappleInputRecording RecordingLocal;
+		RecordingLocal.MapName = MapName;
+		auto AddFrameLocal = [&RecordingLocal](float Forward, const FRotator& ControlRotation, EGrappleInputAction Actions)
+		{
+			FGrappleInputFrame& FrameLocal = RecordingLocal.Frames.AddDefaulted_GetRef();
+			FrameLocal.DeltaTime = ScriptDeltaTime;
+			FrameLocal.Forward = Forward;
+			FrameLocal.SetControlRotation(ControlRotation);
+			FrameLocal.Actions = Actions;
+		};
+
+		FRotator ControlRotationLocal(ScriptPitch, 0.f, 0.f);
+		for (int32 GrappleLocal = 0; GrappleLocal < NumGrapples; ++GrappleLocal)
+		{
+			// a heading that doesn't repeat soon (golden angle)
+			const float StartYawLocal = ControlRotationLocal.Yaw;
+			const float EndYawLocal = StartYawLocal + 137.5f;
+			for (int32 FrameLocal = 1; FrameLocal <= ScriptTurnFrames; ++FrameLocal)
+			{
+				ControlRotationLocal.Yaw = FMath::Lerp(StartYawLocal, EndYawLocal, static_cast<float>(FrameLocal) / ScriptTurnFrames);
+				const bool bSwitchLocal = FrameLocal == 1 && GrappleLocal == NumGrapples / 2;
+				AddFrameLocal(0.f, ControlRotationLocal, bSwitchLocal ? EGrappleInputAction::SwitchCamera : EGrappleInputAction::None);
+			}
+			ControlRotationLocal.Yaw = FRotator::NormalizeAxis(EndYawLocal);
+			AddFrameLocal(0.f, ControlRotationLocal, EGrappleInputAction::Grapple);
+			for (int32 FrameLocal = 0; FrameLocal < ScriptHoldFrames; ++FrameLocal)
+			{
+				AddFrameLocal(0.f, ControlRotationLocal, EGrappleInputAction::None);
+			}
+			AddFrameLocal(0.f, ControlRotationLocal, EGrappleInputAction::JumpPressed);
+			for (int32 FrameLocal = 0; FrameLocal < ScriptJumpFrames; ++FrameLocal)
+			{
+				AddFrameLocal(0.f, ControlRotationLocal, EGrappleInputAction::None);
+			}
+			AddFrameLocal(0.f, ControlRotationLocal, EGrappleInputAction::JumpReleased);
+			for (int32 FrameLocal = 0; FrameLocal < ScriptWalkFrames; ++FrameLocal)
+			{
+				AddFrameLocal(1.f, ControlRotationLocal, EGrappleInputAction::None);
+			}
+		}
+		RecordingLocal.StartControlRotation = RecordingLocal.Frames[0].GetControlRotation();
+		return RecordingLocal;
+	}
+
+	/** Starts this executable as a hidden game process on the project */
+	FProcHandle Launch(const FString& Arguments)
+	{
+		const FString ParamsLocal = FString::Printf(TEXT("\"%s\" %s"), *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()), *Arguments);
+		UE_LOG(LogGrapple, Display, TEXT("GrappleNetCorrection: starting %s"), *ParamsLocal);
+		return FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *ParamsLocal, true, true, true, nullptr, 0, nullptr, nullptr);
+	}
+
+	/** Stops a process that is still running and releases its handle */
+	void Close(FProcHandle& Process)
+	{
+		if (FPlatformProcess::IsProcRunning(Process))
+		{
+			FPlatformProcess::TerminateProc(Process, true);
+		}
+		FPlatformProcess::CloseProc(Process);
+	}
+}
+
+UGrappleNetCorrectionCommandlet::UGrappleNetCorrectionCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGrappleNetCorrectionCommandlet::Main(const FString& Params)
+{
+	const FString OutputDirLocal = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("GrappleNetCorrection"));
+	FString RecordingFileLocal;
+	FGrappleInputRecording RecordingLocal;
+	if (FParse::Value(*Params, TEXT("Recording="), RecordingFileLocal))
+	{
+		RecordingFileLocal = FPaths::ConvertRelativePathToFull(RecordingFileLocal);
+		if (!RecordingLocal.LoadFromFile(RecordingFileLocal) || RecordingLocal.Frames.Num() == 0)
+		{
+			UE_LOG(LogGrapple, Error, TEXT("GrappleNetCorrection: can't read %s"), *RecordingFileLocal);
+			return 1;
+		}
+	}
+	else
+	{
+		FString ScriptMapNameLocal(TEXT("/Game/Maps/ThirdPersonMap"));
+		int32 NumGrapplesLocal = 12;
+		FParse::Value(*Params, TEXT("Map="), ScriptMapNameLocal);
+		FParse::Value(*Params, TEXT("Grapples="), NumGrapplesLocal);
+		RecordingLocal = GrappleNetCorrection::MakeScriptedRecording(ScriptMapNameLocal, FMath::Max(NumGrapplesLocal, 1));
+		// the client loads it like any recording
+		RecordingFileLocal = OutputDirLocal / TEXT("Scripted.grapplerec");
+		if (!RecordingLocal.SaveToFile(RecordingFileLocal))
+		{
+			UE_LOG(LogGrapple, Error, TEXT("GrappleNetCorrection: can't write %s"), *RecordingFileLocal);
+			return 1;
+		}
+	}
+
+	FString MapNameLocal = RecordingLocal.MapName;
+	int32 PktLagLocal = 100;
+	int32 PktLossLocal = 5;
+	int32 PortLocal = 17777;
+	float MaxGrappleCorrectionsLocal = 0.5f;
+	float ServerStartupLocal = 10.f;
+	double TimeoutLocal = RecordingLocal.GetDuration() * 2.0 + 120.0;
+	FParse::Value(*Params, TEXT("Map="), MapNameLocal);
+	FParse::Value(*Params, TEXT("PktLag="), PktLagLocal);
+	FParse::Value(*Params, TEXT("PktLoss="), PktLossLocal);
+	FParse::Value(*Params, TEXT("Port="), PortLocal);
+	FParse::Value(*Params, TEXT("MaxGrappleCorrections="), MaxGrappleCorrectionsLocal);
+	FParse::Value(*Params, TEXT("ServerStartup="), ServerStartupLocal);
+	FParse::Value(*Params, TEXT("Timeout="), TimeoutLocal);
+
+	const bool bNetTraceLocal = FParse::Param(*Params, TEXT("NetTrace"));
+
+	// a report left by an earlier run would pass for this one
+	const FString ReportFileLocal = OutputDirLocal / TEXT("ClientReport.txt");
+	const FString BandwidthFileLocal = OutputDirLocal / TEXT("ObserverReport.txt");
+	IFileManager::Get().Delete(*ReportFileLocal, false, true, true);
+	IFileManager::Get().Delete(*BandwidthFileLocal, false, true, true);
+
+	// both sides simulate the bad connection on what they send
+	const FString GameParamsLocal = FString::Printf(TEXT("-game -nullrhi -nosound -nosplash -unattended -PktLag=%d -PktLoss=%d"), PktLagLocal, PktLossLocal);
+	FProcHandle ServerLocal = GrappleNetCorrection::Launch(FString::Printf(TEXT("%s?listen %s -port=%d -log=GrappleNetServer.log%s"), *MapNameLocal, *GameParamsLocal, PortLocal,
+		bNetTraceLocal ? TEXT(" -NetTrace=1 -trace=net -tracefile=GrappleNetServer.utrace") : TEXT("")));
+	if (!ServerLocal.IsValid())
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleNetCorrection: can't start the server"));
+		return 1;
+	}
+	FPlatformProcess::Sleep(ServerStartupLocal);
+	// the grapple state only goes to simulated proxies, a second client sees the replaying character as one
+	FProcHandle ObserverLocal = GrappleNetCorrection::Launch(FString::Printf(TEXT("127.0.0.1:%d %s -log=GrappleNetObserver.log -ExecCmds=\"Grapple.Net.MeasureBandwidth %.1f %s\""),
+		PortLocal, *GameParamsLocal, RecordingLocal.GetDuration(), *BandwidthFileLocal));
+	if (!ObserverLocal.IsValid())
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleNetCorrection: can't start the observer"));
+		GrappleNetCorrection::Close(ServerLocal);
+		return 1;
+	}
+	FProcHandle ClientLocal = GrappleNetCorrection::Launch(FString::Printf(TEXT("127.0.0.1:%d %s -log=GrappleNetClient.log -ExecCmds=\"Grapple.Replay.Start %s %s\""),
+		PortLocal, *GameParamsLocal, *RecordingFileLocal, *ReportFileLocal));
+	if (!ClientLocal.IsValid())
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleNetCorrection: can't start the client"));
+		GrappleNetCorrection::Close(ObserverLocal);
+		GrappleNetCorrection::Close(ServerLocal);
+		return 1;
+	}
+
+	// the client quits by itself once its report is written
+	const double StartSecondsLocal = FPlatformTime::Seconds();
+	while (FPlatformProcess::IsProcRunning(ClientLocal) && FPlatformTime::Seconds() - StartSecondsLocal < TimeoutLocal)
+	{
+		FPlatformProcess::Sleep(0.5f);
+	}
+	const bool bTimedOutLocal = FPlatformProcess::IsProcRunning(ClientLocal);
+	GrappleNetCorrection::Close(ClientLocal);
+	// the observer measures for the length of the recording from when it saw the character, it finishes shortly after the client
+	while (FPlatformProcess::IsProcRunning(ObserverLocal) && FPlatformTime::Seconds() - StartSecondsLocal < TimeoutLocal)
+	{
+		FPlatformProcess::Sleep(0.5f);
+	}
+	GrappleNetCorrection::Close(ObserverLocal);
+	GrappleNetCorrection::Close(ServerLocal);
+
+	FString ReportLocal;
+	if (!FFileHelper::LoadFileToString(ReportLocal, *ReportFileLocal))
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleNetCorrection: no report from the client%s, see GrappleNetClient.log and GrappleNetServer.log"), bTimedOutLocal ? TEXT(" (timed out)") : TEXT(""));
+		return 1;
+	}
+	int32 FramesLocal = 0;
+	int32 RecordedFramesLocal = 0;
+	int32 GrapplesLocal = 0;
+	int32 CorrectionsLocal = 0;
+	int32 GrappleCorrectionsLocal = 0;
+	FParse::Value(*ReportLocal, TEXT("Replayed="), FramesLocal);
+	FParse::Value(*ReportLocal, TEXT("Recorded="), RecordedFramesLocal);
+	FParse::Value(*ReportLocal, TEXT("Grapples="), GrapplesLocal);
+	FParse::Value(*ReportLocal, TEXT("Corrections="), CorrectionsLocal);
+	FParse::Value(*ReportLocal, TEXT("WhileGrappling="), GrappleCorrectionsLocal);
+
+	const float GrappleCorrectionsPerGrappleLocal = GrapplesLocal > 0 ? static_cast<float>(GrappleCorrectionsLocal) / GrapplesLocal : 0.f;
+	UE_LOG(LogGrapple, Display, TEXT("GrappleNetCorrection: %d ms lag, %d%% loss, %d of %d frames replayed, %d grapples, %d corrections, %d with the grapple active (%.2f per grapple, max %.2f)"),
+		PktLagLocal, PktLossLocal, FramesLocal, RecordedFramesLocal, GrapplesLocal, CorrectionsLocal, GrappleCorrectionsLocal, GrappleCorrectionsPerGrappleLocal, MaxGrappleCorrectionsLocal);
+
+	FString BandwidthLocal;
+	if (FFileHelper::LoadFileToString(BandwidthLocal, *BandwidthFileLocal))
+	{
+		double IdleBytesPerSecondLocal = 0.0;
+		double BytesPerSecondLocal = 0.0;
+		double SecondsLocal = 0.0;
+		FParse::Value(*BandwidthLocal, TEXT("Idle="), IdleBytesPerSecondLocal);
+		FParse::Value(*BandwidthLocal, TEXT("InView="), BytesPerSecondLocal);
+		FParse::Value(*BandwidthLocal, TEXT("Seconds="), SecondsLocal);
+		UE_LOG(LogGrapple, Display, TEXT("GrappleNetCorrection: observer received %.0f B/s idle, %.0f B/s over %.1f s with the grappling character in view, %.0f B/s for that character"),
+			IdleBytesPerSecondLocal, BytesPerSecondLocal, SecondsLocal, BytesPerSecondLocal - IdleBytesPerSecondLocal);
+	}
+	else
+	{
+		UE_LOG(LogGrapple, Warning, TEXT("GrappleNetCorrection: no bandwidth report from the observer, see GrappleNetObserver.log"));
+	}
+
+	int32 NumFailuresLocal = 0;
+	if (FramesLocal < RecordedFramesLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleNetCorrection: the client stopped replaying after %d of %d frames (lost its character)"), FramesLocal, RecordedFramesLocal);
+		++NumFailuresLocal;
+	}
+	if (GrapplesLocal == 0)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleNetCorrection: the recording fires no grapple"));
+		++NumFailuresLocal;
+	}
+	if (GrappleCorrectionsPerGrappleLocal > MaxGrappleCorrectionsLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleNetCorrection: %.2f corrections per grapple, over the %.2f allowed"), GrappleCorrectionsPerGrappleLocal, MaxGrappleCorrectionsLocal);
+		++NumFailuresLocal;
+	}
+	return NumFailuresLocal > 0 ? 1 : 0;
+}
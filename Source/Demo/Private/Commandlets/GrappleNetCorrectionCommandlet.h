@@ -0,0 +1,47 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GrappleNetCorrectionCommandlet.generated.h"
+
+/**
+ * Counts the movement corrections a client gets while grappling over a bad connection: starts a listen server on the recorded map and a client
+ * connecting to it on localhost, both as -game processes of this executable with the engine's packet lag and loss simulation (applied to what each
+ * side sends, so the round trip is about twice -PktLag). The client replays grapple input (Grapple.Replay.Start) once it has a character, then
+ * reports the corrections it received and quits. Fails if the client didn't finish the input, fired no grapple, or got more than
+ * -MaxGrappleCorrections corrections per grapple with the grapple active. The processes log to Saved/Logs/GrappleNetServer.log and GrappleNetClient.log.
+ *
+ * A second client (GrappleNetObserver.log) sees the replaying character as a simulated proxy, the only connection its grapple state goes to, and
+ * reports the bytes/s it received idle and then while the character was in view (Grapple.Net.MeasureBandwidth), the difference being that
+ * character's cost. Sent packets the loss simulation drops aren't counted. -NetTrace also writes a Networking Insights trace of the server
+ * (GrappleNetServer.utrace) for the per property breakdown.
+ *
+ * Without -Recording the input is scripted: -Grapples times turn to a new heading looking up, fire, hang on through the arrival, jump off and walk
+ * on, switching to first person halfway. A recording must start at the player start, the client can't put its character where it started.
+ * Paths can't contain spaces (they go through -ExecCmds).
+ *
+ * UnrealEditor-Cmd.exe Demo.uproject -run=GrappleNetCorrection [-Recording=<file>] [-Map=/Game/Maps/ThirdPersonMap] [-Grapples=12] [-PktLag=100] [-PktLoss=5]
+ *   [-Port=17777] [-MaxGrappleCorrections=0.5] [-ServerStartup=10] [-NetTrace] [-Timeout=<seconds, by default twice the input plus 120>]
+ */
+UCLASS()
+class UGrappleNetCorrectionCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleNetCorrectionCommandlet();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,168 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleProfileBenchmarkCommandlet.h"
+#include "GrappleCommandletUtils.h"
+#include "Character/GrappleCharacter.h"
+#include "Engine/World.h"
+#include "Demo.h"
+
+namespace GrappleProfileBenchmark
+{
+	constexpr float DeltaTime = 1.f / 60.f;
+	constexpr double Spacing = 300.0;
+
+	/** Forwards everything to the real allocator, counting the allocations */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override { ++NumAllocations; return Inner->Malloc(Count, Alignment); }
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override { ++NumAllocations; return Inner->TryMalloc(Count, Alignment); }
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override { ++NumAllocations; return Inner->Realloc(Original, Count, Alignment); }
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override { ++NumAllocations; return Inner->TryRealloc(Original, Count, Alignment); }
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+		TAtomic<int64> NumAllocations{ 0 };
+
+	private:
+		FMalloc* Inner;
+	};
+
+	/** How the benchmark reads the settings */
+	enum class EReadMode : uint8
+	{
+		ConstRef,
+		Copy,
+		Blueprint,
+	};
+
+	/** Reads both arrays of every character Reads times per frame for NumFrames frames, returns the allocations per frame */
+	double CountAllocations(UWorld* World, TConstArrayView<AGrappleCharacter*> Characters, EReadMode Mode, int32 Reads, int32 NumFrames)
+	{
+		UFunction* TargetsFunctionLocal = AGrappleCharacter::StaticClass()->FindFunctionByName(TEXT("GetGrapplableTargets"));
+		UFunction* IgnoreFunctionLocal = AGrappleCharacter::StaticClass()->FindFunctionByName(TEXT("GetActorsToIgnore"));
+		// blueprint calls get their parameters the way the VM would, zeroed frame memory with the return value at the end
+		TArray<uint8> ParmsLocal;
+		ParmsLocal.SetNumZeroed(FMath::Max(TargetsFunctionLocal->ParmsSize, IgnoreFunctionLocal->ParmsSize));
+
+		int64 NumReadLocal = 0;
+		World->Tick(LEVELTICK_All, DeltaTime);
+
+		FMalloc* InnerLocal = GMalloc;
+		FCountingMalloc CountingLocal(InnerLocal);
+		GMalloc = &CountingLocal;
+		for (int32 FrameLocal = 0; FrameLocal < NumFrames; ++FrameLocal)
+		{
+			for (AGrappleCharacter* CharacterLocal : Characters)
+			{
+				for (int32 ReadLocal = 0; ReadLocal < Reads; ++ReadLocal)
+				{
+					if (Mode == EReadMode::ConstRef)
+					{
+						NumReadLocal += CharacterLocal->GetGrapplableTargets().Num() + CharacterLocal->GetActorsToIgnore().Num();
+					}
+					else if (Mode == EReadMode::Copy)
+					{
+						const TArray<TEnumAsByte<EObjectTypeQuery>> TargetsLocal = CharacterLocal->GetGrapplableTargets();
+						const TArray<AActor*> IgnoreLocal = CharacterLocal->GetActorsToIgnore();
+						NumReadLocal += TargetsLocal.Num() + IgnoreLocal.Num();
+					}
+					else
+					{
+						for (UFunction* FunctionLocal : { TargetsFunctionLocal, IgnoreFunctionLocal })
+						{
+							FunctionLocal->InitializeStruct(ParmsLocal.GetData());
+							CharacterLocal->ProcessEvent(FunctionLocal, ParmsLocal.GetData());
+							FunctionLocal->DestroyStruct(ParmsLocal.GetData());
+							++NumReadLocal;
+						}
+					}
+				}
+			}
+			World->Tick(LEVELTICK_All, DeltaTime);
+		}
+		GMalloc = InnerLocal;
+
+		UE_LOG(LogGrapple, Verbose, TEXT("GrappleProfileBenchmark: %lld entries read"), NumReadLocal);
+		return static_cast<double>(CountingLocal.NumAllocations.Load()) / NumFrames;
+	}
+}
+
+UGrappleProfileBenchmarkCommandlet::UGrappleProfileBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGrappleProfileBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString CharacterClassNameLocal(TEXT("/Game/Core/Character/BP_GrappleCharacter"));
+	int32 NumCharactersLocal = 100;
+	int32 NumFramesLocal = 100;
+	int32 NumReadsLocal = 4;
+	FParse::Value(*Params, TEXT("Character="), CharacterClassNameLocal);
+	FParse::Value(*Params, TEXT("Characters="), NumCharactersLocal);
+	FParse::Value(*Params, TEXT("Frames="), NumFramesLocal);
+	FParse::Value(*Params, TEXT("Reads="), NumReadsLocal);
+	NumCharactersLocal = FMath::Max(NumCharactersLocal, 1);
+	NumFramesLocal = FMath::Max(NumFramesLocal, 1);
+	NumReadsLocal = FMath::Max(NumReadsLocal, 1);
+
+	UClass* CharacterClassLocal = GrappleCommandletUtils::LoadCharacterClass(CharacterClassNameLocal);
+	if (!CharacterClassLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleProfileBenchmark: can't load character class %s"), *CharacterClassNameLocal);
+		return 1;
+	}
+
+	const FGrappleHeadlessWorld HeadlessWorldLocal;
+	UWorld* WorldLocal = HeadlessWorldLocal.Get();
+
+	TArray<AGrappleCharacter*> CharactersLocal;
+	for (int32 IndexLocal = 0; IndexLocal < NumCharactersLocal; ++IndexLocal)
+	{
+		FActorSpawnParameters SpawnParametersLocal;
+		SpawnParametersLocal.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		if (AGrappleCharacter* CharacterLocal = WorldLocal->SpawnActor<AGrappleCharacter>(CharacterClassLocal, FVector(IndexLocal * GrappleProfileBenchmark::Spacing, 0.0, 100.0), FRotator::ZeroRotator, SpawnParametersLocal))
+		{
+			CharactersLocal.Add(CharacterLocal);
+		}
+	}
+	if (CharactersLocal.Num() == 0)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleProfileBenchmark: no character spawned"));
+		return 1;
+	}
+
+	// the world's own allocations are in every run, only the differences between runs come from the reads
+	const double ConstRefLocal = GrappleProfileBenchmark::CountAllocations(WorldLocal, CharactersLocal, GrappleProfileBenchmark::EReadMode::ConstRef, NumReadsLocal, NumFramesLocal);
+	const double CopyLocal = GrappleProfileBenchmark::CountAllocations(WorldLocal, CharactersLocal, GrappleProfileBenchmark::EReadMode::Copy, NumReadsLocal, NumFramesLocal);
+	const double BlueprintLocal = GrappleProfileBenchmark::CountAllocations(WorldLocal, CharactersLocal, GrappleProfileBenchmark::EReadMode::Blueprint, NumReadsLocal, NumFramesLocal);
+	UE_LOG(LogGrapple, Display, TEXT("GrappleProfileBenchmark: %d characters, %d reads each per frame, allocations per frame: const ref %.1f, by value (old getters) %.1f, blueprint getters %.1f"),
+		CharactersLocal.Num(), NumReadsLocal, ConstRefLocal, CopyLocal, BlueprintLocal);
+
+	// the settings the character used to own: both arrays (self was always in the actors to ignore) and the tuning values, now one pointer each plus the overrides
+	const AGrappleCharacter* CharacterLocal = CharactersLocal[0];
+	const UGrappleProfileDataAsset& ProfileLocal = CharacterLocal->GetGrappleProfile();
+	const SIZE_T OldInlineLocal = sizeof(TArray<TEnumAsByte<EObjectTypeQuery>>) + sizeof(TArray<AActor*>) + (6 * sizeof(float)) + sizeof(FVector) + (2 * sizeof(bool)) + sizeof(FGrappleTetherSettings);
+	const SIZE_T OldHeapLocal = ProfileLocal.GetGrapplableTargets().GetAllocatedSize() + FMemory::QuantizeSize(sizeof(AActor*), DEFAULT_ALIGNMENT);
+	const SIZE_T NewInlineLocal = sizeof(TArray<TEnumAsByte<EObjectTypeQuery>>) + sizeof(TArray<AActor*>) + (3 * sizeof(void*)) + sizeof(FGrappleProfileOverrides);
+	const SIZE_T NewHeapLocal = CharacterLocal->GetActorsToIgnore().GetAllocatedSize() + (&CharacterLocal->GetGrapplableTargets() != &ProfileLocal.GetGrapplableTargets() ? CharacterLocal->GetGrapplableTargets().GetAllocatedSize() : 0);
+	UE_LOG(LogGrapple, Display, TEXT("GrappleProfileBenchmark: grapple settings per character, old %llu B inline + %llu B heap (2 allocations), now %llu B inline + %llu B heap"),
+		static_cast<uint64>(OldInlineLocal), static_cast<uint64>(OldHeapLocal), static_cast<uint64>(NewInlineLocal), static_cast<uint64>(NewHeapLocal));
+
+	return 0;
+}
@@ -0,0 +1,36 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GrappleProfileBenchmarkCommandlet.generated.h"
+
+/**
+ * Measures what the shared grapple profiles save: spawns grapple characters in an empty game world and reads their grapplable targets and
+ * actors to ignore a few times per character per frame, once through the const reference accessors, once copying them like the old by value
+ * getters did and once through the blueprint getters. Logs the heap allocations per frame of each run (counted on every thread while the
+ * frames run) and the grapple settings memory per character, now and as it was with per character arrays and values.
+ *
+ * UnrealEditor-Cmd.exe Demo.uproject -run=GrappleProfileBenchmark [-Character=/Game/Core/Character/BP_GrappleCharacter] [-Characters=100] [-Frames=100] [-Reads=4]
+ */
+UCLASS()
+class UGrappleProfileBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleProfileBenchmarkCommandlet();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,194 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleReplayCommandlet.h"
+#include "GrappleCommandletUtils.h"
+#include "Character/GrappleCharacter.h"
+#include "Character/GrappleInputRecorderComponent.h"
+#include "Character/GrappleInputRecording.h"
+#include "Grapple/GrappleStats.h"
+#include "Engine/Engine.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/App.h"
+#include "Misc/Crc.h"
+#include "Demo.h"
+
+namespace GrappleReplay
+{
+	/** Outcome of one pass over the recording */
+	struct FLoopResult
+	{
+		double WallSeconds{ 0.0 };
+		TArray<float> FrameMs;
+		double GrappleMs{ 0.0 };
+		uint64 Traces{ 0 };
+		/** Furthest the replay got from a recorded checkpoint (cm) */
+		double MaxDrift{ 0.0 };
+		/** CRC of the replayed checkpoint locations and the final location */
+		uint32 Fingerprint{ 0 };
+		FVector FinalLocation{ 0.f };
+	};
+
+	double GetGrappleMs()
+	{
+#if GRAPPLE_INSTRUMENTATION_ENABLED
+		// the scopes nested in Pull (RopeWrap, ArrivalTrace) are already in it
+		return FGrappleStatTotals::GetScopeMs(EGrappleStatScope::Fire) + FGrappleStatTotals::GetScopeMs(EGrappleStatScope::Begin) + FGrappleStatTotals::GetScopeMs(EGrappleStatScope::HookFlight)
+			+ FGrappleStatTotals::GetScopeMs(EGrappleStatScope::Pull) + FGrappleStatTotals::GetScopeMs(EGrappleStatScope::RopeBatch);
+#else
+		return 0.0;
+#endif
+	}
+
+	uint64 GetTraces()
+	{
+#if GRAPPLE_INSTRUMENTATION_ENABLED
+		return FGrappleStatTotals::GetCount(EGrappleStatCounter::Traces);
+#else
+		return 0;
+#endif
+	}
+
+	/** Spawns a fresh character and player controller at the recorded start and feeds it every recorded frame */
+	FLoopResult Run(UWorld* World, UClass* CharacterClass, const FGrappleInputRecording& Recording)
+	{
+		FLoopResult ResultLocal;
+
+		FActorSpawnParameters SpawnParametersLocal;
+		SpawnParametersLocal.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AGrappleCharacter* CharacterLocal = World->SpawnActor<AGrappleCharacter>(CharacterClass, Recording.StartLocation, Recording.StartRotation, SpawnParametersLocal);
+		APlayerController* ControllerLocal = CharacterLocal ? World->SpawnActor<APlayerController>() : nullptr;
+		if (!ControllerLocal)
+		{
+			UE_LOG(LogGrapple, Error, TEXT("GrappleReplay: can't spawn %s"), *CharacterClass->GetName());
+			return ResultLocal;
+		}
+		// a local player stand-in, so the character runs the locally controlled player paths it was recorded on (aim probe and aim assist,
+		// no AI substep budget or significance cap) and the controller ticks its camera manager like in the game
+		ULocalPlayer* LocalPlayerLocal = NewObject<ULocalPlayer>(GEngine, GEngine->LocalPlayerClass);
+		ControllerLocal->SetPlayer(LocalPlayerLocal);
+		ControllerLocal->Possess(CharacterLocal);
+		UGrappleInputRecorderComponent::BeginReplay(CharacterLocal, Recording);
+
+#if GRAPPLE_INSTRUMENTATION_ENABLED
+		FGrappleStatTotals::Reset();
+		FGrappleStatTotals::SetEnabled(true);
+#endif
+		TArray<FVector3f> CheckpointsLocal;
+		ResultLocal.FrameMs.Reserve(Recording.Frames.Num());
+		const double StartLocal = FPlatformTime::Seconds();
+		for (int32 FrameIndexLocal = 0; FrameIndexLocal < Recording.Frames.Num(); ++FrameIndexLocal)
+		{
+			const FGrappleInputFrame& FrameLocal = Recording.Frames[FrameIndexLocal];
+			if (FGrappleInputRecording::IsCheckpoint(FrameIndexLocal))
+			{
+				const FVector3f LocationLocal(CharacterLocal->GetActorLocation());
+				CheckpointsLocal.Add(LocationLocal);
+				ResultLocal.MaxDrift = FMath::Max(ResultLocal.MaxDrift, static_cast<double>(FVector3f::Dist(LocationLocal, FrameLocal.Location)));
+			}
+
+			const double FrameStartLocal = FPlatformTime::Seconds();
+			UGrappleInputRecorderComponent::ReplayFrame(CharacterLocal, FrameLocal);
+			FApp::SetDeltaTime(FrameLocal.DeltaTime);
+			FApp::SetCurrentTime(FApp::GetCurrentTime() + FrameLocal.DeltaTime);
+			World->Tick(LEVELTICK_All, FrameLocal.DeltaTime);
+			GEngine->ConditionalCollectGarbage();
+			ResultLocal.FrameMs.Add(static_cast<float>((FPlatformTime::Seconds() - FrameStartLocal) * 1000.0));
+		}
+		ResultLocal.WallSeconds = FPlatformTime::Seconds() - StartLocal;
+#if GRAPPLE_INSTRUMENTATION_ENABLED
+		FGrappleStatTotals::SetEnabled(false);
+#endif
+		ResultLocal.GrappleMs = GetGrappleMs();
+		ResultLocal.Traces = GetTraces();
+		ResultLocal.FinalLocation = CharacterLocal->GetActorLocation();
+		CheckpointsLocal.Add(FVector3f(ResultLocal.FinalLocation));
+		ResultLocal.Fingerprint = FCrc::MemCrc32(CheckpointsLocal.GetData(), CheckpointsLocal.Num() * CheckpointsLocal.GetTypeSize());
+		ResultLocal.FrameMs.Sort();
+
+		ControllerLocal->UnPossess();
+		ControllerLocal->Destroy();
+		LocalPlayerLocal->PlayerController = nullptr;
+		CharacterLocal->Destroy();
+		return ResultLocal;
+	}
+}
+
+UGrappleReplayCommandlet::UGrappleReplayCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGrappleReplayCommandlet::Main(const FString& Params)
+{
+	FString RecordingFileLocal;
+	if (!FParse::Value(*Params, TEXT("Recording="), RecordingFileLocal))
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleReplay: missing -Recording=<file>"));
+		return 1;
+	}
+	FGrappleInputRecording RecordingLocal;
+	if (!RecordingLocal.LoadFromFile(RecordingFileLocal) || RecordingLocal.Frames.Num() == 0)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleReplay: can't read %s"), *RecordingFileLocal);
+		return 1;
+	}
+
+	FString MapNameLocal = RecordingLocal.MapName;
+	FString CharacterClassNameLocal = RecordingLocal.CharacterClassPath;
+	int32 NumLoopsLocal = 1;
+	FParse::Value(*Params, TEXT("Map="), MapNameLocal);
+	FParse::Value(*Params, TEXT("Character="), CharacterClassNameLocal);
+	FParse::Value(*Params, TEXT("Loops="), NumLoopsLocal);
+	NumLoopsLocal = FMath::Max(NumLoopsLocal, 1);
+
+	UClass* CharacterClassLocal = GrappleCommandletUtils::LoadCharacterClass(CharacterClassNameLocal);
+	if (!CharacterClassLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleReplay: can't load character class %s"), *CharacterClassNameLocal);
+		return 1;
+	}
+
+	// the game mode gives the player controller its player state, the character only counts as player controlled with one
+	const FGrappleHeadlessWorld HeadlessWorldLocal(MapNameLocal, true);
+	UWorld* WorldLocal = HeadlessWorldLocal.Get();
+	if (!WorldLocal)
+	{
+		return 1;
+	}
+
+	const double RecordedSecondsLocal = RecordingLocal.GetDuration();
+	int32 NumMismatchesLocal = 0;
+	uint32 FirstFingerprintLocal = 0;
+	for (int32 LoopLocal = 0; LoopLocal < NumLoopsLocal; ++LoopLocal)
+	{
+		const GrappleReplay::FLoopResult ResultLocal = GrappleReplay::Run(WorldLocal, CharacterClassLocal, RecordingLocal);
+		if (ResultLocal.FrameMs.Num() == 0)
+		{
+			++NumMismatchesLocal;
+			break;
+		}
+		const double PerFrameLocal = 1.0 / ResultLocal.FrameMs.Num();
+		UE_LOG(LogGrapple, Display, TEXT("GrappleReplay: loop %d, %d frames, %.1f s recorded in %.2f s (x%.1f), frame ms p50 %.3f p95 %.3f p99 %.3f max %.3f, grapple %.4f ms and %.2f traces per frame, max drift %.2f cm, final %s, fingerprint %08x"),
+			LoopLocal, ResultLocal.FrameMs.Num(), RecordedSecondsLocal, ResultLocal.WallSeconds, RecordedSecondsLocal / FMath::Max(ResultLocal.WallSeconds, SMALL_NUMBER),
+			GrappleCommandletUtils::GetPercentile(ResultLocal.FrameMs, 0.5), GrappleCommandletUtils::GetPercentile(ResultLocal.FrameMs, 0.95), GrappleCommandletUtils::GetPercentile(ResultLocal.FrameMs, 0.99), ResultLocal.FrameMs.Last(),
+			ResultLocal.GrappleMs * PerFrameLocal, ResultLocal.Traces * PerFrameLocal, ResultLocal.MaxDrift, *ResultLocal.FinalLocation.ToString(), ResultLocal.Fingerprint);
+
+		if (LoopLocal == 0)
+		{
+			FirstFingerprintLocal = ResultLocal.Fingerprint;
+		}
+		else if (ResultLocal.Fingerprint != FirstFingerprintLocal)
+		{
+			UE_LOG(LogGrapple, Error, TEXT("GrappleReplay: loop %d didn't reproduce loop 0 (fingerprint %08x, expected %08x)"), LoopLocal, ResultLocal.Fingerprint, FirstFingerprintLocal);
+			++NumMismatchesLocal;
+		}
+	}
+
+	return NumMismatchesLocal > 0 ? 1 : 0;
+}
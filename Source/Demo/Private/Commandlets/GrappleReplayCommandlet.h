@@ -0,0 +1,40 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GrappleReplayCommandlet.generated.h"
+
+/**
+ * Replays a grapple input recording (Grapple.Record.Start/Stop) headless and as fast as the machine goes: loads the recorded map as a game world,
+ * spawns the recorded character class at the recorded start, possessed by a player controller with a local player stand-in so it runs the player's
+ * code paths, and feeds it one recorded frame per world tick, with the recorded frame times.
+ * Logs the speed up over real time, frame ms percentiles, grapple ms and traces per frame, and the drift from the recorded checkpoints.
+ * Every loop ends with a fingerprint of the replayed checkpoints; loops that don't reproduce the first one bit for bit fail the run.
+ * Replays are deterministic against each other, not against the recorded session: the control rotation is kept at 16 bits per axis, so the replayed
+ * aim differs slightly from the player's and the drift from the recorded checkpoints grows with the session.
+ * Only the recorded character is replayed, anything else in the map that reacts to the session (tethered bodies) keeps its state between loops.
+ *
+ * UnrealEditor-Cmd.exe Demo.uproject -run=GrappleReplay -nullrhi -unattended -Recording=<file> [-Map=<long package name>] [-Character=<class path>] [-Loops=1]
+ */
+UCLASS()
+class UGrappleReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleReplayCommandlet();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,304 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleSoakCommandlet.h"
+#include "GrappleCommandletUtils.h"
+#include "Character/GrappleBotController.h"
+#include "Character/GrappleCharacter.h"
+#include "Grapple/GrappleSignificanceSubsystem.h"
+#include "Grapple/GrappleStats.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerStart.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+#include "Demo.h"
+
+namespace GrappleSoak
+{
+	/** Bots are spawned on a grid around the first player start */
+	constexpr double Spacing = 250.0;
+	/** Height of the viewpoint standing in for a player at the player start */
+	constexpr double ViewerHeight = 170.0;
+	/** Memory is sampled once per simulated second (reading it isn't free on every platform) */
+	constexpr float MemorySampleInterval = 1.f;
+
+	/** What one measured frame cost */
+	struct FFrame
+	{
+		float FrameMs{ 0.f };
+		float GCMs{ 0.f };
+		float GrappleMs{ 0.f };
+		uint32 Traces{ 0 };
+		uint32 ActiveGrapples{ 0 };
+	};
+
+	/** Grapple totals at one point, the difference of two is what happened in between */
+	struct FTotals
+	{
+		double ScopeMs[static_cast<int32>(EGrappleStatScope::Num)]{};
+		uint64 Traces{ 0 };
+		uint64 ActiveGrapples{ 0 };
+
+		static FTotals Capture()
+		{
+			FTotals TotalsLocal;
+#if GRAPPLE_INSTRUMENTATION_ENABLED
+			for (int32 ScopeLocal = 0; ScopeLocal < static_cast<int32>(EGrappleStatScope::Num); ++ScopeLocal)
+			{
+				TotalsLocal.ScopeMs[ScopeLocal] = FGrappleStatTotals::GetScopeMs(static_cast<EGrappleStatScope>(ScopeLocal));
+			}
+			TotalsLocal.Traces = FGrappleStatTotals::GetCount(EGrappleStatCounter::Traces);
+			TotalsLocal.ActiveGrapples = FGrappleStatTotals::GetCount(EGrappleStatCounter::ActiveGrapples);
+#endif
+			return TotalsLocal;
+		}
+
+		/** Everything the grapple code costs a frame, the scopes nested in Pull (RopeWrap, ArrivalTrace) are already in it */
+		double GetGrappleMs() const
+		{
+			return ScopeMs[static_cast<int32>(EGrappleStatScope::Fire)] + ScopeMs[static_cast<int32>(EGrappleStatScope::Begin)] + ScopeMs[static_cast<int32>(EGrappleStatScope::HookFlight)]
+				+ ScopeMs[static_cast<int32>(EGrappleStatScope::Pull)] + ScopeMs[static_cast<int32>(EGrappleStatScope::RopeBatch)];
+		}
+	};
+
+	double ToMB(uint64 Bytes)
+	{
+		return static_cast<double>(Bytes) / (1024.0 * 1024.0);
+	}
+}
+
+UGrappleSoakCommandlet::UGrappleSoakCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGrappleSoakCommandlet::Main(const FString& Params)
+{
+	FString MapNameLocal(TEXT("/Game/Maps/ThirdPersonMap"));
+	FString CharacterClassNameLocal(TEXT("/Game/Core/Character/BP_GrappleCharacter"));
+	FString ReportLocal;
+	int32 NumBotsLocal = 100;
+	float DurationLocal = 120.f;
+	float WarmUpLocal = 5.f;
+	float TickRateLocal = 30.f;
+	int32 SeedLocal = 0;
+	FParse::Value(*Params, TEXT("Map="), MapNameLocal);
+	FParse::Value(*Params, TEXT("Character="), CharacterClassNameLocal);
+	FParse::Value(*Params, TEXT("Report="), ReportLocal);
+	FParse::Value(*Params, TEXT("Bots="), NumBotsLocal);
+	FParse::Value(*Params, TEXT("Duration="), DurationLocal);
+	FParse::Value(*Params, TEXT("WarmUp="), WarmUpLocal);
+	FParse::Value(*Params, TEXT("TickRate="), TickRateLocal);
+	FParse::Value(*Params, TEXT("Seed="), SeedLocal);
+	const bool bSignificanceLocal = !FParse::Param(*Params, TEXT("NoSignificance"));
+	NumBotsLocal = FMath::Max(NumBotsLocal, 1);
+	TickRateLocal = FMath::Max(TickRateLocal, 1.f);
+	const float DeltaTimeLocal = 1.f / TickRateLocal;
+	const int32 NumWarmUpFramesLocal = FMath::Max(FMath::CeilToInt(WarmUpLocal * TickRateLocal), 0);
+	const int32 NumFramesLocal = FMath::Max(FMath::CeilToInt(DurationLocal * TickRateLocal), 1);
+	if (ReportLocal.IsEmpty())
+	{
+		ReportLocal = FPaths::ProfilingDir() / TEXT("GrappleSoak") / FString::Printf(TEXT("GrappleSoak_%d%s_%s"), NumBotsLocal, bSignificanceLocal ? TEXT("") : TEXT("_NoSignificance"), *FDateTime::Now().ToString());
+	}
+
+	UClass* CharacterClassLocal = GrappleCommandletUtils::LoadCharacterClass(CharacterClassNameLocal);
+	if (!CharacterClassLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleSoak: can't load character class %s"), *CharacterClassNameLocal);
+		return 1;
+	}
+
+	const FGrappleHeadlessWorld HeadlessWorldLocal(MapNameLocal);
+	UWorld* WorldLocal = HeadlessWorldLocal.Get();
+	if (!WorldLocal)
+	{
+		return 1;
+	}
+
+	// bots on a grid around the first player start
+	FVector OriginLocal(0.0, 0.0, 100.0);
+	for (TActorIterator<APlayerStart> PlayerStartLocal(WorldLocal); PlayerStartLocal; ++PlayerStartLocal)
+	{
+		OriginLocal = PlayerStartLocal->GetActorLocation();
+		break;
+	}
+	// nobody plays here: the significance tiers go by the distance to a viewer at the player start, looking over the grid
+	if (UGrappleSignificanceSubsystem* SignificanceSubsystemLocal = WorldLocal->GetSubsystem<UGrappleSignificanceSubsystem>())
+	{
+		SignificanceSubsystemLocal->SetSignificanceEnabled(bSignificanceLocal);
+		SignificanceSubsystemLocal->SetExtraViewpoints({ FTransform(OriginLocal + FVector(0.0, 0.0, GrappleSoak::ViewerHeight)) });
+	}
+	const int32 GridSizeLocal = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumBotsLocal)));
+	TArray<AGrappleBotController*> BotsLocal;
+	for (int32 IndexLocal = 0; IndexLocal < NumBotsLocal; ++IndexLocal)
+	{
+		const FVector OffsetLocal(((IndexLocal % GridSizeLocal) - (GridSizeLocal - 1) * 0.5) * GrappleSoak::Spacing, ((IndexLocal / GridSizeLocal) - (GridSizeLocal - 1) * 0.5) * GrappleSoak::Spacing, 0.0);
+		FActorSpawnParameters SpawnParametersLocal;
+		SpawnParametersLocal.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		AGrappleCharacter* CharacterLocal = WorldLocal->SpawnActor<AGrappleCharacter>(CharacterClassLocal, OriginLocal + OffsetLocal, FRotator::ZeroRotator, SpawnParametersLocal);
+		AGrappleBotController* BotLocal = CharacterLocal ? WorldLocal->SpawnActor<AGrappleBotController>() : nullptr;
+		if (!BotLocal)
+		{
+			continue;
+		}
+		BotLocal->SetRandomSeed(SeedLocal + IndexLocal);
+		BotLocal->Possess(CharacterLocal);
+		BotsLocal.Add(BotLocal);
+	}
+	if (BotsLocal.Num() == 0)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleSoak: couldn't spawn any bot"));
+	}
+
+	// garbage collection, timed from the engine's own delegates
+	double GCStartLocal = 0.0;
+	double GCMsLocal = 0.0;
+	const FDelegateHandle PreGCHandleLocal = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddLambda([&GCStartLocal]() { GCStartLocal = FPlatformTime::Seconds(); });
+	const FDelegateHandle PostGCHandleLocal = FCoreUObjectDelegates::GetPostGarbageCollect().AddLambda([&GCStartLocal, &GCMsLocal]() { GCMsLocal += (FPlatformTime::Seconds() - GCStartLocal) * 1000.0; });
+
+	// the server loop: world tick, then garbage collection on the engine's schedule (which follows the simulated time)
+	auto TickFrameLocal = [WorldLocal, DeltaTimeLocal]()
+	{
+		FApp::SetDeltaTime(DeltaTimeLocal);
+		FApp::SetCurrentTime(FApp::GetCurrentTime() + DeltaTimeLocal);
+		WorldLocal->Tick(LEVELTICK_All, DeltaTimeLocal);
+		GEngine->ConditionalCollectGarbage();
+	};
+
+	for (int32 FrameLocal = 0; FrameLocal < NumWarmUpFramesLocal; ++FrameLocal)
+	{
+		TickFrameLocal();
+	}
+
+#if GRAPPLE_INSTRUMENTATION_ENABLED
+	FGrappleStatTotals::Reset();
+	FGrappleStatTotals::SetEnabled(true);
+#endif
+	const uint64 StartMemoryLocal = FPlatformMemory::GetStats().UsedPhysical;
+	uint64 PeakMemoryLocal = StartMemoryLocal;
+	float MemorySampleTimeLocal = 0.f;
+	int32 NumGCLocal = 0;
+	float MaxGCMsLocal = 0.f;
+	TArray<GrappleSoak::FFrame> FramesLocal;
+	FramesLocal.Reserve(NumFramesLocal);
+	GrappleSoak::FTotals PreviousTotalsLocal = GrappleSoak::FTotals::Capture();
+	const GrappleSoak::FTotals StartTotalsLocal = PreviousTotalsLocal;
+
+	const double RunStartLocal = FPlatformTime::Seconds();
+	for (int32 FrameLocal = 0; FrameLocal < NumFramesLocal; ++FrameLocal)
+	{
+		GCMsLocal = 0.0;
+		const double FrameStartLocal = FPlatformTime::Seconds();
+		TickFrameLocal();
+		const double FrameMsLocal = (FPlatformTime::Seconds() - FrameStartLocal) * 1000.0;
+
+		const GrappleSoak::FTotals TotalsLocal = GrappleSoak::FTotals::Capture();
+		GrappleSoak::FFrame& FrameDataLocal = FramesLocal.AddDefaulted_GetRef();
+		FrameDataLocal.FrameMs = static_cast<float>(FrameMsLocal);
+		FrameDataLocal.GCMs = static_cast<float>(GCMsLocal);
+		FrameDataLocal.GrappleMs = static_cast<float>(TotalsLocal.GetGrappleMs() - PreviousTotalsLocal.GetGrappleMs());
+		FrameDataLocal.Traces = static_cast<uint32>(TotalsLocal.Traces - PreviousTotalsLocal.Traces);
+		FrameDataLocal.ActiveGrapples = static_cast<uint32>(TotalsLocal.ActiveGrapples - PreviousTotalsLocal.ActiveGrapples);
+		PreviousTotalsLocal = TotalsLocal;
+
+		if (GCMsLocal > 0.0)
+		{
+			++NumGCLocal;
+			MaxGCMsLocal = FMath::Max(MaxGCMsLocal, FrameDataLocal.GCMs);
+		}
+
+		MemorySampleTimeLocal += DeltaTimeLocal;
+		if (MemorySampleTimeLocal >= GrappleSoak::MemorySampleInterval)
+		{
+			MemorySampleTimeLocal = 0.f;
+			PeakMemoryLocal = FMath::Max(PeakMemoryLocal, FPlatformMemory::GetStats().UsedPhysical);
+		}
+	}
+	const double RunSecondsLocal = FPlatformTime::Seconds() - RunStartLocal;
+	const FPlatformMemoryStats MemoryStatsLocal = FPlatformMemory::GetStats();
+	PeakMemoryLocal = FMath::Max(PeakMemoryLocal, MemoryStatsLocal.UsedPhysical);
+
+#if GRAPPLE_INSTRUMENTATION_ENABLED
+	FGrappleStatTotals::SetEnabled(false);
+#endif
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandleLocal);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandleLocal);
+
+	// summary
+	const GrappleSoak::FTotals EndTotalsLocal = GrappleSoak::FTotals::Capture();
+	const double PerFrameLocal = 1.0 / FramesLocal.Num();
+	TArray<float> SortedFrameMsLocal;
+	SortedFrameMsLocal.Reserve(FramesLocal.Num());
+	double TotalFrameMsLocal = 0.0;
+	double TotalGCMsLocal = 0.0;
+	for (const GrappleSoak::FFrame& FrameDataLocal : FramesLocal)
+	{
+		SortedFrameMsLocal.Add(FrameDataLocal.FrameMs);
+		TotalFrameMsLocal += FrameDataLocal.FrameMs;
+		TotalGCMsLocal += FrameDataLocal.GCMs;
+	}
+	SortedFrameMsLocal.Sort();
+	int32 NumShotsLocal = 0;
+	int32 NumMissesLocal = 0;
+	for (const AGrappleBotController* BotLocal : BotsLocal)
+	{
+		NumShotsLocal += BotLocal->GetNumShots();
+		NumMissesLocal += BotLocal->GetNumMisses();
+	}
+	auto GetScopeMsPerFrameLocal = [&StartTotalsLocal, &EndTotalsLocal, PerFrameLocal](EGrappleStatScope Scope)
+	{
+		return (EndTotalsLocal.ScopeMs[static_cast<int32>(Scope)] - StartTotalsLocal.ScopeMs[static_cast<int32>(Scope)]) * PerFrameLocal;
+	};
+	const double GrappleMsPerFrameLocal = (EndTotalsLocal.GetGrappleMs() - StartTotalsLocal.GetGrappleMs()) * PerFrameLocal;
+	const uint64 NumTracesLocal = EndTotalsLocal.Traces - StartTotalsLocal.Traces;
+
+	FString JsonLocal;
+	JsonLocal += TEXT("{\n");
+	JsonLocal += FString::Printf(TEXT("\t\"map\": \"%s\",\n\t\"character\": \"%s\",\n"), *MapNameLocal, *CharacterClassNameLocal);
+	JsonLocal += FString::Printf(TEXT("\t\"build\": \"%s\",\n\t\"configuration\": \"%s\",\n\t\"platform\": \"%s\",\n"), FApp::GetBuildVersion(), LexToString(FApp::GetBuildConfiguration()), ANSI_TO_TCHAR(FPlatformProperties::PlatformName()));
+	JsonLocal += FString::Printf(TEXT("\t\"significance\": %s,\n"), bSignificanceLocal ? TEXT("true") : TEXT("false"));
+	JsonLocal += FString::Printf(TEXT("\t\"bots\": %d,\n\t\"tickRate\": %.1f,\n\t\"frames\": %d,\n\t\"simulatedSeconds\": %.2f,\n\t\"wallSeconds\": %.2f,\n\t\"instrumented\": %s,\n"),
+		BotsLocal.Num(), TickRateLocal, FramesLocal.Num(), FramesLocal.Num() * DeltaTimeLocal, RunSecondsLocal, GRAPPLE_INSTRUMENTATION_ENABLED ? TEXT("true") : TEXT("false"));
+	JsonLocal += FString::Printf(TEXT("\t\"frameMs\": { \"avg\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f },\n"),
+		TotalFrameMsLocal * PerFrameLocal, GrappleCommandletUtils::GetPercentile(SortedFrameMsLocal, 0.5), GrappleCommandletUtils::GetPercentile(SortedFrameMsLocal, 0.9), GrappleCommandletUtils::GetPercentile(SortedFrameMsLocal, 0.95),
+		GrappleCommandletUtils::GetPercentile(SortedFrameMsLocal, 0.99), SortedFrameMsLocal.Last());
+	JsonLocal += FString::Printf(TEXT("\t\"grappleMsPerFrame\": { \"total\": %.4f, \"fire\": %.4f, \"begin\": %.4f, \"hookFlight\": %.4f, \"pull\": %.4f, \"arrivalTrace\": %.4f, \"ropeWrap\": %.4f, \"ropeBatch\": %.4f },\n"),
+		GrappleMsPerFrameLocal, GetScopeMsPerFrameLocal(EGrappleStatScope::Fire), GetScopeMsPerFrameLocal(EGrappleStatScope::Begin), GetScopeMsPerFrameLocal(EGrappleStatScope::HookFlight),
+		GetScopeMsPerFrameLocal(EGrappleStatScope::Pull), GetScopeMsPerFrameLocal(EGrappleStatScope::ArrivalTrace), GetScopeMsPerFrameLocal(EGrappleStatScope::RopeWrap), GetScopeMsPerFrameLocal(EGrappleStatScope::RopeBatch));
+	JsonLocal += FString::Printf(TEXT("\t\"traces\": %llu,\n\t\"tracesPerFrame\": %.2f,\n\t\"activeGrapplesPerFrame\": %.2f,\n\t\"shots\": %d,\n\t\"misses\": %d,\n"),
+		NumTracesLocal, NumTracesLocal * PerFrameLocal, (EndTotalsLocal.ActiveGrapples - StartTotalsLocal.ActiveGrapples) * PerFrameLocal, NumShotsLocal, NumMissesLocal);
+	JsonLocal += FString::Printf(TEXT("\t\"gc\": { \"count\": %d, \"totalMs\": %.3f, \"maxMs\": %.3f },\n"), NumGCLocal, TotalGCMsLocal, MaxGCMsLocal);
+	JsonLocal += FString::Printf(TEXT("\t\"memoryMB\": { \"start\": %.1f, \"peak\": %.1f, \"processPeak\": %.1f }\n"),
+		GrappleSoak::ToMB(StartMemoryLocal), GrappleSoak::ToMB(PeakMemoryLocal), GrappleSoak::ToMB(MemoryStatsLocal.PeakUsedPhysical));
+	JsonLocal += TEXT("}\n");
+
+	FString CsvLocal(TEXT("Frame,FrameMs,GCMs,GrappleMs,Traces,ActiveGrapples\n"));
+	for (int32 FrameLocal = 0; FrameLocal < FramesLocal.Num(); ++FrameLocal)
+	{
+		const GrappleSoak::FFrame& FrameDataLocal = FramesLocal[FrameLocal];
+		CsvLocal += FString::Printf(TEXT("%d,%.3f,%.3f,%.4f,%u,%u\n"), FrameLocal, FrameDataLocal.FrameMs, FrameDataLocal.GCMs, FrameDataLocal.GrappleMs, FrameDataLocal.Traces, FrameDataLocal.ActiveGrapples);
+	}
+
+	const bool bSavedLocal = FFileHelper::SaveStringToFile(JsonLocal, *(ReportLocal + TEXT(".json"))) && FFileHelper::SaveStringToFile(CsvLocal, *(ReportLocal + TEXT(".csv")));
+	UE_LOG(LogGrapple, Display, TEXT("GrappleSoak: %d bots, significance %s, %d frames at %.0f Hz, frame ms p50 %.3f p95 %.3f p99 %.3f max %.3f, grapple %.4f ms per frame, %.2f traces per frame, GC %d x %.3f ms total, peak %.1f MB"),
+		BotsLocal.Num(), bSignificanceLocal ? TEXT("on") : TEXT("off"), FramesLocal.Num(), TickRateLocal, GrappleCommandletUtils::GetPercentile(SortedFrameMsLocal, 0.5), GrappleCommandletUtils::GetPercentile(SortedFrameMsLocal, 0.95),
+		GrappleCommandletUtils::GetPercentile(SortedFrameMsLocal, 0.99), SortedFrameMsLocal.Last(), GrappleMsPerFrameLocal, NumTracesLocal * PerFrameLocal, NumGCLocal, TotalGCMsLocal, GrappleSoak::ToMB(PeakMemoryLocal));
+	if (bSavedLocal)
+	{
+		UE_LOG(LogGrapple, Display, TEXT("GrappleSoak: report written to %s.json/.csv"), *ReportLocal);
+	}
+	else
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleSoak: can't write the report to %s"), *ReportLocal);
+	}
+
+	return bSavedLocal && BotsLocal.Num() > 0 ? 0 : 1;
+}
@@ -0,0 +1,39 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GrappleSoakCommandlet.generated.h"
+
+/**
+ * Capacity soak: loads a map as a game world (World Partition maps with every actor loaded, like a dedicated server that doesn't stream),
+ * spawns grapple characters driven by AGrappleBotController and runs the world at the server tick rate for a fixed simulated duration,
+ * collecting garbage the way the engine loop does. Writes <Report>.json (frame time percentiles, grapple ms and traces per frame, GC time,
+ * peak memory) and <Report>.csv (one row per frame), by default under Saved/Profiling/GrappleSoak.
+ * The significance tiers go by the distance to a viewer standing at the player start. -NoSignificance keeps every bot at full detail, so the
+ * same run with and without it (-Bots=200 -Seed=0 both times) is the before/after of the significance LOD.
+ *
+ * UnrealEditor-Cmd.exe Demo.uproject -run=GrappleSoak -nullrhi -unattended [-Map=/Game/Maps/ThirdPersonMap] [-Character=/Game/Core/Character/BP_GrappleCharacter]
+ *     [-Bots=100] [-Duration=120] [-WarmUp=5] [-TickRate=30] [-Seed=0] [-NoSignificance] [-Report=<path without extension>]
+ */
+UCLASS()
+class UGrappleSoakCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleSoakCommandlet();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,182 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleSolverBenchmarkCommandlet.h"
+#include "Grapple/GrappleSolver.h"
+#include "Grapple/GrappleRopeSolver.h"
+#include "Grapple/GrappleRopeMeshBuilder.h"
+#include "Demo.h"
+
+namespace GrappleSolverBenchmark
+{
+	/** Same defaults as AGrappleCharacter */
+	constexpr float PlayerGrappleSpeed = 250.f;
+	constexpr float GrappleAcceptanceRadius = 45.f;
+	constexpr float DeltaTime = 1.f / 60.f;
+	/** Steps are restarted from here whenever a grapple arrives so every step does the full amount of work */
+	constexpr double StartDistance = 5000.0;
+	/** Simultaneous ropes in the rope comparison */
+	constexpr int32 NumRopes = 100;
+
+	/** Steps NumRopes ropes for NumSteps frames (start ends swinging) and returns the ms per frame */
+	double TimeRopes(const FGrappleRopeSolver::FSettings& Settings, double Slack, int32 NumSteps)
+	{
+		TArray<FGrappleRopeSolver::FRope> RopesLocal;
+		RopesLocal.SetNum(NumRopes);
+		for (int32 RopeLocal = 0; RopeLocal < NumRopes; ++RopeLocal)
+		{
+			FGrappleRopeSolver::Reset(RopesLocal[RopeLocal], FVector(RopeLocal * 100.0, 0.0, 0.0), FVector(RopeLocal * 100.0, 2000.0, 1000.0), Settings.NumSegments);
+			RopesLocal[RopeLocal].RestLength += Slack;
+		}
+
+		const double StartLocal = FPlatformTime::Seconds();
+		for (int32 StepLocal = 0; StepLocal < NumSteps; ++StepLocal)
+		{
+			const double SwingLocal = FMath::Sin(StepLocal * DeltaTime) * 100.0;
+			for (int32 RopeLocal = 0; RopeLocal < NumRopes; ++RopeLocal)
+			{
+				FGrappleRopeSolver::Step(RopesLocal[RopeLocal], FVector(RopeLocal * 100.0, SwingLocal, 0.0), FVector(RopeLocal * 100.0, 2000.0, 1000.0), DeltaTime, Settings);
+			}
+		}
+		return (FPlatformTime::Seconds() - StartLocal) * 1000.0 / NumSteps;
+	}
+}
+
+UGrappleSolverBenchmarkCommandlet::UGrappleSolverBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGrappleSolverBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 NumStepsLocal = 200;
+	FParse::Value(*Params, TEXT("Steps="), NumStepsLocal);
+	NumStepsLocal = FMath::Max(NumStepsLocal, 1);
+
+	const float RemainingLocal = FGrappleSolver::GetPullRemaining(GrappleSolverBenchmark::PlayerGrappleSpeed, GrappleSolverBenchmark::DeltaTime);
+	FRandomStream RandomStreamLocal(1234);
+
+	for (const int32 NumGrapplesLocal : { 1, 1000, 100000 })
+	{
+		TArray<FVector> LocationsLocal;
+		TArray<FVector> TargetsLocal;
+		LocationsLocal.SetNumUninitialized(NumGrapplesLocal);
+		TargetsLocal.SetNumUninitialized(NumGrapplesLocal);
+		for (int32 IndexLocal = 0; IndexLocal < NumGrapplesLocal; ++IndexLocal)
+		{
+			TargetsLocal[IndexLocal] = RandomStreamLocal.VRand() * RandomStreamLocal.FRandRange(0.f, 100000.f);
+			LocationsLocal[IndexLocal] = TargetsLocal[IndexLocal] + (RandomStreamLocal.VRand() * GrappleSolverBenchmark::StartDistance);
+		}
+
+		// scalar, the per-character path of the movement component
+		TArray<FVector> ScalarLocationsLocal = LocationsLocal;
+		int32 ScalarArrivedLocal = 0;
+		const double ScalarStartLocal = FPlatformTime::Seconds();
+		for (int32 StepLocal = 0; StepLocal < NumStepsLocal; ++StepLocal)
+		{
+			for (int32 IndexLocal = 0; IndexLocal < NumGrapplesLocal; ++IndexLocal)
+			{
+				ScalarLocationsLocal[IndexLocal] = FGrappleSolver::Approach(ScalarLocationsLocal[IndexLocal], TargetsLocal[IndexLocal], RemainingLocal);
+				if (FGrappleSolver::HasArrived(ScalarLocationsLocal[IndexLocal], TargetsLocal[IndexLocal], GrappleSolverBenchmark::GrappleAcceptanceRadius))
+				{
+					ScalarLocationsLocal[IndexLocal] = LocationsLocal[IndexLocal];
+					++ScalarArrivedLocal;
+				}
+			}
+		}
+		const double ScalarSecondsLocal = FPlatformTime::Seconds() - ScalarStartLocal;
+
+		// batched
+		FGrappleSolver::FBatch BatchLocal;
+		BatchLocal.SetNum(NumGrapplesLocal);
+		for (int32 IndexLocal = 0; IndexLocal < NumGrapplesLocal; ++IndexLocal)
+		{
+			BatchLocal.Set(IndexLocal, LocationsLocal[IndexLocal], TargetsLocal[IndexLocal]);
+		}
+		int32 BatchArrivedLocal = 0;
+		const double BatchStartLocal = FPlatformTime::Seconds();
+		for (int32 StepLocal = 0; StepLocal < NumStepsLocal; ++StepLocal)
+		{
+			FGrappleSolver::StepPulls(BatchLocal, RemainingLocal, GrappleSolverBenchmark::GrappleAcceptanceRadius);
+			for (int32 IndexLocal = 0; IndexLocal < NumGrapplesLocal; ++IndexLocal)
+			{
+				if (BatchLocal.Reached[IndexLocal])
+				{
+					BatchLocal.Set(IndexLocal, LocationsLocal[IndexLocal], TargetsLocal[IndexLocal]);
+					++BatchArrivedLocal;
+				}
+			}
+		}
+		const double BatchSecondsLocal = FPlatformTime::Seconds() - BatchStartLocal;
+
+		const double GrappleStepsLocal = static_cast<double>(NumGrapplesLocal) * NumStepsLocal;
+		UE_LOG(LogGrapple, Display, TEXT("GrappleSolverBenchmark: %6d grapples, scalar %.2f ns/step, batch %.2f ns/step (%d/%d arrivals)"),
+			NumGrapplesLocal, ScalarSecondsLocal * 1e9 / GrappleStepsLocal, BatchSecondsLocal * 1e9 / GrappleStepsLocal, ScalarArrivedLocal, BatchArrivedLocal);
+		if (ScalarArrivedLocal != BatchArrivedLocal)
+		{
+			UE_LOG(LogGrapple, Warning, TEXT("GrappleSolverBenchmark: scalar and batch disagree on arrivals"));
+		}
+	}
+
+	// ropes: the old cable settings (6 segments, 3 iterations) against the close and far rope LODs and the taut path
+	FGrappleRopeSolver::FSettings RopeSettingsLocal;
+	// no reel in, the slack stays
+	RopeSettingsLocal.ReelInSpeed = 0.f;
+	const double CableLocal = GrappleSolverBenchmark::TimeRopes(RopeSettingsLocal, 200.0, NumStepsLocal);
+	RopeSettingsLocal.NumSegments = 16;
+	RopeSettingsLocal.Iterations = 6;
+	const double CloseLocal = GrappleSolverBenchmark::TimeRopes(RopeSettingsLocal, 200.0, NumStepsLocal);
+	RopeSettingsLocal.NumSegments = 4;
+	RopeSettingsLocal.Iterations = 2;
+	const double FarLocal = GrappleSolverBenchmark::TimeRopes(RopeSettingsLocal, 200.0, NumStepsLocal);
+	// reeling in faster than the ends move keeps every rope taut
+	RopeSettingsLocal.NumSegments = 16;
+	RopeSettingsLocal.ReelInSpeed = 1000000.f;
+	const double TautLocal = GrappleSolverBenchmark::TimeRopes(RopeSettingsLocal, 0.0, NumStepsLocal);
+	UE_LOG(LogGrapple, Display, TEXT("GrappleSolverBenchmark: %d ropes, 6x3 %.4f ms, 16x6 %.4f ms, 4x2 %.4f ms, taut 16 %.4f ms per frame (single thread)"),
+		GrappleSolverBenchmark::NumRopes, CableLocal, CloseLocal, FarLocal, TautLocal);
+
+	// rope tube: the close LOD (16 segments, 8 sides) built into preallocated streams, like the scene proxy does into locked buffers
+	constexpr int32 MeshPointsLocal = 17;
+	constexpr int32 MeshSidesLocal = 8;
+	FGrappleRopeMeshBuilder MeshBuilderLocal;
+	MeshBuilderLocal.SetShape(MeshSidesLocal, MeshSidesLocal + 1, 1.75f, 8.f);
+	TArray<FVector3f> MeshPositionsLocal;
+	TArray<FGrappleRopeMeshBuilder::FTangents> MeshTangentsLocal;
+	TArray<FVector2DHalf> MeshTexCoordsLocal;
+	MeshPositionsLocal.SetNumUninitialized(MeshBuilderLocal.GetNumVertices(MeshPointsLocal));
+	MeshTangentsLocal.SetNumUninitialized(MeshBuilderLocal.GetNumVertices(MeshPointsLocal));
+	MeshTexCoordsLocal.SetNumUninitialized(MeshBuilderLocal.GetNumVertices(MeshPointsLocal));
+	const FGrappleRopeMeshBuilder::FOutput MeshOutputLocal{ MeshPositionsLocal.GetData(), MeshTangentsLocal.GetData(), MeshTexCoordsLocal.GetData() };
+
+	FGrappleRopeSolver::FRope MeshRopeLocal;
+	FGrappleRopeSolver::Reset(MeshRopeLocal, FVector::ZeroVector, FVector(0.0, 2000.0, 1000.0), MeshPointsLocal - 1);
+	MeshRopeLocal.RestLength += 200.0;
+	RopeSettingsLocal.ReelInSpeed = 0.f;
+	TArray<FVector3f> MeshRopePointsLocal;
+	MeshRopePointsLocal.SetNumUninitialized(MeshPointsLocal);
+	double MeshSecondsLocal = 0.0;
+	for (int32 StepLocal = 0; StepLocal < NumStepsLocal; ++StepLocal)
+	{
+		// a new shape every frame, only the build is timed
+		FGrappleRopeSolver::Step(MeshRopeLocal, FVector(0.0, FMath::Sin(StepLocal * GrappleSolverBenchmark::DeltaTime) * 100.0, 0.0), FVector(0.0, 2000.0, 1000.0), GrappleSolverBenchmark::DeltaTime, RopeSettingsLocal);
+		for (int32 IndexLocal = 0; IndexLocal < MeshPointsLocal; ++IndexLocal)
+		{
+			MeshRopePointsLocal[IndexLocal] = FVector3f(MeshRopeLocal.GetPosition(IndexLocal));
+		}
+
+		const double MeshStartLocal = FPlatformTime::Seconds();
+		for (int32 RopeLocal = 0; RopeLocal < GrappleSolverBenchmark::NumRopes; ++RopeLocal)
+		{
+			MeshBuilderLocal.Build(MeshRopePointsLocal.GetData(), MeshPointsLocal, MeshOutputLocal);
+		}
+		MeshSecondsLocal += FPlatformTime::Seconds() - MeshStartLocal;
+	}
+	UE_LOG(LogGrapple, Display, TEXT("GrappleSolverBenchmark: rope tube %dx%d, %.4f ms per rope per frame (%d vertices)"),
+		MeshPointsLocal - 1, MeshSidesLocal, MeshSecondsLocal * 1000.0 / (static_cast<double>(NumStepsLocal) * GrappleSolverBenchmark::NumRopes), MeshPositionsLocal.Num());
+
+	return 0;
+}
@@ -0,0 +1,35 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GrappleSolverBenchmarkCommandlet.generated.h"
+
+/**
+ * Times FGrappleSolver on its own (no map, no actors) and logs ns per grapple step, scalar and batched, at 1, 1k and 100k grapples.
+ * Also times FGrappleRopeSolver on 100 ropes at the old cable settings, at the rope LODs and on the taut path, and the rope tube build
+ * (FGrappleRopeMeshBuilder) per rope.
+ *
+ * UnrealEditor-Cmd.exe Demo.uproject -run=GrappleSolverBenchmark [-Steps=200]
+ */
+UCLASS()
+class UGrappleSolverBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleSolverBenchmarkCommandlet();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual int32 Main(const FString& Params) override;
+};
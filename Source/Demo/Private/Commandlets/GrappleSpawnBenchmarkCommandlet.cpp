@@ -0,0 +1,127 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleSpawnBenchmarkCommandlet.h"
+#include "GrappleCommandletUtils.h"
+#include "Character/GrappleCharacter.h"
+#include "Engine/World.h"
+#include "Demo.h"
+
+namespace GrappleSpawnBenchmark
+{
+	constexpr float DeltaTime = 1.f / 60.f;
+	constexpr double Spacing = 300.0;
+
+	/** Results of one batch */
+	struct FResult
+	{
+		int32 NumCharacters{ 0 };
+		double SpawnMs{ 0.0 };
+		double MemoryKB{ 0.0 };
+		double RegisteredComponents{ 0.0 };
+		double FrameMs{ 0.0 };
+	};
+
+	/** Spawns NumCharacters characters in a row at Y, registering the view components and the cable right away when bFull, then ticks NumFrames frames */
+	FResult SpawnCharacters(UWorld* World, UClass* CharacterClass, int32 NumCharacters, double Y, bool bFull, int32 NumFrames, TArray<AGrappleCharacter*>& OutCharacters)
+	{
+		FResult ResultLocal;
+		const uint64 UsedMemoryLocal = FPlatformMemory::GetStats().UsedPhysical;
+		const double StartLocal = FPlatformTime::Seconds();
+		for (int32 IndexLocal = 0; IndexLocal < NumCharacters; ++IndexLocal)
+		{
+			FActorSpawnParameters SpawnParametersLocal;
+			SpawnParametersLocal.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			AGrappleCharacter* CharacterLocal = World->SpawnActor<AGrappleCharacter>(CharacterClass, FVector(IndexLocal * Spacing, Y, 100.0), FRotator::ZeroRotator, SpawnParametersLocal);
+			if (!CharacterLocal)
+			{
+				continue;
+			}
+			if (bFull)
+			{
+				CharacterLocal->RegisterViewComponents();
+				if (UGrappleRopeComponent* CableLocal = CharacterLocal->GetGrappleCable())
+				{
+					CableLocal->RegisterComponent();
+				}
+			}
+			OutCharacters.Add(CharacterLocal);
+		}
+		const double SpawnSecondsLocal = FPlatformTime::Seconds() - StartLocal;
+		const int64 MemoryDeltaLocal = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(UsedMemoryLocal);
+
+		ResultLocal.NumCharacters = OutCharacters.Num();
+		const double PerCharacterLocal = 1.0 / FMath::Max(ResultLocal.NumCharacters, 1);
+		ResultLocal.SpawnMs = SpawnSecondsLocal * 1000.0 * PerCharacterLocal;
+		ResultLocal.MemoryKB = MemoryDeltaLocal / 1024.0 * PerCharacterLocal;
+		for (const AGrappleCharacter* CharacterLocal : OutCharacters)
+		{
+			for (const UActorComponent* ComponentLocal : CharacterLocal->GetComponents())
+			{
+				ResultLocal.RegisteredComponents += ComponentLocal && ComponentLocal->IsRegistered() ? PerCharacterLocal : 0.0;
+			}
+		}
+
+		World->Tick(LEVELTICK_All, DeltaTime);
+		const double FramesStartLocal = FPlatformTime::Seconds();
+		for (int32 FrameLocal = 0; FrameLocal < NumFrames; ++FrameLocal)
+		{
+			World->Tick(LEVELTICK_All, DeltaTime);
+		}
+		ResultLocal.FrameMs = (FPlatformTime::Seconds() - FramesStartLocal) * 1000.0 / FMath::Max(NumFrames, 1);
+		return ResultLocal;
+	}
+}
+
+UGrappleSpawnBenchmarkCommandlet::UGrappleSpawnBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGrappleSpawnBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString CharacterClassNameLocal(TEXT("/Game/Core/Character/BP_GrappleCharacter"));
+	int32 NumCharactersLocal = 200;
+	int32 NumFramesLocal = 100;
+	FParse::Value(*Params, TEXT("Character="), CharacterClassNameLocal);
+	FParse::Value(*Params, TEXT("Characters="), NumCharactersLocal);
+	FParse::Value(*Params, TEXT("Frames="), NumFramesLocal);
+	NumCharactersLocal = FMath::Max(NumCharactersLocal, 1);
+	NumFramesLocal = FMath::Max(NumFramesLocal, 1);
+
+	UClass* CharacterClassLocal = GrappleCommandletUtils::LoadCharacterClass(CharacterClassNameLocal);
+	if (!CharacterClassLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleSpawnBenchmark: can't load character class %s"), *CharacterClassNameLocal);
+		return 1;
+	}
+
+	const FGrappleHeadlessWorld HeadlessWorldLocal;
+	UWorld* WorldLocal = HeadlessWorldLocal.Get();
+
+	// one spawn first so the class, its assets and the world's pools are loaded before anything is measured
+	{
+		FActorSpawnParameters SpawnParametersLocal;
+		SpawnParametersLocal.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		if (AActor* WarmUpLocal = WorldLocal->SpawnActor<AGrappleCharacter>(CharacterClassLocal, FVector(0.0, -GrappleSpawnBenchmark::Spacing, 100.0), FRotator::ZeroRotator, SpawnParametersLocal))
+		{
+			WarmUpLocal->Destroy();
+		}
+	}
+
+	// lean first, the full batch then pays its own frames on top of the lean one, which the difference removes
+	TArray<AGrappleCharacter*> LeanCharactersLocal;
+	TArray<AGrappleCharacter*> FullCharactersLocal;
+	const GrappleSpawnBenchmark::FResult LeanLocal = GrappleSpawnBenchmark::SpawnCharacters(WorldLocal, CharacterClassLocal, NumCharactersLocal, 0.0, false, NumFramesLocal, LeanCharactersLocal);
+	const GrappleSpawnBenchmark::FResult FullLocal = GrappleSpawnBenchmark::SpawnCharacters(WorldLocal, CharacterClassLocal, NumCharactersLocal, GrappleSpawnBenchmark::Spacing, true, NumFramesLocal, FullCharactersLocal);
+
+	UE_LOG(LogGrapple, Display, TEXT("GrappleSpawnBenchmark: lean %d characters, %.3f ms spawn, %.1f KB, %.1f registered components per character, %.3f ms per frame"),
+		LeanLocal.NumCharacters, LeanLocal.SpawnMs, LeanLocal.MemoryKB, LeanLocal.RegisteredComponents, LeanLocal.FrameMs);
+	UE_LOG(LogGrapple, Display, TEXT("GrappleSpawnBenchmark: full %d characters, %.3f ms spawn, %.1f KB, %.1f registered components per character, %.3f ms per frame (%.3f ms on top of the lean ones)"),
+		FullLocal.NumCharacters, FullLocal.SpawnMs, FullLocal.MemoryKB, FullLocal.RegisteredComponents, FullLocal.FrameMs, FullLocal.FrameMs - LeanLocal.FrameMs);
+
+	return 0;
+}
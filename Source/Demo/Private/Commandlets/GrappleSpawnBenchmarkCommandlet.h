@@ -0,0 +1,35 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GrappleSpawnBenchmarkCommandlet.generated.h"
+
+/**
+ * Measures what the lean character variant saves: spawns grapple characters in an empty game world the way other players and AI get them
+ * (cameras, arms and cable left unregistered), then the same number the way the local player gets them (everything registered). Logs the
+ * spawn time, the memory and the registered components per character for both, and the ms per frame they cost.
+ *
+ * UnrealEditor-Cmd.exe Demo.uproject -run=GrappleSpawnBenchmark [-Character=/Game/Core/Character/BP_GrappleCharacter] [-Characters=200] [-Frames=100]
+ */
+UCLASS()
+class UGrappleSpawnBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleSpawnBenchmarkCommandlet();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,124 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleTetherBenchmarkCommandlet.h"
+#include "GrappleCommandletUtils.h"
+#include "Grapple/GrappleTetherSubsystem.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "PhysicsEngine/PhysicsSettings.h"
+#include "Demo.h"
+
+namespace GrappleTetherBenchmark
+{
+	constexpr float DeltaTime = 1.f / 60.f;
+	/** The cubes start on a ring around the holder */
+	constexpr double RingRadius = 800.0;
+	constexpr double HolderHeight = 1000.0;
+
+	/** Result of one run */
+	struct FRun
+	{
+		double MsPerFrame{ 0.0 };
+		/** Average distance from the cubes to the holder after the last frame */
+		double AverageDistance{ 0.0 };
+		int32 NumTethers{ 0 };
+	};
+
+	/** Spawns NumBodies cubes in a new game world, optionally tethers them and ticks the world NumFrames frames */
+	FRun Run(UStaticMesh* Mesh, int32 NumBodies, int32 NumFrames, bool bTether)
+	{
+		FRun RunLocal;
+
+		const FGrappleHeadlessWorld HeadlessWorldLocal;
+		UWorld* WorldLocal = HeadlessWorldLocal.Get();
+
+		AActor* HolderActorLocal = WorldLocal->SpawnActor<AActor>(FVector(0.0, 0.0, HolderHeight), FRotator::ZeroRotator);
+		USceneComponent* HolderLocal = NewObject<USceneComponent>(HolderActorLocal);
+		HolderActorLocal->SetRootComponent(HolderLocal);
+		HolderLocal->RegisterComponent();
+		HolderLocal->SetWorldLocation(FVector(0.0, 0.0, HolderHeight));
+
+		UGrappleTetherSubsystem* TetherSubsystemLocal = WorldLocal->GetSubsystem<UGrappleTetherSubsystem>();
+		FGrappleTetherSettings SettingsLocal;
+		TArray<UStaticMeshComponent*> BodiesLocal;
+		for (int32 BodyLocal = 0; BodyLocal < NumBodies; ++BodyLocal)
+		{
+			const double AngleLocal = (2.f * PI) * BodyLocal / NumBodies;
+			const FVector LocationLocal(FMath::Cos(AngleLocal) * RingRadius, FMath::Sin(AngleLocal) * RingRadius, HolderHeight);
+			AStaticMeshActor* ActorLocal = WorldLocal->SpawnActor<AStaticMeshActor>(LocationLocal, FRotator::ZeroRotator);
+			UStaticMeshComponent* MeshComponentLocal = ActorLocal->GetStaticMeshComponent();
+			MeshComponentLocal->SetMobility(EComponentMobility::Movable);
+			MeshComponentLocal->SetStaticMesh(Mesh);
+			MeshComponentLocal->SetSimulatePhysics(true);
+			BodiesLocal.Add(MeshComponentLocal);
+
+			// tied on the top face, like a hook landing on a crate
+			if (bTether && TetherSubsystemLocal)
+			{
+				TetherSubsystemLocal->AddTether(MeshComponentLocal, LocationLocal + FVector(0.0, 0.0, 50.0), HolderLocal, SettingsLocal);
+			}
+		}
+		RunLocal.NumTethers = TetherSubsystemLocal ? TetherSubsystemLocal->GetNumTethers() : 0;
+
+		// one frame to settle the spawns before timing
+		WorldLocal->Tick(LEVELTICK_All, DeltaTime);
+		const double StartLocal = FPlatformTime::Seconds();
+		for (int32 FrameLocal = 0; FrameLocal < NumFrames; ++FrameLocal)
+		{
+			WorldLocal->Tick(LEVELTICK_All, DeltaTime);
+		}
+		RunLocal.MsPerFrame = (FPlatformTime::Seconds() - StartLocal) * 1000.0 / NumFrames;
+
+		for (const UStaticMeshComponent* BodyLocal : BodiesLocal)
+		{
+			RunLocal.AverageDistance += FVector::Dist(BodyLocal->GetComponentLocation(), HolderLocal->GetComponentLocation()) / BodiesLocal.Num();
+		}
+
+		return RunLocal;
+	}
+}
+
+UGrappleTetherBenchmarkCommandlet::UGrappleTetherBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGrappleTetherBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 NumFramesLocal = 300;
+	int32 NumBodiesLocal = 50;
+	FParse::Value(*Params, TEXT("Frames="), NumFramesLocal);
+	FParse::Value(*Params, TEXT("Bodies="), NumBodiesLocal);
+	NumFramesLocal = FMath::Max(NumFramesLocal, 1);
+	NumBodiesLocal = FMath::Max(NumBodiesLocal, 1);
+
+	UStaticMesh* MeshLocal = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!MeshLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleTetherBenchmark: can't load /Engine/BasicShapes/Cube"));
+		return 1;
+	}
+
+	const UPhysicsSettings* PhysicsSettingsLocal = UPhysicsSettings::Get();
+	UE_LOG(LogGrapple, Display, TEXT("GrappleTetherBenchmark: async physics %s (%.4f s fixed step)"),
+		PhysicsSettingsLocal->bTickPhysicsAsync ? TEXT("on") : TEXT("off"), PhysicsSettingsLocal->AsyncFixedTimeStepSize);
+
+	const GrappleTetherBenchmark::FRun FreeLocal = GrappleTetherBenchmark::Run(MeshLocal, NumBodiesLocal, NumFramesLocal, false);
+	const GrappleTetherBenchmark::FRun TetheredLocal = GrappleTetherBenchmark::Run(MeshLocal, NumBodiesLocal, NumFramesLocal, true);
+	UE_LOG(LogGrapple, Display, TEXT("GrappleTetherBenchmark: %d bodies, free %.4f ms per frame, %d tethers %.4f ms per frame"),
+		NumBodiesLocal, FreeLocal.MsPerFrame, TetheredLocal.NumTethers, TetheredLocal.MsPerFrame);
+	UE_LOG(LogGrapple, Display, TEXT("GrappleTetherBenchmark: average distance to the holder after %d frames, free %.1f, tethered %.1f"),
+		NumFramesLocal, FreeLocal.AverageDistance, TetheredLocal.AverageDistance);
+	if (TetheredLocal.NumTethers != NumBodiesLocal)
+	{
+		UE_LOG(LogGrapple, Warning, TEXT("GrappleTetherBenchmark: only %d of %d bodies were tethered"), TetheredLocal.NumTethers, NumBodiesLocal);
+	}
+
+	return 0;
+}
@@ -0,0 +1,36 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GrappleTetherBenchmarkCommandlet.generated.h"
+
+/**
+ * Headless tether test: spawns 50 simulating cubes in an empty game world and ticks it, once free falling and once tethered to a holder
+ * through UGrappleTetherSubsystem, and logs the ms per frame of both runs (the physics step included) and how far the tethered cubes
+ * ended from the holder. The project steps physics with the frame; add the async physics override to measure the fixed 60 Hz step.
+ *
+ * UnrealEditor-Cmd.exe Demo.uproject -run=GrappleTetherBenchmark [-Frames=300] [-Bodies=50]
+ *   [-ini:Engine:[/Script/Engine.PhysicsSettings]:bTickPhysicsAsync=True,[/Script/Engine.PhysicsSettings]:AsyncFixedTimeStepSize=0.016667]
+ */
+UCLASS()
+class UGrappleTetherBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleTetherBenchmarkCommandlet();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,111 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleViewBenchmarkCommandlet.h"
+#include "GrappleCommandletUtils.h"
+#include "Character/GrappleCharacter.h"
+#include "Character/GrappleViewComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Demo.h"
+
+namespace GrappleViewBenchmark
+{
+	constexpr float DeltaTime = 1.f / 60.f;
+	constexpr double Spacing = 300.0;
+
+	/** Turns parallel animation update and evaluation on or off */
+	void SetParallelAnimation(bool bParallel)
+	{
+		for (const TCHAR* NameLocal : { TEXT("a.ParallelAnimUpdate"), TEXT("a.ParallelAnimEvaluation") })
+		{
+			if (IConsoleVariable* VariableLocal = IConsoleManager::Get().FindConsoleVariable(NameLocal))
+			{
+				VariableLocal->Set(bParallel ? 1 : 0, ECVF_SetByCode);
+			}
+		}
+	}
+
+	/** Ticks the world NumFrames frames (after one to settle) and returns the ms per frame */
+	double TimeFrames(UWorld* World, int32 NumFrames)
+	{
+		World->Tick(LEVELTICK_All, DeltaTime);
+		const double StartLocal = FPlatformTime::Seconds();
+		for (int32 FrameLocal = 0; FrameLocal < NumFrames; ++FrameLocal)
+		{
+			World->Tick(LEVELTICK_All, DeltaTime);
+		}
+		return (FPlatformTime::Seconds() - StartLocal) * 1000.0 / NumFrames;
+	}
+}
+
+UGrappleViewBenchmarkCommandlet::UGrappleViewBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGrappleViewBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString CharacterClassNameLocal(TEXT("/Game/Core/Character/BP_GrappleCharacter"));
+	int32 NumCharactersLocal = 20;
+	int32 NumFramesLocal = 200;
+	FParse::Value(*Params, TEXT("Character="), CharacterClassNameLocal);
+	FParse::Value(*Params, TEXT("Characters="), NumCharactersLocal);
+	FParse::Value(*Params, TEXT("Frames="), NumFramesLocal);
+	NumCharactersLocal = FMath::Max(NumCharactersLocal, 1);
+	NumFramesLocal = FMath::Max(NumFramesLocal, 1);
+
+	UClass* CharacterClassLocal = GrappleCommandletUtils::LoadCharacterClass(CharacterClassNameLocal);
+	if (!CharacterClassLocal)
+	{
+		UE_LOG(LogGrapple, Error, TEXT("GrappleViewBenchmark: can't load character class %s"), *CharacterClassNameLocal);
+		return 1;
+	}
+
+	const FGrappleHeadlessWorld HeadlessWorldLocal;
+	UWorld* WorldLocal = HeadlessWorldLocal.Get();
+
+	TArray<AGrappleCharacter*> CharactersLocal;
+	for (int32 IndexLocal = 0; IndexLocal < NumCharactersLocal; ++IndexLocal)
+	{
+		FActorSpawnParameters SpawnParametersLocal;
+		SpawnParametersLocal.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		if (AGrappleCharacter* CharacterLocal = WorldLocal->SpawnActor<AGrappleCharacter>(CharacterClassLocal, FVector(IndexLocal * GrappleViewBenchmark::Spacing, 0.0, 100.0), FRotator::ZeroRotator, SpawnParametersLocal))
+		{
+			// every character is a player looking through its own cameras here, and nothing is rendered: make sure the meshes animate as if they were seen
+			CharacterLocal->RegisterViewComponents();
+			CharacterLocal->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+			CharacterLocal->GetFirstPersonMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+			CharactersLocal.Add(CharacterLocal);
+		}
+	}
+
+	// [first person][parallel]
+	double MsPerFrameLocal[2][2] = {};
+	for (const bool bFirstPersonLocal : { false, true })
+	{
+		for (AGrappleCharacter* CharacterLocal : CharactersLocal)
+		{
+			CharacterLocal->GetViewState()->SetFirstPerson(bFirstPersonLocal);
+		}
+		for (const bool bParallelLocal : { true, false })
+		{
+			GrappleViewBenchmark::SetParallelAnimation(bParallelLocal);
+			MsPerFrameLocal[bFirstPersonLocal][bParallelLocal] = GrappleViewBenchmark::TimeFrames(WorldLocal, NumFramesLocal);
+		}
+	}
+	GrappleViewBenchmark::SetParallelAnimation(true);
+
+	const double PerCharacterLocal = 1.0 / FMath::Max(CharactersLocal.Num(), 1);
+	const double GameThreadSavedLocal = (MsPerFrameLocal[0][1] - MsPerFrameLocal[1][1]) * PerCharacterLocal;
+	const double TotalSavedLocal = (MsPerFrameLocal[0][0] - MsPerFrameLocal[1][0]) * PerCharacterLocal;
+	UE_LOG(LogGrapple, Display, TEXT("GrappleViewBenchmark: %d characters, third person %.4f ms (serial %.4f ms), first person %.4f ms (serial %.4f ms) per frame"),
+		CharactersLocal.Num(), MsPerFrameLocal[0][1], MsPerFrameLocal[0][0], MsPerFrameLocal[1][1], MsPerFrameLocal[1][0]);
+	UE_LOG(LogGrapple, Display, TEXT("GrappleViewBenchmark: saved per character, game thread %.4f ms, worker threads %.4f ms, total %.4f ms"),
+		GameThreadSavedLocal, TotalSavedLocal - GameThreadSavedLocal, TotalSavedLocal);
+
+	return 0;
+}
@@ -0,0 +1,35 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GrappleViewBenchmarkCommandlet.generated.h"
+
+/**
+ * Measures the animation cost UGrappleViewComponent saves: spawns grapple characters in an empty game world and times world frames in third
+ * and first person, once with parallel animation (game thread cost) and once with it forced onto the game thread (total cost, the difference
+ * being the worker thread share). Logs ms per character for each.
+ *
+ * UnrealEditor-Cmd.exe Demo.uproject -run=GrappleViewBenchmark [-Character=/Game/Core/Character/BP_GrappleCharacter] [-Characters=20] [-Frames=200]
+ */
+UCLASS()
+class UGrappleViewBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleViewBenchmarkCommandlet();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,122 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleAnchorCellActor.h"
+#include "GrappleAnchorSubsystem.h"
+#include "Components/SceneComponent.h"
+#include "Demo.h"
+
+AGrappleAnchorCellActor::AGrappleAnchorCellActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+	SetCanBeDamaged(false);
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+	RootComponent->SetMobility(EComponentMobility::Static);
+
+#if WITH_EDITORONLY_DATA
+	// spatially loaded, its location (the cell center) decides which cell it streams with
+	GridPlacement = EActorGridPlacement::Location;
+#endif
+}
+
+void AGrappleAnchorCellActor::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UGrappleAnchorSubsystem* AnchorSubsystemLocal = GetWorld()->GetSubsystem<UGrappleAnchorSubsystem>();
+	if (!AnchorSubsystemLocal || GetNumAnchors() == 0)
+	{
+		return;
+	}
+
+	const double StartTimeLocal = FPlatformTime::Seconds();
+
+	TArray<FVector> LocationsLocal;
+	TArray<FVector> NormalsLocal;
+	DecodeAnchors(LocationsLocal, NormalsLocal);
+	AnchorBlockId = AnchorSubsystemLocal->RegisterAnchorBlock(MoveTemp(LocationsLocal), MoveTemp(NormalsLocal));
+
+	UE_LOG(LogGrapple, Verbose, TEXT("%s registered %d baked anchors in %.3f ms"), *GetName(), GetNumAnchors(), (FPlatformTime::Seconds() - StartTimeLocal) * 1000.0);
+}
+
+void AGrappleAnchorCellActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (AnchorBlockId != INDEX_NONE)
+	{
+		if (UGrappleAnchorSubsystem* AnchorSubsystemLocal = GetWorld()->GetSubsystem<UGrappleAnchorSubsystem>())
+		{
+			AnchorSubsystemLocal->UnregisterAnchorBlock(AnchorBlockId);
+		}
+		AnchorBlockId = INDEX_NONE;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AGrappleAnchorCellActor::SetBakedAnchors(TConstArrayView<FVector> Locations, TConstArrayView<FVector> Normals)
+{
+	check(Locations.Num() == Normals.Num());
+
+	const FVector OriginLocal = GetActorLocation();
+	PackedPositions.Reset(Locations.Num() * 3);
+	PackedNormals.Reset(Normals.Num());
+
+	for (int32 IndexLocal = 0; IndexLocal < Locations.Num(); ++IndexLocal)
+	{
+		const FVector RelativeLocal = (Locations[IndexLocal] - OriginLocal) / PositionQuantum;
+		for (int32 AxisLocal = 0; AxisLocal < 3; ++AxisLocal)
+		{
+			PackedPositions.Add(static_cast<int16>(FMath::Clamp<int32>(FMath::RoundToInt(RelativeLocal[AxisLocal]), MIN_int16, MAX_int16)));
+		}
+		PackedNormals.Add(PackNormal(Normals[IndexLocal]));
+	}
+}
+
+void AGrappleAnchorCellActor::DecodeAnchors(TArray<FVector>& OutLocations, TArray<FVector>& OutNormals) const
+{
+	const int32 NumLocal = GetNumAnchors();
+	const FVector OriginLocal = GetActorLocation();
+	OutLocations.SetNumUninitialized(NumLocal);
+	OutNormals.SetNumUninitialized(NumLocal);
+
+	const int16* PositionLocal = PackedPositions.GetData();
+	for (int32 IndexLocal = 0; IndexLocal < NumLocal; ++IndexLocal, PositionLocal += 3)
+	{
+		OutLocations[IndexLocal] = OriginLocal + FVector(PositionLocal[0], PositionLocal[1], PositionLocal[2]) * PositionQuantum;
+		OutNormals[IndexLocal] = UnpackNormal(PackedNormals[IndexLocal]);
+	}
+}
+
+uint16 AGrappleAnchorCellActor::PackNormal(const FVector& Normal)
+{
+	// project on the octahedron, fold the lower half over the upper one
+	const FVector UnitLocal = Normal.GetSafeNormal(SMALL_NUMBER, FVector::UpVector);
+	const double InvL1Local = 1.0 / (FMath::Abs(UnitLocal.X) + FMath::Abs(UnitLocal.Y) + FMath::Abs(UnitLocal.Z));
+	double XLocal = UnitLocal.X * InvL1Local;
+	double YLocal = UnitLocal.Y * InvL1Local;
+	if (UnitLocal.Z < 0.0)
+	{
+		const double FoldedXLocal = (1.0 - FMath::Abs(YLocal)) * (XLocal >= 0.0 ? 1.0 : -1.0);
+		YLocal = (1.0 - FMath::Abs(XLocal)) * (YLocal >= 0.0 ? 1.0 : -1.0);
+		XLocal = FoldedXLocal;
+	}
+
+	const uint16 XByteLocal = static_cast<uint16>(FMath::RoundToInt((XLocal * 0.5 + 0.5) * 255.0));
+	const uint16 YByteLocal = static_cast<uint16>(FMath::RoundToInt((YLocal * 0.5 + 0.5) * 255.0));
+	return static_cast<uint16>((XByteLocal << 8) | YByteLocal);
+}
+
+FVector AGrappleAnchorCellActor::UnpackNormal(uint16 PackedNormal)
+{
+	const double XLocal = ((PackedNormal >> 8) / 255.0) * 2.0 - 1.0;
+	const double YLocal = ((PackedNormal & 0xFF) / 255.0) * 2.0 - 1.0;
+	const double ZLocal = 1.0 - FMath::Abs(XLocal) - FMath::Abs(YLocal);
+	FVector NormalLocal(XLocal, YLocal, ZLocal);
+	if (ZLocal < 0.0)
+	{
+		NormalLocal.X = (1.0 - FMath::Abs(YLocal)) * (XLocal >= 0.0 ? 1.0 : -1.0);
+		NormalLocal.Y = (1.0 - FMath::Abs(XLocal)) * (YLocal >= 0.0 ? 1.0 : -1.0);
+	}
+	return NormalLocal.GetSafeNormal();
+}
@@ -0,0 +1,70 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "GrappleAnchorCellActor.generated.h"
+
+/**
+ * Holds the grapple anchors baked offline (UGrappleAnchorBakeCommandlet) for one World Partition cell.
+ * The actor is spatially loaded and placed at the center of its cell, so it streams in and out with the cell's geometry;
+ * on BeginPlay the anchors are decoded and handed to the anchor subsystem as one block, no runtime traces.
+ * Each anchor is 8 bytes: the position relative to the actor quantized to int16 x3 and the surface normal octahedron encoded in 2 x 8 bits.
+ */
+UCLASS(NotBlueprintable, NotPlaceable)
+class AGrappleAnchorCellActor : public AActor
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+public:
+	/** Size of one position step (cm). int16 covers +/- 163 m around the actor, enough for cells up to 327 m */
+	static constexpr float PositionQuantum = 0.5f;
+
+protected:
+	/** Quantized positions relative to the actor, 3 per anchor */
+	UPROPERTY(VisibleAnywhere, Category = "Grappling|Baked")
+	TArray<int16> PackedPositions;
+
+	/** Octahedron encoded surface normals, 1 per anchor */
+	UPROPERTY(VisibleAnywhere, Category = "Grappling|Baked")
+	TArray<uint16> PackedNormals;
+
+	/** Block id in the grapple anchor subsystem (INDEX_NONE while not registered) */
+	int32 AnchorBlockId{ INDEX_NONE };
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	AGrappleAnchorCellActor();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/********************************
+	* MEMBER METHODS
+	********************************/
+public:
+	/** Replaces the baked anchors with world space Locations/Normals (same length). The actor must already be at its cell center */
+	void SetBakedAnchors(TConstArrayView<FVector> Locations, TConstArrayView<FVector> Normals);
+	/** Decodes the baked anchors to world space */
+	void DecodeAnchors(TArray<FVector>& OutLocations, TArray<FVector>& OutNormals) const;
+
+	FORCEINLINE int32 GetNumAnchors() const { return PackedNormals.Num(); }
+	/** Size of the baked anchor payload */
+	FORCEINLINE int32 GetBakedDataSize() const { return PackedPositions.Num() * sizeof(int16) + PackedNormals.Num() * sizeof(uint16); }
+
+	static uint16 PackNormal(const FVector& Normal);
+	static FVector UnpackNormal(uint16 PackedNormal);
+};
@@ -0,0 +1,34 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleAnchorComponent.h"
+#include "GrappleAnchorSubsystem.h"
+
+UGrappleAnchorComponent::UGrappleAnchorComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UGrappleAnchorComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UGrappleAnchorSubsystem* AnchorSubsystemLocal = GetWorld()->GetSubsystem<UGrappleAnchorSubsystem>())
+	{
+		AnchorId = AnchorSubsystemLocal->RegisterAnchorComponent(this);
+	}
+}
+
+void UGrappleAnchorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (AnchorId != INDEX_NONE)
+	{
+		if (UGrappleAnchorSubsystem* AnchorSubsystemLocal = GetWorld()->GetSubsystem<UGrappleAnchorSubsystem>())
+		{
+			AnchorSubsystemLocal->UnregisterAnchorComponent(this);
+		}
+		AnchorId = INDEX_NONE;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -0,0 +1,47 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "GrappleAnchorComponent.generated.h"
+
+/**
+ * Marks a point the grapple aim assist can snap to. Registers itself with the grapple anchor subsystem while playing;
+ * if the component is movable the subsystem follows it as it moves.
+ */
+UCLASS(ClassGroup = (Grapple), meta = (BlueprintSpawnableComponent))
+class UGrappleAnchorComponent : public USceneComponent
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	/** Anchor id in the grapple anchor subsystem (INDEX_NONE while not registered) */
+	int32 AnchorId{ INDEX_NONE };
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleAnchorComponent();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/********************************
+	* MEMBER METHODS
+	********************************/
+public:
+	UFUNCTION(BlueprintPure, Category = "Grapple|Getters")
+	FORCEINLINE bool IsRegisteredAnchor() const { return AnchorId != INDEX_NONE; }
+};
@@ -0,0 +1,406 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleAnchorSubsystem.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+#include "GrappleStats.h"
+
+bool UGrappleAnchorSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGrappleAnchorSubsystem::Deinitialize()
+{
+	for (const TPair<TObjectKey<USceneComponent>, int32>& PairLocal : ComponentToAnchor)
+	{
+		if (USceneComponent* ComponentLocal = PairLocal.Key.ResolveObjectPtr())
+		{
+			ComponentLocal->TransformUpdated.RemoveAll(this);
+		}
+	}
+	for (const TPair<TObjectKey<AActor>, int32>& PairLocal : OwnerToAnchors)
+	{
+		if (AActor* OwnerLocal = PairLocal.Key.ResolveObjectPtr())
+		{
+			OwnerLocal->OnEndPlay.RemoveDynamic(this, &UGrappleAnchorSubsystem::OnAnchorOwnerEndPlay);
+		}
+	}
+	ComponentToAnchor.Reset();
+	OwnerToAnchors.Reset();
+	Anchors.Reset();
+	AnchorBlocks.Reset();
+	AnchorBlockChunks.Reset();
+	AnchorTree.Reset();
+
+	Super::Deinitialize();
+}
+
+int32 UGrappleAnchorSubsystem::RegisterAnchorComponent(USceneComponent* Component, const FVector& LocalOffset)
+{
+	GRAPPLE_LLM_SCOPE(Anchors);
+	if (!Component)
+	{
+		return INDEX_NONE;
+	}
+
+	if (const int32* ExistingLocal = ComponentToAnchor.Find(Component))
+	{
+		return *ExistingLocal;
+	}
+
+	const int32 AnchorIdLocal = AddAnchor(Component->GetComponentTransform().TransformPosition(LocalOffset));
+	FAnchorEntry& EntryLocal = Anchors[AnchorIdLocal];
+	EntryLocal.LocalOffset = LocalOffset;
+	EntryLocal.Component = Component;
+	EntryLocal.ComponentKey = Component;
+	EntryLocal.OwnerKey = Component->GetOwner();
+	ComponentToAnchor.Add(Component, AnchorIdLocal);
+
+	// followed whatever the mobility: a component that doesn't move doesn't broadcast, and one made movable later still has to be followed
+	Component->TransformUpdated.AddUObject(this, &UGrappleAnchorSubsystem::OnAnchorComponentMoved);
+	if (AActor* OwnerLocal = Component->GetOwner())
+	{
+		OwnerLocal->OnEndPlay.AddUniqueDynamic(this, &UGrappleAnchorSubsystem::OnAnchorOwnerEndPlay);
+		OwnerToAnchors.Add(OwnerLocal, AnchorIdLocal);
+	}
+	return AnchorIdLocal;
+}
+
+void UGrappleAnchorSubsystem::UnregisterAnchorComponent(USceneComponent* Component)
+{
+	if (const int32* AnchorIdLocal = Component ? ComponentToAnchor.Find(Component) : nullptr)
+	{
+		RemoveComponentAnchor(*AnchorIdLocal);
+	}
+}
+
+int32 UGrappleAnchorSubsystem::RegisterAnchorPoint(const FVector& Location)
+{
+	GRAPPLE_LLM_SCOPE(Anchors);
+	return AddAnchor(Location);
+}
+
+void UGrappleAnchorSubsystem::UnregisterAnchor(int32 AnchorId)
+{
+	if (!Anchors.IsValidIndex(AnchorId))
+	{
+		return;
+	}
+
+	if (Anchors[AnchorId].ComponentKey != TObjectKey<USceneComponent>())
+	{
+		RemoveComponentAnchor(AnchorId);
+		return;
+	}
+	RemoveAnchor(AnchorId);
+}
+
+int32 UGrappleAnchorSubsystem::RegisterAnchorBlock(TArray<FVector>&& Locations, TArray<FVector>&& Normals)
+{
+	GRAPPLE_LLM_SCOPE(Anchors);
+	check(Locations.Num() == Normals.Num());
+	if (Locations.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 BlockIdLocal = AnchorBlocks.Add(FAnchorBlock());
+	FAnchorBlock& BlockLocal = AnchorBlocks[BlockIdLocal];
+	BlockLocal.Locations = MoveTemp(Locations);
+	BlockLocal.Normals = MoveTemp(Normals);
+
+	// one leaf per run of points, the bake ordered them so each run is a tight cluster
+	BlockLocal.ChunkIds.Reserve(FMath::DivideAndRoundUp(BlockLocal.Locations.Num(), BlockChunkSize));
+	for (int32 StartLocal = 0; StartLocal < BlockLocal.Locations.Num(); StartLocal += BlockChunkSize)
+	{
+		FAnchorBlockChunk ChunkLocal;
+		ChunkLocal.BlockId = BlockIdLocal;
+		ChunkLocal.Start = StartLocal;
+		ChunkLocal.Num = FMath::Min(BlockChunkSize, BlockLocal.Locations.Num() - StartLocal);
+
+		FBox BoundsLocal(ForceInit);
+		for (const FVector& LocationLocal : MakeArrayView(BlockLocal.Locations).Slice(ChunkLocal.Start, ChunkLocal.Num))
+		{
+			BoundsLocal += LocationLocal;
+		}
+
+		const int32 ChunkIdLocal = AnchorBlockChunks.Add(ChunkLocal);
+		AnchorBlockChunks[ChunkIdLocal].ProxyId = AnchorTree.CreateProxy(BoundsLocal, ChunkIdLocal | BlockUserDataFlag);
+		BlockLocal.ChunkIds.Add(ChunkIdLocal);
+	}
+	return BlockIdLocal;
+}
+
+void UGrappleAnchorSubsystem::UnregisterAnchorBlock(int32 BlockId)
+{
+	if (!AnchorBlocks.IsValidIndex(BlockId))
+	{
+		return;
+	}
+
+	for (const int32 ChunkIdLocal : AnchorBlocks[BlockId].ChunkIds)
+	{
+		AnchorTree.DestroyProxy(AnchorBlockChunks[ChunkIdLocal].ProxyId);
+		AnchorBlockChunks.RemoveAt(ChunkIdLocal);
+	}
+	AnchorBlocks.RemoveAt(BlockId);
+}
+
+void UGrappleAnchorSubsystem::SortAnchorBlock(TArray<FVector>& Locations, TArray<FVector>& Normals)
+{
+	check(Locations.Num() == Normals.Num());
+	if (Locations.Num() <= BlockChunkSize)
+	{
+		return;
+	}
+
+	TArray<int32> OrderLocal;
+	OrderLocal.SetNumUninitialized(Locations.Num());
+	for (int32 IndexLocal = 0; IndexLocal < OrderLocal.Num(); ++IndexLocal)
+	{
+		OrderLocal[IndexLocal] = IndexLocal;
+	}
+
+	// split at the median of the longest axis until the runs are chunk sized. Splits land on multiples of BlockChunkSize, so the runs
+	// RegisterAnchorBlock cuts line up with them
+	TArray<TPair<int32, int32>, TInlineAllocator<64>> PendingRunsLocal;
+	PendingRunsLocal.Emplace(0, OrderLocal.Num());
+	while (PendingRunsLocal.Num() > 0)
+	{
+		const TPair<int32, int32> RunLocal = PendingRunsLocal.Pop(false);
+		if (RunLocal.Value <= BlockChunkSize)
+		{
+			continue;
+		}
+
+		FBox BoundsLocal(ForceInit);
+		for (int32 IndexLocal = RunLocal.Key; IndexLocal < RunLocal.Key + RunLocal.Value; ++IndexLocal)
+		{
+			BoundsLocal += Locations[OrderLocal[IndexLocal]];
+		}
+		const FVector ExtentLocal = BoundsLocal.GetExtent();
+		const int32 AxisLocal = ExtentLocal.X >= ExtentLocal.Y && ExtentLocal.X >= ExtentLocal.Z ? 0 : (ExtentLocal.Y >= ExtentLocal.Z ? 1 : 2);
+		Sort(OrderLocal.GetData() + RunLocal.Key, RunLocal.Value, [&Locations, AxisLocal](int32 A, int32 B) { return Locations[A][AxisLocal] < Locations[B][AxisLocal]; });
+
+		const int32 LeftNumLocal = (FMath::DivideAndRoundUp(RunLocal.Value, BlockChunkSize) / 2) * BlockChunkSize;
+		PendingRunsLocal.Emplace(RunLocal.Key, LeftNumLocal);
+		PendingRunsLocal.Emplace(RunLocal.Key + LeftNumLocal, RunLocal.Value - LeftNumLocal);
+	}
+
+	TArray<FVector> SortedLocationsLocal;
+	TArray<FVector> SortedNormalsLocal;
+	SortedLocationsLocal.Reserve(OrderLocal.Num());
+	SortedNormalsLocal.Reserve(OrderLocal.Num());
+	for (const int32 IndexLocal : OrderLocal)
+	{
+		SortedLocationsLocal.Add(Locations[IndexLocal]);
+		SortedNormalsLocal.Add(Normals[IndexLocal]);
+	}
+	Locations = MoveTemp(SortedLocationsLocal);
+	Normals = MoveTemp(SortedNormalsLocal);
+}
+
+bool UGrappleAnchorSubsystem::GetAnchorLocation(int32 AnchorId, FVector& OutLocation) const
+{
+	if (!Anchors.IsValidIndex(AnchorId))
+	{
+		return false;
+	}
+	OutLocation = Anchors[AnchorId].Location;
+	return true;
+}
+
+int32 UGrappleAnchorSubsystem::AddAnchor(const FVector& Location)
+{
+	const int32 AnchorIdLocal = Anchors.Add(FAnchorEntry());
+	FAnchorEntry& EntryLocal = Anchors[AnchorIdLocal];
+	EntryLocal.Location = Location;
+	EntryLocal.ProxyId = AnchorTree.CreateProxy(FBox(Location, Location), AnchorIdLocal);
+	return AnchorIdLocal;
+}
+
+void UGrappleAnchorSubsystem::RemoveAnchor(int32 AnchorId)
+{
+	AnchorTree.DestroyProxy(Anchors[AnchorId].ProxyId);
+	Anchors.RemoveAt(AnchorId);
+}
+
+void UGrappleAnchorSubsystem::RemoveComponentAnchor(int32 AnchorId)
+{
+	const FAnchorEntry& EntryLocal = Anchors[AnchorId];
+	ComponentToAnchor.Remove(EntryLocal.ComponentKey);
+	if (USceneComponent* ComponentLocal = EntryLocal.Component.Get())
+	{
+		ComponentLocal->TransformUpdated.RemoveAll(this);
+	}
+	if (EntryLocal.OwnerKey != TObjectKey<AActor>())
+	{
+		OwnerToAnchors.RemoveSingle(EntryLocal.OwnerKey, AnchorId);
+		AActor* OwnerLocal = EntryLocal.OwnerKey.ResolveObjectPtr();
+		if (OwnerLocal && !OwnerToAnchors.Contains(EntryLocal.OwnerKey))
+		{
+			OwnerLocal->OnEndPlay.RemoveDynamic(this, &UGrappleAnchorSubsystem::OnAnchorOwnerEndPlay);
+		}
+	}
+	RemoveAnchor(AnchorId);
+}
+
+void UGrappleAnchorSubsystem::OnAnchorOwnerEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	TArray<int32, TInlineAllocator<4>> AnchorIdsLocal;
+	OwnerToAnchors.MultiFind(Actor, AnchorIdsLocal);
+	for (const int32 AnchorIdLocal : AnchorIdsLocal)
+	{
+		RemoveComponentAnchor(AnchorIdLocal);
+	}
+}
+
+void UGrappleAnchorSubsystem::OnAnchorComponentMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	const int32* AnchorIdLocal = ComponentToAnchor.Find(UpdatedComponent);
+	if (!AnchorIdLocal)
+	{
+		return;
+	}
+
+	FAnchorEntry& EntryLocal = Anchors[*AnchorIdLocal];
+	const FVector NewLocationLocal = UpdatedComponent->GetComponentTransform().TransformPosition(EntryLocal.LocalOffset);
+	// teleports shouldn't stretch the fat box along the jump
+	const FVector DisplacementLocal = Teleport == ETeleportType::None ? NewLocationLocal - EntryLocal.Location : FVector::ZeroVector;
+	EntryLocal.Location = NewLocationLocal;
+	AnchorTree.MoveProxy(EntryLocal.ProxyId, FBox(NewLocationLocal, NewLocationLocal), DisplacementLocal);
+}
+
+FGrappleAnchorQuery UGrappleAnchorSubsystem::StartConeQuery(const FGrappleAnchorCone& Cone) const
+{
+	FGrappleAnchorQuery QueryLocal;
+	QueryLocal.Result = MakeShared<FGrappleAnchorQueryResult, ESPMode::ThreadSafe>();
+
+	// bounds of the cone: apex plus the cap disc at MaxDistance
+	const FVector CapCenterLocal = Cone.Origin + (Cone.Direction * Cone.MaxDistance);
+	const double CapRadiusLocal = Cone.MaxDistance * FMath::Tan(FMath::DegreesToRadians(Cone.HalfAngleDegrees));
+	FBox ConeBoundsLocal(Cone.Origin, Cone.Origin);
+	ConeBoundsLocal += FBox(CapCenterLocal - FVector(CapRadiusLocal), CapCenterLocal + FVector(CapRadiusLocal));
+
+	// snapshot the candidate locations so the worker never touches the tree or components
+	TArray<FGrappleAnchorCandidate> CandidatesLocal;
+	AnchorTree.Query(ConeBoundsLocal, [this, &CandidatesLocal, &ConeBoundsLocal](int32 ProxyId, int32 UserData)
+	{
+		if (UserData & BlockUserDataFlag)
+		{
+			// baked block chunk, only its points inside the cone bounds go to the worker
+			const FAnchorBlockChunk& ChunkLocal = AnchorBlockChunks[UserData & ~BlockUserDataFlag];
+			const FAnchorBlock& BlockLocal = AnchorBlocks[ChunkLocal.BlockId];
+			for (int32 IndexLocal = ChunkLocal.Start; IndexLocal < ChunkLocal.Start + ChunkLocal.Num; ++IndexLocal)
+			{
+				if (ConeBoundsLocal.IsInsideOrOn(BlockLocal.Locations[IndexLocal]))
+				{
+					FGrappleAnchorCandidate& CandidateLocal = CandidatesLocal.AddDefaulted_GetRef();
+					CandidateLocal.Location = BlockLocal.Locations[IndexLocal];
+					CandidateLocal.Normal = BlockLocal.Normals[IndexLocal];
+				}
+			}
+			return true;
+		}
+
+		FGrappleAnchorCandidate& CandidateLocal = CandidatesLocal.AddDefaulted_GetRef();
+		CandidateLocal.AnchorId = UserData;
+		CandidateLocal.Location = Anchors[UserData].Location;
+		return true;
+	});
+
+	if (CandidatesLocal.Num() == 0)
+	{
+		// nothing to score, the query is complete without a task
+		return QueryLocal;
+	}
+
+	QueryLocal.Task = FFunctionGraphTask::CreateAndDispatchWhenReady([Cone, Candidates = MoveTemp(CandidatesLocal), Result = QueryLocal.Result]()
+	{
+		*Result = ScoreCandidates(Cone, Candidates);
+	}, TStatId(), nullptr, ENamedThreads::AnyBackgroundThreadNormalTask);
+
+	return QueryLocal;
+}
+
+bool UGrappleAnchorSubsystem::FindAnchorInRange(const FVector& Origin, float Range, FRandomStream& RandomStream, FVector& OutLocation) const
+{
+	const double RangeSquaredLocal = FMath::Square(static_cast<double>(Range));
+	int32 NumInRangeLocal = 0;
+
+	// reservoir sampling, every anchor in range is kept with the same probability without gathering them
+	auto ConsiderLocal = [&](const FVector& Location)
+	{
+		if (FVector::DistSquared(Location, Origin) <= RangeSquaredLocal && RandomStream.RandRange(0, NumInRangeLocal++) == 0)
+		{
+			OutLocation = Location;
+		}
+	};
+
+	AnchorTree.Query(FBox(Origin - FVector(Range), Origin + FVector(Range)), [this, &ConsiderLocal](int32 ProxyId, int32 UserData)
+	{
+		if (UserData & BlockUserDataFlag)
+		{
+			const FAnchorBlockChunk& ChunkLocal = AnchorBlockChunks[UserData & ~BlockUserDataFlag];
+			for (const FVector& LocationLocal : MakeArrayView(AnchorBlocks[ChunkLocal.BlockId].Locations).Slice(ChunkLocal.Start, ChunkLocal.Num))
+			{
+				ConsiderLocal(LocationLocal);
+			}
+		}
+		else
+		{
+			ConsiderLocal(Anchors[UserData].Location);
+		}
+		return true;
+	});
+
+	return NumInRangeLocal > 0;
+}
+
+FGrappleAnchorQueryResult UGrappleAnchorSubsystem::ScoreCandidates(const FGrappleAnchorCone& Cone, TConstArrayView<FGrappleAnchorCandidate> Candidates)
+{
+	FGrappleAnchorQueryResult ResultLocal;
+	ResultLocal.NumCandidates = Candidates.Num();
+
+	const float CosHalfAngleLocal = FMath::Cos(FMath::DegreesToRadians(Cone.HalfAngleDegrees));
+	const float AngleRangeLocal = FMath::Max(1.f - CosHalfAngleLocal, KINDA_SMALL_NUMBER);
+	const double MaxDistanceSquaredLocal = FMath::Square(static_cast<double>(Cone.MaxDistance));
+
+	for (const FGrappleAnchorCandidate& CandidateLocal : Candidates)
+	{
+		const FVector ToAnchorLocal = CandidateLocal.Location - Cone.Origin;
+		const double DistanceSquaredLocal = ToAnchorLocal.SizeSquared();
+		if (DistanceSquaredLocal > MaxDistanceSquaredLocal || DistanceSquaredLocal <= SMALL_NUMBER)
+		{
+			continue;
+		}
+
+		if (FVector::DotProduct(CandidateLocal.Normal, ToAnchorLocal) > 0.0)
+		{
+			// baked surface faces away from the viewer
+			continue;
+		}
+
+		const double DistanceLocal = FMath::Sqrt(DistanceSquaredLocal);
+		const float CosAngleLocal = static_cast<float>(FVector::DotProduct(ToAnchorLocal, Cone.Direction) / DistanceLocal);
+		if (CosAngleLocal < CosHalfAngleLocal)
+		{
+			continue;
+		}
+
+		// closer to the cone axis and closer to the origin both score higher
+		const float AngleScoreLocal = (CosAngleLocal - CosHalfAngleLocal) / AngleRangeLocal;
+		const float DistanceScoreLocal = 1.f - static_cast<float>(DistanceLocal / Cone.MaxDistance);
+		const float ScoreLocal = (AngleScoreLocal * Cone.AngleWeight) + (DistanceScoreLocal * (1.f - Cone.AngleWeight));
+		if (ScoreLocal > ResultLocal.Best.Score)
+		{
+			ResultLocal.Best = CandidateLocal;
+			ResultLocal.Best.Score = ScoreLocal;
+			ResultLocal.bFound = true;
+		}
+	}
+
+	return ResultLocal;
+}
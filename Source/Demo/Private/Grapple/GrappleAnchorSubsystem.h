@@ -0,0 +1,178 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "GrappleAnchorTree.h"
+#include "GrappleAnchorSubsystem.generated.h"
+
+/** One scored anchor candidate */
+struct FGrappleAnchorCandidate
+{
+	FVector Location{ 0.f };
+	/** Surface normal for baked anchors, zero for component/point anchors (no facing test) */
+	FVector Normal{ 0.f };
+	/** Anchor id, INDEX_NONE for anchors that come from a baked block */
+	int32 AnchorId{ INDEX_NONE };
+	float Score{ -1.f };
+};
+
+/** Result of a cone query, written by the scoring task and read on the game thread once the task completed */
+struct FGrappleAnchorQueryResult
+{
+	FGrappleAnchorCandidate Best;
+	int32 NumCandidates{ 0 };
+	bool bFound{ false };
+};
+
+/**
+ * Handle to an in-flight cone query. The candidates are gathered from the anchor tree on the game thread (a snapshot of their locations)
+ * and scored on a task graph worker, so the tree is never read off the game thread.
+ */
+struct FGrappleAnchorQuery
+{
+	FGraphEventRef Task;
+	TSharedPtr<FGrappleAnchorQueryResult, ESPMode::ThreadSafe> Result;
+
+	FORCEINLINE bool IsValid() const { return Result.IsValid(); }
+	FORCEINLINE bool IsComplete() const { return IsValid() && (!Task.IsValid() || Task->IsComplete()); }
+	FORCEINLINE void Reset() { Task.SafeRelease(); Result.Reset(); }
+};
+
+/** Cone used for aim assist/auto targeting */
+struct FGrappleAnchorCone
+{
+	FVector Origin{ 0.f };
+	/** Must be normalized */
+	FVector Direction{ FVector::ForwardVector };
+	float MaxDistance{ 10000.f };
+	float HalfAngleDegrees{ 8.f };
+	/** 1 = only the angle to the cone axis matters, 0 = only the distance matters */
+	float AngleWeight{ 0.75f };
+};
+
+/**
+ * World subsystem that indexes grapple anchor points in a dynamic AABB tree.
+ * Anchors are registered components (plus an optional local offset). Components are followed through their TransformUpdated delegate whatever
+ * their mobility (it only fires when they move, and mobility can change after registration), so the tree updates incrementally as WorldDynamic
+ * actors move instead of being rebuilt or polled. Component anchors go away with their owner's EndPlay even if nobody unregisters them.
+ * Offline baked anchors (see AGrappleAnchorCellActor) are registered as blocks cut into runs of BlockChunkSize points, one tree leaf per run.
+ * The bake orders the points (SortAnchorBlock) so every run is a compact cluster, so registering a streamed in cell stays a single O(n) pass
+ * with a handful of tree inserts, and queries only visit the runs near them instead of every point of the cell.
+ */
+UCLASS()
+class UGrappleAnchorSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+public:
+	/** Most points per block tree leaf */
+	static constexpr int32 BlockChunkSize = 64;
+
+protected:
+	struct FAnchorEntry
+	{
+		FVector Location{ 0.f };
+		FVector LocalOffset{ 0.f };
+		TWeakObjectPtr<USceneComponent> Component;
+		/** Key of Component in ComponentToAnchor, still valid once Component is gone */
+		TObjectKey<USceneComponent> ComponentKey;
+		/** Owner of Component, key in OwnerToAnchors */
+		TObjectKey<AActor> OwnerKey;
+		int32 ProxyId{ FGrappleAnchorTree::NullNode };
+	};
+
+	struct FAnchorBlock
+	{
+		TArray<FVector> Locations;
+		TArray<FVector> Normals;
+		/** Chunks (AnchorBlockChunks) covering Locations */
+		TArray<int32> ChunkIds;
+	};
+
+	/** Run of consecutive points of a block with its own tree leaf */
+	struct FAnchorBlockChunk
+	{
+		int32 BlockId{ INDEX_NONE };
+		int32 Start{ 0 };
+		int32 Num{ 0 };
+		int32 ProxyId{ FGrappleAnchorTree::NullNode };
+	};
+
+	/** Tree user data with this bit set refers to an anchor block chunk instead of a single anchor */
+	static constexpr int32 BlockUserDataFlag = 1 << 30;
+
+	/** Anchors by id (ids are stable while registered) */
+	TSparseArray<FAnchorEntry> Anchors;
+	/** Baked anchor blocks by id */
+	TSparseArray<FAnchorBlock> AnchorBlocks;
+	/** Tree leaves of the blocks */
+	TSparseArray<FAnchorBlockChunk> AnchorBlockChunks;
+	/** Component anchors by component */
+	TMap<TObjectKey<USceneComponent>, int32> ComponentToAnchor;
+	/** Component anchors by owner, the owner's OnEndPlay is bound while it has any */
+	TMultiMap<TObjectKey<AActor>, int32> OwnerToAnchors;
+	/** Spatial index over Anchors */
+	FGrappleAnchorTree AnchorTree;
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	/********************************
+	* MEMBER METHODS
+	********************************/
+public:
+	/** Registers Component (at LocalOffset in its space) as an anchor, followed as it moves until it is unregistered or its owner ends play. Returns the anchor id */
+	int32 RegisterAnchorComponent(USceneComponent* Component, const FVector& LocalOffset = FVector::ZeroVector);
+	/** Removes a component anchor */
+	void UnregisterAnchorComponent(USceneComponent* Component);
+	/** Registers a fixed world space anchor (no component). Returns the anchor id */
+	int32 RegisterAnchorPoint(const FVector& Location);
+	/** Removes an anchor by id */
+	void UnregisterAnchor(int32 AnchorId);
+	/** Registers a block of fixed, baked anchors (world space locations and surface normals, same length), ideally ordered by SortAnchorBlock. Returns the block id */
+	int32 RegisterAnchorBlock(TArray<FVector>&& Locations, TArray<FVector>&& Normals);
+	/** Removes a baked anchor block */
+	void UnregisterAnchorBlock(int32 BlockId);
+
+	/** Gathers the anchors inside the cone and launches a task graph task that scores them. Poll the returned query with IsComplete() */
+	FGrappleAnchorQuery StartConeQuery(const FGrappleAnchorCone& Cone) const;
+
+	/** Picks a random anchor (component, point or baked) within Range of Origin, uniformly over the anchors in range. Synchronous, game thread only */
+	bool FindAnchorInRange(const FVector& Origin, float Range, FRandomStream& RandomStream, FVector& OutLocation) const;
+
+	FORCEINLINE int32 GetNumAnchors() const { return Anchors.Num(); }
+	FORCEINLINE int32 GetNumAnchorBlocks() const { return AnchorBlocks.Num(); }
+	/** Current location of an anchor (invalid ids return false) */
+	bool GetAnchorLocation(int32 AnchorId, FVector& OutLocation) const;
+
+	/** Reorders a block so every run of BlockChunkSize points is a compact cluster (median splits along the longest axis). Bake time, O(n log^2 n) */
+	static void SortAnchorBlock(TArray<FVector>& Locations, TArray<FVector>& Normals);
+
+	/** Scores candidates against a cone and returns the best one. Pure function, safe to run on any thread */
+	static FGrappleAnchorQueryResult ScoreCandidates(const FGrappleAnchorCone& Cone, TConstArrayView<FGrappleAnchorCandidate> Candidates);
+
+protected:
+	int32 AddAnchor(const FVector& Location);
+	void RemoveAnchor(int32 AnchorId);
+	/** Removes a component anchor and unbinds its component and, if it was the last one, its owner (either may already be gone) */
+	void RemoveComponentAnchor(int32 AnchorId);
+	/** TransformUpdated handler for anchor components */
+	void OnAnchorComponentMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+	/** OnEndPlay handler for the owners of anchor components, destroyed or streamed out components take their anchors with them */
+	UFUNCTION()
+	void OnAnchorOwnerEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+};
@@ -0,0 +1,315 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleAnchorTree.h"
+
+namespace GrappleAnchorTree
+{
+	/** Moving anchors get their fat box stretched this many times their last displacement so steady movers rarely reinsert */
+	constexpr double DisplacementMultiplier = 4.0;
+}
+
+FGrappleAnchorTree::FGrappleAnchorTree(float InFatMargin)
+	: FatMargin(InFatMargin)
+{
+}
+
+int32 FGrappleAnchorTree::CreateProxy(const FBox& Box, int32 UserData)
+{
+	const int32 ProxyIdLocal = AllocateNode();
+	FNode& NodeLocal = Nodes[ProxyIdLocal];
+	NodeLocal.Box = Box.ExpandBy(FatMargin);
+	NodeLocal.UserData = UserData;
+	NodeLocal.Height = 0;
+
+	InsertLeaf(ProxyIdLocal);
+	++NumLeaves;
+	return ProxyIdLocal;
+}
+
+void FGrappleAnchorTree::DestroyProxy(int32 ProxyId)
+{
+	check(Nodes.IsValidIndex(ProxyId) && Nodes[ProxyId].IsLeaf());
+
+	RemoveLeaf(ProxyId);
+	FreeNode(ProxyId);
+	--NumLeaves;
+}
+
+bool FGrappleAnchorTree::MoveProxy(int32 ProxyId, const FBox& Box, const FVector& Displacement)
+{
+	check(Nodes.IsValidIndex(ProxyId) && Nodes[ProxyId].IsLeaf());
+
+	if (Nodes[ProxyId].Box.IsInside(Box))
+	{
+		// still inside its fat box, nothing to do
+		return false;
+	}
+
+	RemoveLeaf(ProxyId);
+
+	// grow the new fat box in the direction of travel
+	FBox FatBoxLocal = Box.ExpandBy(FatMargin);
+	const FVector PredictedLocal = Displacement * GrappleAnchorTree::DisplacementMultiplier;
+	FatBoxLocal.Min += FVector(FMath::Min(PredictedLocal.X, 0.0), FMath::Min(PredictedLocal.Y, 0.0), FMath::Min(PredictedLocal.Z, 0.0));
+	FatBoxLocal.Max += FVector(FMath::Max(PredictedLocal.X, 0.0), FMath::Max(PredictedLocal.Y, 0.0), FMath::Max(PredictedLocal.Z, 0.0));
+	Nodes[ProxyId].Box = FatBoxLocal;
+
+	InsertLeaf(ProxyId);
+	return true;
+}
+
+void FGrappleAnchorTree::Reset()
+{
+	Nodes.Reset();
+	Root = NullNode;
+	FreeList = NullNode;
+	NumLeaves = 0;
+}
+
+void FGrappleAnchorTree::Reserve(int32 NumProxies)
+{
+	// a tree with n leaves has n - 1 internal nodes
+	Nodes.Reserve(FMath::Max(0, (NumLeaves + NumProxies) * 2 - 1));
+}
+
+int32 FGrappleAnchorTree::AllocateNode()
+{
+	if (FreeList != NullNode)
+	{
+		const int32 NodeIdLocal = FreeList;
+		FreeList = Nodes[NodeIdLocal].ParentOrNext;
+		Nodes[NodeIdLocal] = FNode();
+		return NodeIdLocal;
+	}
+
+	return Nodes.AddDefaulted();
+}
+
+void FGrappleAnchorTree::FreeNode(int32 NodeId)
+{
+	FNode& NodeLocal = Nodes[NodeId];
+	NodeLocal.ParentOrNext = FreeList;
+	NodeLocal.Child1 = NullNode;
+	NodeLocal.Child2 = NullNode;
+	NodeLocal.Height = -1;
+	NodeLocal.UserData = INDEX_NONE;
+	FreeList = NodeId;
+}
+
+double FGrappleAnchorTree::GetSurfaceArea(const FBox& Box)
+{
+	const FVector ExtentLocal = Box.Max - Box.Min;
+	return 2.0 * (ExtentLocal.X * ExtentLocal.Y + ExtentLocal.Y * ExtentLocal.Z + ExtentLocal.Z * ExtentLocal.X);
+}
+
+void FGrappleAnchorTree::InsertLeaf(int32 LeafId)
+{
+	if (Root == NullNode)
+	{
+		Root = LeafId;
+		Nodes[Root].ParentOrNext = NullNode;
+		return;
+	}
+
+	// find the best sibling with the surface area heuristic
+	const FBox LeafBoxLocal = Nodes[LeafId].Box;
+	int32 IndexLocal = Root;
+	while (!Nodes[IndexLocal].IsLeaf())
+	{
+		const FNode& NodeLocal = Nodes[IndexLocal];
+		const double AreaLocal = GetSurfaceArea(NodeLocal.Box);
+		const double CombinedAreaLocal = GetSurfaceArea(NodeLocal.Box + LeafBoxLocal);
+
+		// cost of creating a new parent for this node and the new leaf
+		const double CostLocal = 2.0 * CombinedAreaLocal;
+		// minimum cost of pushing the leaf further down the tree
+		const double InheritanceCostLocal = 2.0 * (CombinedAreaLocal - AreaLocal);
+
+		auto DescendCost = [this, &LeafBoxLocal, InheritanceCostLocal](int32 ChildId)
+		{
+			const FNode& ChildLocal = Nodes[ChildId];
+			const double NewAreaLocal = GetSurfaceArea(ChildLocal.Box + LeafBoxLocal);
+			return ChildLocal.IsLeaf() ? NewAreaLocal + InheritanceCostLocal : (NewAreaLocal - GetSurfaceArea(ChildLocal.Box)) + InheritanceCostLocal;
+		};
+		const double Cost1Local = DescendCost(NodeLocal.Child1);
+		const double Cost2Local = DescendCost(NodeLocal.Child2);
+
+		if (CostLocal < Cost1Local && CostLocal < Cost2Local)
+		{
+			break;
+		}
+		IndexLocal = Cost1Local < Cost2Local ? NodeLocal.Child1 : NodeLocal.Child2;
+	}
+
+	// create a new parent for the sibling and the leaf
+	const int32 SiblingLocal = IndexLocal;
+	const int32 OldParentLocal = Nodes[SiblingLocal].ParentOrNext;
+	const int32 NewParentLocal = AllocateNode();
+	{
+		FNode& NewParentNodeLocal = Nodes[NewParentLocal];
+		NewParentNodeLocal.ParentOrNext = OldParentLocal;
+		NewParentNodeLocal.Box = LeafBoxLocal + Nodes[SiblingLocal].Box;
+		NewParentNodeLocal.Height = Nodes[SiblingLocal].Height + 1;
+		NewParentNodeLocal.Child1 = SiblingLocal;
+		NewParentNodeLocal.Child2 = LeafId;
+	}
+
+	if (OldParentLocal != NullNode)
+	{
+		FNode& OldParentNodeLocal = Nodes[OldParentLocal];
+		if (OldParentNodeLocal.Child1 == SiblingLocal)
+		{
+			OldParentNodeLocal.Child1 = NewParentLocal;
+		}
+		else
+		{
+			OldParentNodeLocal.Child2 = NewParentLocal;
+		}
+	}
+	else
+	{
+		Root = NewParentLocal;
+	}
+	Nodes[SiblingLocal].ParentOrNext = NewParentLocal;
+	Nodes[LeafId].ParentOrNext = NewParentLocal;
+
+	// walk back up fixing heights and boxes
+	IndexLocal = Nodes[LeafId].ParentOrNext;
+	while (IndexLocal != NullNode)
+	{
+		IndexLocal = Balance(IndexLocal);
+
+		FNode& NodeLocal = Nodes[IndexLocal];
+		NodeLocal.Height = 1 + FMath::Max(Nodes[NodeLocal.Child1].Height, Nodes[NodeLocal.Child2].Height);
+		NodeLocal.Box = Nodes[NodeLocal.Child1].Box + Nodes[NodeLocal.Child2].Box;
+
+		IndexLocal = NodeLocal.ParentOrNext;
+	}
+}
+
+void FGrappleAnchorTree::RemoveLeaf(int32 LeafId)
+{
+	if (LeafId == Root)
+	{
+		Root = NullNode;
+		return;
+	}
+
+	const int32 ParentLocal = Nodes[LeafId].ParentOrNext;
+	const int32 GrandParentLocal = Nodes[ParentLocal].ParentOrNext;
+	const int32 SiblingLocal = Nodes[ParentLocal].Child1 == LeafId ? Nodes[ParentLocal].Child2 : Nodes[ParentLocal].Child1;
+
+	if (GrandParentLocal != NullNode)
+	{
+		// replace the parent with the sibling
+		FNode& GrandParentNodeLocal = Nodes[GrandParentLocal];
+		if (GrandParentNodeLocal.Child1 == ParentLocal)
+		{
+			GrandParentNodeLocal.Child1 = SiblingLocal;
+		}
+		else
+		{
+			GrandParentNodeLocal.Child2 = SiblingLocal;
+		}
+		Nodes[SiblingLocal].ParentOrNext = GrandParentLocal;
+		FreeNode(ParentLocal);
+
+		int32 IndexLocal = GrandParentLocal;
+		while (IndexLocal != NullNode)
+		{
+			IndexLocal = Balance(IndexLocal);
+
+			FNode& NodeLocal = Nodes[IndexLocal];
+			NodeLocal.Box = Nodes[NodeLocal.Child1].Box + Nodes[NodeLocal.Child2].Box;
+			NodeLocal.Height = 1 + FMath::Max(Nodes[NodeLocal.Child1].Height, Nodes[NodeLocal.Child2].Height);
+
+			IndexLocal = NodeLocal.ParentOrNext;
+		}
+	}
+	else
+	{
+		Root = SiblingLocal;
+		Nodes[SiblingLocal].ParentOrNext = NullNode;
+		FreeNode(ParentLocal);
+	}
+}
+
+int32 FGrappleAnchorTree::Balance(int32 NodeId)
+{
+	const int32 ALocal = NodeId;
+	FNode& A = Nodes[ALocal];
+	if (A.IsLeaf() || A.Height < 2)
+	{
+		return ALocal;
+	}
+
+	const int32 BLocal = A.Child1;
+	const int32 CLocal = A.Child2;
+	const int32 BalanceLocal = Nodes[CLocal].Height - Nodes[BLocal].Height;
+
+	// rotates Child up over A, Other stays under A. Returns the new subtree root
+	auto Rotate = [this, ALocal](int32 ChildId, int32 OtherId, bool bChildIsChild2)
+	{
+		FNode& NodeA = Nodes[ALocal];
+		FNode& NodeChild = Nodes[ChildId];
+		const int32 FLocal = NodeChild.Child1;
+		const int32 GLocal = NodeChild.Child2;
+
+		// swap A and Child
+		NodeChild.Child1 = ALocal;
+		NodeChild.ParentOrNext = NodeA.ParentOrNext;
+		NodeA.ParentOrNext = ChildId;
+
+		// A's old parent should point to Child
+		if (NodeChild.ParentOrNext != NullNode)
+		{
+			FNode& ParentLocal = Nodes[NodeChild.ParentOrNext];
+			if (ParentLocal.Child1 == ALocal)
+			{
+				ParentLocal.Child1 = ChildId;
+			}
+			else
+			{
+				ParentLocal.Child2 = ChildId;
+			}
+		}
+		else
+		{
+			Root = ChildId;
+		}
+
+		// keep the taller grandchild under Child, move the shorter one under A
+		const bool bKeepFLocal = Nodes[FLocal].Height > Nodes[GLocal].Height;
+		const int32 KeepLocal = bKeepFLocal ? FLocal : GLocal;
+		const int32 MoveLocal = bKeepFLocal ? GLocal : FLocal;
+
+		NodeChild.Child2 = KeepLocal;
+		if (bChildIsChild2)
+		{
+			NodeA.Child2 = MoveLocal;
+		}
+		else
+		{
+			NodeA.Child1 = MoveLocal;
+		}
+		Nodes[MoveLocal].ParentOrNext = ALocal;
+
+		NodeA.Box = Nodes[OtherId].Box + Nodes[MoveLocal].Box;
+		NodeChild.Box = NodeA.Box + Nodes[KeepLocal].Box;
+		NodeA.Height = 1 + FMath::Max(Nodes[OtherId].Height, Nodes[MoveLocal].Height);
+		NodeChild.Height = 1 + FMath::Max(NodeA.Height, Nodes[KeepLocal].Height);
+
+		return ChildId;
+	};
+
+	if (BalanceLocal > 1)
+	{
+		return Rotate(CLocal, BLocal, true);
+	}
+	if (BalanceLocal < -1)
+	{
+		return Rotate(BLocal, CLocal, false);
+	}
+	return ALocal;
+}
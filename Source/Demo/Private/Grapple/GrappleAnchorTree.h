@@ -0,0 +1,103 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Dynamic AABB tree (incrementally balanced binary BVH) over grapple anchors.
+ * Leaves store a "fat" box (the anchor bounds grown by a margin) so an anchor that moves a little only updates its stored location;
+ * the leaf is removed and reinserted only once the anchor leaves its fat box. Insert/remove/move are O(log n), queries visit only overlapping branches.
+ */
+class FGrappleAnchorTree
+{
+public:
+	static constexpr int32 NullNode = INDEX_NONE;
+
+	explicit FGrappleAnchorTree(float InFatMargin = 50.f);
+
+	/** Adds a leaf for Box and returns its proxy id. UserData is handed back by queries */
+	int32 CreateProxy(const FBox& Box, int32 UserData);
+	/** Removes a leaf */
+	void DestroyProxy(int32 ProxyId);
+	/** Updates a leaf after its anchor moved. Displacement predicts further movement (grows the fat box in that direction). Returns true if the leaf had to be reinserted */
+	bool MoveProxy(int32 ProxyId, const FBox& Box, const FVector& Displacement);
+
+	/** Calls Visitor(ProxyId, UserData) for every leaf whose fat box overlaps Box. Stops early if the visitor returns false */
+	template<typename VisitorType>
+	void Query(const FBox& Box, VisitorType&& Visitor) const
+	{
+		if (Root == NullNode)
+		{
+			return;
+		}
+
+		TArray<int32, TInlineAllocator<64>> StackLocal;
+		StackLocal.Push(Root);
+		while (StackLocal.Num() > 0)
+		{
+			const int32 NodeIdLocal = StackLocal.Pop(false);
+			const FNode& NodeLocal = Nodes[NodeIdLocal];
+			if (!NodeLocal.Box.Intersect(Box))
+			{
+				continue;
+			}
+
+			if (NodeLocal.IsLeaf())
+			{
+				if (!Visitor(NodeIdLocal, NodeLocal.UserData))
+				{
+					return;
+				}
+			}
+			else
+			{
+				StackLocal.Push(NodeLocal.Child1);
+				StackLocal.Push(NodeLocal.Child2);
+			}
+		}
+	}
+
+	FORCEINLINE int32 GetUserData(int32 ProxyId) const { return Nodes[ProxyId].UserData; }
+	FORCEINLINE const FBox& GetFatBox(int32 ProxyId) const { return Nodes[ProxyId].Box; }
+	FORCEINLINE int32 Num() const { return NumLeaves; }
+	/** Height of the tree (0 for a single leaf), useful to check the balancing */
+	FORCEINLINE int32 GetHeight() const { return Root == NullNode ? 0 : Nodes[Root].Height; }
+
+	/** Removes every leaf but keeps the node storage */
+	void Reset();
+	/** Grows the node storage up front (bulk registration) */
+	void Reserve(int32 NumProxies);
+
+private:
+	struct FNode
+	{
+		/** Fat box for leaves, union of the children for internal nodes */
+		FBox Box{ ForceInit };
+		/** Parent node, or the next free node while on the free list */
+		int32 ParentOrNext{ NullNode };
+		int32 Child1{ NullNode };
+		int32 Child2{ NullNode };
+		/** Leaf = 0, free node = -1 */
+		int32 Height{ -1 };
+		int32 UserData{ INDEX_NONE };
+
+		FORCEINLINE bool IsLeaf() const { return Child1 == NullNode; }
+	};
+
+	int32 AllocateNode();
+	void FreeNode(int32 NodeId);
+	void InsertLeaf(int32 LeafId);
+	void RemoveLeaf(int32 LeafId);
+	/** AVL style rotation that keeps the tree height logarithmic. Returns the new root of the subtree */
+	int32 Balance(int32 NodeId);
+
+	static double GetSurfaceArea(const FBox& Box);
+
+	TArray<FNode> Nodes;
+	int32 Root{ NullNode };
+	int32 FreeList{ NullNode };
+	int32 NumLeaves{ 0 };
+	/** How much leaf boxes are grown so small movements don't touch the tree */
+	float FatMargin{ 50.f };
+};
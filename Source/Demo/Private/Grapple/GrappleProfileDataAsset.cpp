@@ -0,0 +1,13 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleProfileDataAsset.h"
+
+UGrappleProfileDataAsset::UGrappleProfileDataAsset()
+{
+	// Determine which grapple targets are allowed.
+	GrapplableTargets.Add(EObjectTypeQuery::ObjectTypeQuery1); // world static
+	GrapplableTargets.Add(EObjectTypeQuery::ObjectTypeQuery2); // world dyanmic
+	// To determine what the object type ewas use the collision channel, the engine auto coverts
+	// For more details look at EngineType.h
+}
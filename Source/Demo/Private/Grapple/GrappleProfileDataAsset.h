@@ -0,0 +1,129 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Engine/EngineTypes.h"
+#include "GrappleTetherSubsystem.h"
+#include "GrappleProfileDataAsset.generated.h"
+
+/**
+ * Grapple tuning shared by every character using it. Characters only hold a pointer, so a profile costs its memory once however many
+ * characters use it, and swapping the profile (per surface, per game mode, see UGrappleProfileSubsystem) is a pointer change.
+ * Read only at runtime: per character changes go in FGrappleProfileOverrides.
+ */
+UCLASS(BlueprintType)
+class UGrappleProfileDataAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	/** What targets can the player grapple onto. By default these will be world static and world dynamic. If you want to ensure just specific targets are allowed, create a custom object type
+	Old style Enum (TEnumAsByte) used as this is what unreal uses for the line trace */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Settings")
+	TArray<TEnumAsByte<EObjectTypeQuery>> GrapplableTargets;
+	/** How long can the grapple cable get (how far can the player grapple) */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Settings")
+	float GrappleLength{ 10000.f };
+	/** How fast does the cable launch from the character to the attach location */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Settings")
+	float GrappleAttachSpeed{ 50.f };
+	/** How fast does the character travel along the grapple to the attach location */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Settings")
+	float PlayerGrappleSpeed{ 250.f };
+	/** What velocity and direction does the character travel when they break off the grappling hook (there should be a Z value of some sort to give the appearance of detatching. Other values are optional) */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Settings")
+	FVector BreakOffGrappleVelocity{ 0.f, 0.f, 750.f };
+	/** How close to the attach location must the character be for the movement to accepted (larger values are useful here depending on the thickness of meshes to which the player can attach - a minimum of 45. based on starter content is recommended) */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Settings")
+	float GrappleAcceptanceRadius{ 45.f };
+	/** How far up from the ground can the character be before the grapple automatically releases them (when they arrived at the attach location). If using fall damage, this value should be SMALLER than the value used for fall damage */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Settings")
+	float GrappleAcceptedFallDistance{ 150.f };
+
+	/** When the aim itself misses, snap the grapple to the best registered anchor (see UGrappleAnchorComponent) inside a small cone around the aim */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Aim Assist")
+	bool bAimAssistEnabled{ true };
+	/** Half angle (degrees) of the aim assist cone */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Aim Assist", meta = (ClampMin = "0.0", ClampMax = "45.0"))
+	float AimAssistHalfAngle{ 8.f };
+
+	/** When the hook attaches to a body that simulates physics, pull the body on a tether instead of pulling the character to it */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Tether")
+	bool bTetherPhysicsBodies{ true };
+	/** How the tether pulls on the body */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Grappling|Tether")
+	FGrappleTetherSettings TetherSettings;
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleProfileDataAsset();
+
+	/********************************
+	* MEMBER METHODS
+	********************************/
+public:
+	FORCEINLINE const TArray<TEnumAsByte<EObjectTypeQuery>>& GetGrapplableTargets() const { return GrapplableTargets; }
+	FORCEINLINE float GetGrappleLength() const { return GrappleLength; }
+	FORCEINLINE float GetGrappleAttachSpeed() const { return GrappleAttachSpeed; }
+	FORCEINLINE float GetPlayerGrappleSpeed() const { return PlayerGrappleSpeed; }
+	FORCEINLINE const FVector& GetBreakOffGrappleVelocity() const { return BreakOffGrappleVelocity; }
+	FORCEINLINE float GetGrappleAcceptanceRadius() const { return GrappleAcceptanceRadius; }
+	FORCEINLINE float GetGrappleAcceptedFallDistance() const { return GrappleAcceptedFallDistance; }
+	FORCEINLINE bool IsAimAssistEnabled() const { return bAimAssistEnabled; }
+	FORCEINLINE float GetAimAssistHalfAngle() const { return AimAssistHalfAngle; }
+	FORCEINLINE bool ShouldTetherPhysicsBodies() const { return bTetherPhysicsBodies; }
+	FORCEINLINE const FGrappleTetherSettings& GetTetherSettings() const { return TetherSettings; }
+};
+
+/** Per character changes on top of its profile, each value only counts when its override flag is set */
+USTRUCT(BlueprintType)
+struct FGrappleProfileOverrides
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Grappling|Overrides", meta = (PinHiddenByDefault, InlineEditConditionToggle))
+	uint8 bOverride_GrappleLength : 1;
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Grappling|Overrides", meta = (PinHiddenByDefault, InlineEditConditionToggle))
+	uint8 bOverride_GrappleAttachSpeed : 1;
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Grappling|Overrides", meta = (PinHiddenByDefault, InlineEditConditionToggle))
+	uint8 bOverride_PlayerGrappleSpeed : 1;
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Grappling|Overrides", meta = (PinHiddenByDefault, InlineEditConditionToggle))
+	uint8 bOverride_BreakOffGrappleVelocity : 1;
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Grappling|Overrides", meta = (PinHiddenByDefault, InlineEditConditionToggle))
+	uint8 bOverride_GrappleAcceptanceRadius : 1;
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Grappling|Overrides", meta = (PinHiddenByDefault, InlineEditConditionToggle))
+	uint8 bOverride_GrappleAcceptedFallDistance : 1;
+
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Grappling|Overrides", meta = (EditCondition = "bOverride_GrappleLength"))
+	float GrappleLength{ 10000.f };
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Grappling|Overrides", meta = (EditCondition = "bOverride_GrappleAttachSpeed"))
+	float GrappleAttachSpeed{ 50.f };
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Grappling|Overrides", meta = (EditCondition = "bOverride_PlayerGrappleSpeed"))
+	float PlayerGrappleSpeed{ 250.f };
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Grappling|Overrides", meta = (EditCondition = "bOverride_BreakOffGrappleVelocity"))
+	FVector BreakOffGrappleVelocity{ 0.f, 0.f, 750.f };
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Grappling|Overrides", meta = (EditCondition = "bOverride_GrappleAcceptanceRadius"))
+	float GrappleAcceptanceRadius{ 45.f };
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Grappling|Overrides", meta = (EditCondition = "bOverride_GrappleAcceptedFallDistance"))
+	float GrappleAcceptedFallDistance{ 150.f };
+
+	FGrappleProfileOverrides()
+		: bOverride_GrappleLength(false)
+		, bOverride_GrappleAttachSpeed(false)
+		, bOverride_PlayerGrappleSpeed(false)
+		, bOverride_BreakOffGrappleVelocity(false)
+		, bOverride_GrappleAcceptanceRadius(false)
+		, bOverride_GrappleAcceptedFallDistance(false)
+	{
+	}
+};
@@ -0,0 +1,10 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleProfileSubsystem.h"
+#include "GrappleProfileDataAsset.h"
+
+void UGrappleProfileSubsystem::SetWorldProfile(const UGrappleProfileDataAsset* NewWorldProfile)
+{
+	WorldProfile = NewWorldProfile;
+}
@@ -0,0 +1,40 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GrappleProfileSubsystem.generated.h"
+
+class UGrappleProfileDataAsset;
+
+/**
+ * World wide grapple profile (e.g. set by the game mode). Characters without a profile of their own (see AGrappleCharacter::SetGrappleProfile)
+ * read it through this subsystem on every access, so swapping it changes every character at once without visiting any of them.
+ */
+UCLASS()
+class UGrappleProfileSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	/** Used in place of the characters' class profiles when set */
+	UPROPERTY(Transient)
+	TObjectPtr<const UGrappleProfileDataAsset> WorldProfile;
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* MEMBER METHODS
+	********************************/
+public:
+	/** Null goes back to the characters' class profiles */
+	UFUNCTION(BlueprintCallable, Category = "Grappling")
+	void SetWorldProfile(const UGrappleProfileDataAsset* NewWorldProfile);
+	UFUNCTION(BlueprintPure, Category = "Grappling")
+	FORCEINLINE const UGrappleProfileDataAsset* GetWorldProfile() const { return WorldProfile; }
+};
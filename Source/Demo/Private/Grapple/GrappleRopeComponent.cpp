@@ -0,0 +1,445 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleRopeComponent.h"
+#include "GrappleRopeSubsystem.h"
+#include "GrappleRopeMeshBuilder.h"
+#include "GrappleStats.h"
+#include "PrimitiveSceneProxy.h"
+#include "DynamicMeshBuilder.h"
+#include "StaticMeshResources.h"
+#include "LocalVertexFactory.h"
+#include "SceneManagement.h"
+#include "MaterialShared.h"
+#include "Materials/Material.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/CollisionProfile.h"
+
+/** Rope shape sent to the render thread */
+struct FGrappleRopeDynamicData
+{
+	/** Component space, the simulated span followed by the wrapped corners and the hook */
+	TArray<FVector3f> RopePoints;
+	int32 NumSides{ 0 };
+};
+
+/**
+ * Tube along the rope points. Vertex and index buffers are sized once for the most points and sides, updates are built straight into
+ * the locked vertex buffers by FGrappleRopeMeshBuilder. Rings are always MaxSides + 1 vertices apart and the index buffer holds one block
+ * per side count, so a rope with fewer points or sides draws the front of its block.
+ */
+class FGrappleRopeSceneProxy final : public FPrimitiveSceneProxy
+{
+public:
+	FGrappleRopeSceneProxy(const UGrappleRopeComponent* Component)
+		: FPrimitiveSceneProxy(Component)
+		, VertexFactory(GetScene().GetFeatureLevel(), "FGrappleRopeSceneProxy")
+		, MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel()))
+		, MaxSegments(Component->GetMaxRenderPoints() - 1)
+		, MinSides(FMath::Min(Component->GetMinSides(), Component->GetNumSides()))
+		, MaxSides(Component->GetNumSides())
+		, RopeRadius(0.5f * Component->GetRopeWidth())
+		, TileMaterial(Component->GetTileMaterial())
+	{
+		// the builder writes these exact formats
+		VertexBuffers.StaticMeshVertexBuffer.SetUseFullPrecisionUVs(false);
+		VertexBuffers.StaticMeshVertexBuffer.SetUseHighPrecisionTangentBasis(false);
+		VertexBuffers.InitWithDummyData(&VertexFactory, GetRingStride() * (MaxSegments + 1));
+
+		SideIndexOffsets.SetNumZeroed(MaxSides + 1);
+		for (int32 SidesLocal = MinSides; SidesLocal <= MaxSides; ++SidesLocal)
+		{
+			SideIndexOffsets[SidesLocal] = IndexBuffer.Indices.Num();
+			for (int32 SegmentLocal = 0; SegmentLocal < MaxSegments; ++SegmentLocal)
+			{
+				for (int32 SideLocal = 0; SideLocal < SidesLocal; ++SideLocal)
+				{
+					const uint32 TopLeftLocal = GetVertexIndex(SegmentLocal, SideLocal);
+					const uint32 BottomLeftLocal = GetVertexIndex(SegmentLocal, SideLocal + 1);
+					const uint32 TopRightLocal = GetVertexIndex(SegmentLocal + 1, SideLocal);
+					const uint32 BottomRightLocal = GetVertexIndex(SegmentLocal + 1, SideLocal + 1);
+					IndexBuffer.Indices.Append({ TopLeftLocal, BottomLeftLocal, TopRightLocal, TopRightLocal, BottomLeftLocal, BottomRightLocal });
+				}
+			}
+		}
+		BeginInitResource(&IndexBuffer);
+
+		Material = Component->GetMaterial(0);
+		if (!Material)
+		{
+			Material = UMaterial::GetDefaultMaterial(MD_Surface);
+		}
+	}
+
+	virtual ~FGrappleRopeSceneProxy()
+	{
+		VertexBuffers.PositionVertexBuffer.ReleaseResource();
+		VertexBuffers.StaticMeshVertexBuffer.ReleaseResource();
+		VertexBuffers.ColorVertexBuffer.ReleaseResource();
+		IndexBuffer.ReleaseResource();
+		VertexFactory.ReleaseResource();
+	}
+
+	virtual SIZE_T GetTypeHash() const override
+	{
+		static size_t UniquePointer;
+		return reinterpret_cast<size_t>(&UniquePointer);
+	}
+
+	/** Rebuilds the tube from a new rope shape */
+	void SetDynamicData_RenderThread(TUniquePtr<FGrappleRopeDynamicData>&& DynamicData)
+	{
+		check(IsInRenderingThread());
+
+		const int32 NumPointsLocal = FMath::Min(DynamicData->RopePoints.Num(), MaxSegments + 1);
+		NumSegments = FMath::Max(NumPointsLocal - 1, 0);
+		if (NumSegments == 0)
+		{
+			return;
+		}
+
+		if (!bColorsInitialized)
+		{
+			// the rope is never tinted, fill the colors once
+			const uint32 ColorSizeLocal = VertexBuffers.ColorVertexBuffer.GetNumVertices() * sizeof(FColor);
+			FColor* ColorsLocal = static_cast<FColor*>(RHILockBuffer(VertexBuffers.ColorVertexBuffer.VertexBufferRHI, 0, ColorSizeLocal, RLM_WriteOnly));
+			for (uint32 IndexLocal = 0; IndexLocal < VertexBuffers.ColorVertexBuffer.GetNumVertices(); ++IndexLocal)
+			{
+				ColorsLocal[IndexLocal] = FColor::White;
+			}
+			RHIUnlockBuffer(VertexBuffers.ColorVertexBuffer.VertexBufferRHI);
+			bColorsInitialized = true;
+		}
+
+		NumSides = FMath::Clamp(DynamicData->NumSides, MinSides, MaxSides);
+		Builder.SetShape(NumSides, GetRingStride(), RopeRadius, TileMaterial);
+		NumVertices = Builder.GetNumVertices(NumPointsLocal);
+
+		// only the range this rope uses is locked and written
+		FGrappleRopeMeshBuilder::FOutput OutputLocal;
+		OutputLocal.Positions = static_cast<FVector3f*>(RHILockBuffer(VertexBuffers.PositionVertexBuffer.VertexBufferRHI, 0, NumVertices * sizeof(FVector3f), RLM_WriteOnly));
+		OutputLocal.Tangents = static_cast<FGrappleRopeMeshBuilder::FTangents*>(RHILockBuffer(VertexBuffers.StaticMeshVertexBuffer.TangentsVertexBuffer.VertexBufferRHI, 0, NumVertices * sizeof(FGrappleRopeMeshBuilder::FTangents), RLM_WriteOnly));
+		OutputLocal.TexCoords = static_cast<FVector2DHalf*>(RHILockBuffer(VertexBuffers.StaticMeshVertexBuffer.TexCoordVertexBuffer.VertexBufferRHI, 0, NumVertices * sizeof(FVector2DHalf), RLM_WriteOnly));
+		Builder.Build(DynamicData->RopePoints.GetData(), NumPointsLocal, OutputLocal);
+		RHIUnlockBuffer(VertexBuffers.PositionVertexBuffer.VertexBufferRHI);
+		RHIUnlockBuffer(VertexBuffers.StaticMeshVertexBuffer.TangentsVertexBuffer.VertexBufferRHI);
+		RHIUnlockBuffer(VertexBuffers.StaticMeshVertexBuffer.TexCoordVertexBuffer.VertexBufferRHI);
+	}
+
+	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, FMeshElementCollector& Collector) const override
+	{
+		if (NumSegments == 0)
+		{
+			return;
+		}
+
+		const bool bWireframeLocal = AllowDebugViewmodes() && ViewFamily.EngineShowFlags.Wireframe;
+		FMaterialRenderProxy* MaterialProxyLocal = Material->GetRenderProxy();
+		if (bWireframeLocal)
+		{
+			FColoredMaterialRenderProxy* WireframeMaterialLocal = new FColoredMaterialRenderProxy(GEngine->WireframeMaterial ? GEngine->WireframeMaterial->GetRenderProxy() : nullptr, FLinearColor(0.f, 0.5f, 1.f));
+			Collector.RegisterOneFrameMaterialProxy(WireframeMaterialLocal);
+			MaterialProxyLocal = WireframeMaterialLocal;
+		}
+
+		for (int32 ViewIndexLocal = 0; ViewIndexLocal < Views.Num(); ++ViewIndexLocal)
+		{
+			if (!(VisibilityMap & (1 << ViewIndexLocal)))
+			{
+				continue;
+			}
+
+			FMeshBatch& MeshLocal = Collector.AllocateMesh();
+			MeshLocal.bWireframe = bWireframeLocal;
+			MeshLocal.VertexFactory = &VertexFactory;
+			MeshLocal.MaterialRenderProxy = MaterialProxyLocal;
+			MeshLocal.ReverseCulling = IsLocalToWorldDeterminantNegative();
+			MeshLocal.Type = PT_TriangleList;
+			MeshLocal.DepthPriorityGroup = SDPG_World;
+			MeshLocal.bCanApplyViewModeOverrides = false;
+
+			bool bHasPrecomputedVolumetricLightmapLocal = false;
+			FMatrix PreviousLocalToWorldLocal;
+			int32 SingleCaptureIndexLocal = 0;
+			bool bOutputVelocityLocal = false;
+			GetScene().GetPrimitiveUniformShaderParameters_RenderThread(GetPrimitiveSceneInfo(), bHasPrecomputedVolumetricLightmapLocal, PreviousLocalToWorldLocal, SingleCaptureIndexLocal, bOutputVelocityLocal);
+			FDynamicPrimitiveUniformBuffer& DynamicPrimitiveUniformBufferLocal = Collector.AllocateOneFrameResource<FDynamicPrimitiveUniformBuffer>();
+			DynamicPrimitiveUniformBufferLocal.Set(GetLocalToWorld(), PreviousLocalToWorldLocal, GetBounds(), GetLocalBounds(), GetLocalBounds(), true, bHasPrecomputedVolumetricLightmapLocal, DrawsVelocity(), bOutputVelocityLocal);
+
+			FMeshBatchElement& BatchElementLocal = MeshLocal.Elements[0];
+			BatchElementLocal.IndexBuffer = &IndexBuffer;
+			BatchElementLocal.PrimitiveUniformBufferResource = &DynamicPrimitiveUniformBufferLocal.UniformBuffer;
+			BatchElementLocal.FirstIndex = SideIndexOffsets[NumSides];
+			BatchElementLocal.NumPrimitives = NumSegments * NumSides * 2;
+			BatchElementLocal.MinVertexIndex = 0;
+			BatchElementLocal.MaxVertexIndex = NumVertices - 1;
+
+			Collector.AddMesh(ViewIndexLocal, MeshLocal);
+		}
+	}
+
+	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override
+	{
+		FPrimitiveViewRelevance ResultLocal;
+		ResultLocal.bDrawRelevance = IsShown(View);
+		ResultLocal.bShadowRelevance = IsShadowCast(View);
+		ResultLocal.bDynamicRelevance = true;
+		ResultLocal.bRenderInMainPass = ShouldRenderInMainPass();
+		ResultLocal.bUsesLightingChannels = GetLightingChannelMask() != GetDefaultLightingChannelMask();
+		ResultLocal.bRenderCustomDepth = ShouldRenderCustomDepth();
+		ResultLocal.bTranslucentSelfShadow = bCastVolumetricTranslucentShadow;
+		MaterialRelevance.SetPrimitiveViewRelevance(ResultLocal);
+		ResultLocal.bVelocityRelevance = DrawsVelocity() && ResultLocal.bOpaque && ResultLocal.bRenderInMainPass;
+		return ResultLocal;
+	}
+
+	virtual bool CanBeOccluded() const override
+	{
+		return !MaterialRelevance.bDisableDepthTest;
+	}
+
+	virtual uint32 GetMemoryFootprint() const override
+	{
+		return sizeof(*this) + GetAllocatedSize();
+	}
+
+private:
+	FORCEINLINE int32 GetRingStride() const { return MaxSides + 1; }
+	FORCEINLINE int32 GetVertexIndex(int32 Point, int32 Side) const { return (Point * GetRingStride()) + Side; }
+
+	UMaterialInterface* Material{ nullptr };
+	FStaticMeshVertexBuffers VertexBuffers;
+	FDynamicMeshIndexBuffer32 IndexBuffer;
+	FLocalVertexFactory VertexFactory;
+	FMaterialRelevance MaterialRelevance;
+	FGrappleRopeMeshBuilder Builder;
+	/** First index of each side count's block */
+	TArray<int32> SideIndexOffsets;
+
+	const int32 MaxSegments;
+	const int32 MinSides;
+	const int32 MaxSides;
+	const float RopeRadius;
+	const float TileMaterial;
+	/** Shape of the last update */
+	int32 NumSegments{ 0 };
+	int32 NumSides{ 0 };
+	int32 NumVertices{ 0 };
+	bool bColorsInitialized{ false };
+};
+
+UGrappleRopeComponent::UGrappleRopeComponent()
+	: bNeedsReset(true)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	bAutoActivate = true;
+	SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+
+	// close-up first person needs the detail, far away bots draw a straight line
+	LODs.SetNum(4);
+	LODs[0].Distance = 500.f;
+	LODs[0].NumSegments = 16;
+	LODs[0].SolverIterations = 6;
+	LODs[1].Distance = 1500.f;
+	LODs[1].NumSegments = 8;
+	LODs[1].SolverIterations = 4;
+	LODs[2].Distance = 4000.f;
+	LODs[2].NumSegments = 4;
+	LODs[2].SolverIterations = 2;
+	LODs[3].Distance = 10000.f;
+	LODs[3].NumSegments = 1;
+	LODs[3].SolverIterations = 0;
+}
+
+FPrimitiveSceneProxy* UGrappleRopeComponent::CreateSceneProxy()
+{
+	GRAPPLE_LLM_SCOPE(Rope);
+	return new FGrappleRopeSceneProxy(this);
+}
+
+int32 UGrappleRopeComponent::GetNumMaterials() const
+{
+	return 1;
+}
+
+FBoxSphereBounds UGrappleRopeComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	// particles are in world space
+	FBox RopeBoxLocal(ForceInit);
+	for (const VectorRegister4Double& PositionLocal : Rope.Positions)
+	{
+		RopeBoxLocal += FGrappleRopeSolver::ToVector(PositionLocal);
+	}
+	if (WrapPoints.Num() > 0)
+	{
+		for (const FVector& WrapPointLocal : WrapPoints)
+		{
+			RopeBoxLocal += WrapPointLocal;
+		}
+		RopeBoxLocal += HookLocation;
+	}
+	if (!RopeBoxLocal.IsValid)
+	{
+		RopeBoxLocal += LocalToWorld.GetLocation();
+	}
+	return FBoxSphereBounds(RopeBoxLocal.ExpandBy(0.5f * RopeWidth));
+}
+
+void UGrappleRopeComponent::OnRegister()
+{
+	GRAPPLE_LLM_SCOPE(Rope);
+	Super::OnRegister();
+
+	if (UGrappleRopeSubsystem* RopeSubsystemLocal = UWorld::GetSubsystem<UGrappleRopeSubsystem>(GetWorld()))
+	{
+		RopeSubsystemLocal->RegisterRope(this);
+	}
+}
+
+void UGrappleRopeComponent::OnUnregister()
+{
+	if (UGrappleRopeSubsystem* RopeSubsystemLocal = UWorld::GetSubsystem<UGrappleRopeSubsystem>(GetWorld()))
+	{
+		RopeSubsystemLocal->UnregisterRope(this);
+	}
+
+	Super::OnUnregister();
+}
+
+void UGrappleRopeComponent::OnVisibilityChanged()
+{
+	Super::OnVisibilityChanged();
+
+	// whatever shape the rope had when it was hidden is stale
+	bNeedsReset = true;
+}
+
+void UGrappleRopeComponent::CreateRenderState_Concurrent(FRegisterComponentContext* Context)
+{
+	Super::CreateRenderState_Concurrent(Context);
+
+	SendRenderDynamicData_Concurrent();
+}
+
+void UGrappleRopeComponent::SendRenderDynamicData_Concurrent()
+{
+	Super::SendRenderDynamicData_Concurrent();
+
+	if (!SceneProxy)
+	{
+		return;
+	}
+
+	TUniquePtr<FGrappleRopeDynamicData> DynamicDataLocal = MakeUnique<FGrappleRopeDynamicData>();
+	DynamicDataLocal->RopePoints = RenderPoints;
+	DynamicDataLocal->NumSides = RenderSides;
+
+	FGrappleRopeSceneProxy* RopeSceneProxyLocal = static_cast<FGrappleRopeSceneProxy*>(SceneProxy);
+	ENQUEUE_RENDER_COMMAND(FSendGrappleRopeDynamicData)(
+		[RopeSceneProxyLocal, DynamicData = MoveTemp(DynamicDataLocal)](FRHICommandListImmediate& RHICmdList) mutable
+		{
+			RopeSceneProxyLocal->SetDynamicData_RenderThread(MoveTemp(DynamicData));
+		});
+}
+
+void UGrappleRopeComponent::SetHookLocation(const FVector& NewHookLocation)
+{
+	HookLocation = NewHookLocation;
+}
+
+void UGrappleRopeComponent::SetWrapPoints(TConstArrayView<FVector> NewWrapPoints)
+{
+	GRAPPLE_LLM_SCOPE(Rope);
+	// keep the corners nearest the component, that's where the simulated span ends
+	const int32 NumLocal = FMath::Min(NewWrapPoints.Num(), MaxWrapPoints);
+	if (NumLocal != WrapPoints.Num())
+	{
+		// the simulated span just changed ends, its old shape means nothing
+		bNeedsReset = true;
+	}
+	WrapPoints.Reset();
+	WrapPoints.Append(NewWrapPoints.GetData() + (NewWrapPoints.Num() - NumLocal), NumLocal);
+}
+
+void UGrappleRopeComponent::SimulateRope(float DeltaTime, const FVector& Gravity, float ViewDistance, float ScreenSize)
+{
+	// runs on the batch workers, the tag is per thread
+	GRAPPLE_LLM_SCOPE(Rope);
+	const float DetailLocal = FullDetailScreenSize > 0.f ? FMath::Clamp(ScreenSize / FullDetailScreenSize, 0.f, 1.f) : 1.f;
+	PendingSides = FMath::Clamp(FMath::RoundToInt(FMath::Lerp(static_cast<float>(MinSides), static_cast<float>(NumSides), DetailLocal)), FMath::Min(MinSides, NumSides), NumSides);
+
+	const FGrappleRopeLOD& LODLocal = GetLODForDistance(ViewDistance);
+	if (bNeedsReset)
+	{
+		FGrappleRopeSolver::Reset(Rope, GetComponentLocation(), GetRopeEnd(), LODLocal.NumSegments);
+		bNeedsReset = false;
+		return;
+	}
+
+	FGrappleRopeSolver::FSettings SettingsLocal;
+	SettingsLocal.Gravity = Gravity;
+	SettingsLocal.Damping = Damping;
+	SettingsLocal.ReelInSpeed = ReelInSpeed;
+	SettingsLocal.TautTolerance = TautTolerance;
+	SettingsLocal.NumSegments = LODLocal.NumSegments;
+	SettingsLocal.Iterations = LODLocal.SolverIterations;
+	FGrappleRopeSolver::Step(Rope, GetComponentLocation(), GetRopeEnd(), DeltaTime, SettingsLocal);
+}
+
+void UGrappleRopeComponent::FinishSimulation()
+{
+	// the tube is only rebuilt once the shape (relative to the component) moved by more than RenderTolerance, e.g. not while hanging still
+	const FTransform& ComponentTransformLocal = GetComponentTransform();
+	const float ToleranceSquaredLocal = FMath::Square(RenderTolerance);
+	// simulated span, then straight on around the remaining corners to the hook
+	const int32 NumSpanPointsLocal = Rope.Positions.Num();
+	const int32 NumPointsLocal = NumSpanPointsLocal + WrapPoints.Num();
+	bool bShapeChangedLocal = NumPointsLocal != RenderPoints.Num() || PendingSides != RenderSides;
+	ScratchPoints.SetNumUninitialized(NumPointsLocal, false);
+	for (int32 IndexLocal = 0; IndexLocal < ScratchPoints.Num(); ++IndexLocal)
+	{
+		const int32 CornerLocal = WrapPoints.Num() - 1 - (IndexLocal - NumSpanPointsLocal);
+		const FVector PointLocal = IndexLocal < NumSpanPointsLocal ? Rope.GetPosition(IndexLocal) : (CornerLocal > 0 ? WrapPoints[CornerLocal - 1] : HookLocation);
+		ScratchPoints[IndexLocal] = FVector3f(ComponentTransformLocal.InverseTransformPosition(PointLocal));
+		bShapeChangedLocal = bShapeChangedLocal || FVector3f::DistSquared(ScratchPoints[IndexLocal], RenderPoints[IndexLocal]) > ToleranceSquaredLocal;
+	}
+
+	if (bShapeChangedLocal)
+	{
+		Swap(RenderPoints, ScratchPoints);
+		RenderSides = PendingSides;
+		MarkRenderDynamicDataDirty();
+	}
+
+	// particles are in world space, the bounds follow them even when the shape relative to the gun holds
+	if (bShapeChangedLocal || !ComponentTransformLocal.Equals(RenderTransform))
+	{
+		RenderTransform = ComponentTransformLocal;
+		UpdateBounds();
+		MarkRenderTransformDirty();
+	}
+}
+
+int32 UGrappleRopeComponent::GetMaxSegments() const
+{
+	int32 MaxSegmentsLocal = LODs.Num() > 0 ? 1 : FGrappleRopeLOD().NumSegments;
+	for (const FGrappleRopeLOD& LODLocal : LODs)
+	{
+		MaxSegmentsLocal = FMath::Max(MaxSegmentsLocal, LODLocal.NumSegments);
+	}
+	return MaxSegmentsLocal;
+}
+
+const FGrappleRopeLOD& UGrappleRopeComponent::GetLODForDistance(float ViewDistance) const
+{
+	static const FGrappleRopeLOD DefaultLOD;
+	for (const FGrappleRopeLOD& LODLocal : LODs)
+	{
+		if (ViewDistance < LODLocal.Distance)
+		{
+			return LODLocal;
+		}
+	}
+	return LODs.Num() > 0 ? LODs.Last() : DefaultLOD;
+}
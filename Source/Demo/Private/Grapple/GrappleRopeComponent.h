@@ -0,0 +1,155 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/MeshComponent.h"
+#include "GrappleRopeSolver.h"
+#include "GrappleRopeComponent.generated.h"
+
+/** Rope detail up to a camera distance */
+USTRUCT(BlueprintType)
+struct FGrappleRopeLOD
+{
+	GENERATED_BODY()
+
+	/** Used while the closest view is nearer than this */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Rope", meta = (ClampMin = "0.0"))
+	float Distance{ 0.f };
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Rope", meta = (ClampMin = "1"))
+	int32 NumSegments{ 6 };
+	/** 0 always draws the rope straight */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Rope", meta = (ClampMin = "0"))
+	int32 SolverIterations{ 3 };
+};
+
+/**
+ * Grapple rope from the component location (attach it to the gun) to the hook location. Rendered as a tube.
+ * The rope doesn't tick on its own: UGrappleRopeSubsystem steps every visible rope in one parallel batch per frame with FGrappleRopeSolver,
+ * picking segment and iteration counts per rope from the distance to the closest view.
+ * When the rope is wrapped around corners only the span from the component to the nearest corner is simulated, the rest runs straight from corner to corner.
+ */
+UCLASS(ClassGroup = (Rendering), meta = (BlueprintSpawnableComponent))
+class UGrappleRopeComponent : public UMeshComponent
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	/********************************
+	* ROPE SETTINGS
+	********************************/
+	/** Tube diameter */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Rope|Rendering", meta = (ClampMin = "0.01"))
+	float RopeWidth{ 3.5f };
+	/** Tube sides at full detail */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Rope|Rendering", meta = (ClampMin = "3", ClampMax = "16"))
+	int32 NumSides{ 8 };
+	/** Tube sides once the rope is only a few pixels wide */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Rope|Rendering", meta = (ClampMin = "3", ClampMax = "16"))
+	int32 MinSides{ 3 };
+	/** Fraction of the screen width the rope must cover to get NumSides, thinner ropes go down towards MinSides */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Rope|Rendering", meta = (ClampMin = "0.0"))
+	float FullDetailScreenSize{ 0.01f };
+	/** Particles moving less than this (relative to the component) don't rebuild the tube */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Rope|Rendering", meta = (ClampMin = "0.0"))
+	float RenderTolerance{ 0.1f };
+	/** Most wrapped corners drawn, the render buffers are sized for them. Corners past this (the ones nearest the hook) are skipped */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Rope|Rendering", meta = (ClampMin = "0"))
+	int32 MaxWrapPoints{ 8 };
+	/** How many times the material repeats along the rope */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Rope|Rendering")
+	float TileMaterial{ 8.f };
+	/** Fraction of the particle velocity lost per step */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Rope|Simulation", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float Damping{ 0.02f };
+	/** How fast slack is wound back into the gun (cm/s). The rope pays out instantly, so it only sags when the ends close in faster than this */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Rope|Simulation", meta = (ClampMin = "0.0"))
+	float ReelInSpeed{ 5000.f };
+	/** Slack up to this length is drawn as a straight line without simulating */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Rope|Simulation", meta = (ClampMin = "0.0"))
+	float TautTolerance{ 1.f };
+	/** Detail by view distance, nearest first. Past the last entry the last one is used */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Rope|Simulation")
+	TArray<FGrappleRopeLOD> LODs;
+
+	/********************************
+	* ROPE RUNTIME
+	********************************/
+	/** World location of the far end */
+	FVector HookLocation{ 0.f };
+	/** Corners the rope is wrapped around (world space), hook end first */
+	TArray<FVector, TInlineAllocator<8>> WrapPoints;
+	/** Simulation state, only touched by the subsystem batch and the game thread between batches */
+	FGrappleRopeSolver::FRope Rope;
+	/** Next step lays the rope out straight instead of continuing (it was hidden or not simulated for a while) */
+	uint8 bNeedsReset : 1;
+	/** Sides picked from the screen size by the last step */
+	int32 PendingSides{ 0 };
+	/** Shape the render thread last got (component space), and the component transform the bounds were last updated for */
+	TArray<FVector3f> RenderPoints;
+	int32 RenderSides{ 0 };
+	FTransform RenderTransform;
+	/** Reused by FinishSimulation */
+	TArray<FVector3f> ScratchPoints;
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleRopeComponent();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+	virtual int32 GetNumMaterials() const override;
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+
+protected:
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	virtual void OnVisibilityChanged() override;
+	virtual void CreateRenderState_Concurrent(FRegisterComponentContext* Context) override;
+	virtual void SendRenderDynamicData_Concurrent() override;
+
+	/********************************
+	* MEMBER METHODS
+	********************************/
+public:
+	/** Moves the far end of the rope */
+	UFUNCTION(BlueprintCallable, Category = "Rope")
+	void SetHookLocation(const FVector& NewHookLocation);
+	/** Lays the rope out straight on the next step (e.g. after a new shot) */
+	UFUNCTION(BlueprintCallable, Category = "Rope")
+	FORCEINLINE void ResetRope() { bNeedsReset = true; }
+	/** Routes the rope around corners (world space, hook end first) */
+	void SetWrapPoints(TConstArrayView<FVector> NewWrapPoints);
+
+	/** Steps the rope with the detail for ViewDistance and ScreenSize (fraction of the screen width the rope covers). Called by the subsystem batch, touches nothing but this rope */
+	void SimulateRope(float DeltaTime, const FVector& Gravity, float ViewDistance, float ScreenSize);
+	/** Pushes the new rope shape to the renderer if it moved, game thread after the batch */
+	void FinishSimulation();
+
+	FORCEINLINE FVector GetHookLocation() const { return HookLocation; }
+	FORCEINLINE float GetRopeWidth() const { return RopeWidth; }
+	FORCEINLINE int32 GetNumSides() const { return NumSides; }
+	FORCEINLINE int32 GetMinSides() const { return MinSides; }
+	FORCEINLINE float GetTileMaterial() const { return TileMaterial; }
+	FORCEINLINE bool IsTaut() const { return Rope.bTaut; }
+	/** Far end of the simulated span: the corner nearest the component, or the hook */
+	FORCEINLINE FVector GetRopeEnd() const { return WrapPoints.Num() > 0 ? WrapPoints.Last() : HookLocation; }
+	/** Most segments any LOD uses */
+	int32 GetMaxSegments() const;
+	/** Most points ever drawn: the simulated span at its most segments, then the corners and the hook (the render buffers are sized for it) */
+	FORCEINLINE int32 GetMaxRenderPoints() const { return GetMaxSegments() + 1 + MaxWrapPoints; }
+
+protected:
+	const FGrappleRopeLOD& GetLODForDistance(float ViewDistance) const;
+};
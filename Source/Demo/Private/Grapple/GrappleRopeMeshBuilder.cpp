@@ -0,0 +1,89 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleRopeMeshBuilder.h"
+
+void FGrappleRopeMeshBuilder::SetShape(int32 InNumSides, int32 InRingStride, float InRadius, float InTileMaterial)
+{
+	Radius = InRadius;
+	TileMaterial = InTileMaterial;
+	RingStride = FMath::Max(InRingStride, InNumSides + 1);
+	if (InNumSides == NumSides)
+	{
+		return;
+	}
+
+	NumSides = InNumSides;
+	SideCos.SetNumUninitialized(NumSides + 1);
+	SideSin.SetNumUninitialized(NumSides + 1);
+	SideV.SetNumUninitialized(NumSides + 1);
+	for (int32 SideLocal = 0; SideLocal <= NumSides; ++SideLocal)
+	{
+		const float SideFractionLocal = static_cast<float>(SideLocal) / NumSides;
+		float SinLocal = 0.f;
+		float CosLocal = 0.f;
+		FMath::SinCos(&SinLocal, &CosLocal, SideFractionLocal * 2.f * PI);
+		SideCos[SideLocal] = VectorSetFloat1(CosLocal);
+		SideSin[SideLocal] = VectorSetFloat1(SinLocal);
+		SideV[SideLocal] = FFloat16(SideFractionLocal);
+	}
+}
+
+void FGrappleRopeMeshBuilder::Build(const FVector3f* Points, int32 NumPoints, const FOutput& Output) const
+{
+	if (NumPoints < 2 || NumSides < 3)
+	{
+		return;
+	}
+
+	const VectorRegister4Float RadiusLocal = VectorSetFloat1(Radius);
+	// packs to a +1 binormal sign in the W of TangentZ
+	const VectorRegister4Float BinormalSignLocal = GlobalVectorConstants::Float0001;
+	VectorRegister4Float ForwardLocal = MakeVectorRegisterFloat(1.f, 0.f, 0.f, 0.f);
+	VectorRegister4Float UpLocal = MakeVectorRegisterFloat(0.f, 0.f, 1.f, 0.f);
+	VectorRegister4Float RightLocal = MakeVectorRegisterFloat(0.f, 1.f, 0.f, 0.f);
+
+	for (int32 PointLocal = 0; PointLocal < NumPoints; ++PointLocal)
+	{
+		const VectorRegister4Float CenterLocal = VectorLoadFloat3_W0(&Points[PointLocal].X);
+		const VectorRegister4Float DirectionLocal = VectorSubtract(VectorLoadFloat3_W0(&Points[FMath::Min(PointLocal + 1, NumPoints - 1)].X), VectorLoadFloat3_W0(&Points[FMath::Max(PointLocal - 1, 0)].X));
+		const float DirectionSizeSquaredLocal = VectorDot3Scalar(DirectionLocal, DirectionLocal);
+		if (DirectionSizeSquaredLocal > SMALL_NUMBER)
+		{
+			ForwardLocal = VectorMultiply(DirectionLocal, VectorSetFloat1(FMath::InvSqrt(DirectionSizeSquaredLocal)));
+		}
+		if (PointLocal == 0)
+		{
+			FVector3f ForwardVectorLocal;
+			VectorStoreFloat3(ForwardLocal, &ForwardVectorLocal.X);
+			FVector3f UpVectorLocal;
+			FVector3f RightVectorLocal;
+			ForwardVectorLocal.FindBestAxisVectors(UpVectorLocal, RightVectorLocal);
+			UpLocal = VectorLoadFloat3_W0(&UpVectorLocal.X);
+		}
+
+		// carry the frame along the rope so the tube doesn't twist
+		const VectorRegister4Float NewRightLocal = VectorCross(UpLocal, ForwardLocal);
+		const float NewRightSizeSquaredLocal = VectorDot3Scalar(NewRightLocal, NewRightLocal);
+		if (NewRightSizeSquaredLocal > SMALL_NUMBER)
+		{
+			RightLocal = VectorMultiply(NewRightLocal, VectorSetFloat1(FMath::InvSqrt(NewRightSizeSquaredLocal)));
+			UpLocal = VectorCross(ForwardLocal, RightLocal);
+		}
+
+		FPackedNormal TangentXLocal;
+		TangentXLocal = ForwardLocal;
+		const FFloat16 ULocal(static_cast<float>(PointLocal) / (NumPoints - 1) * TileMaterial);
+		const int32 RingLocal = PointLocal * RingStride;
+		for (int32 SideLocal = 0; SideLocal <= NumSides; ++SideLocal)
+		{
+			const VectorRegister4Float SideDirectionLocal = VectorMultiplyAdd(RightLocal, SideCos[SideLocal], VectorMultiply(UpLocal, SideSin[SideLocal]));
+			const int32 VertexLocal = RingLocal + SideLocal;
+
+			VectorStoreFloat3(VectorMultiplyAdd(SideDirectionLocal, RadiusLocal, CenterLocal), &Output.Positions[VertexLocal].X);
+			Output.Tangents[VertexLocal].TangentX = TangentXLocal;
+			Output.Tangents[VertexLocal].TangentZ = VectorAdd(SideDirectionLocal, BinormalSignLocal);
+			Output.TexCoords[VertexLocal] = FVector2DHalf(ULocal, SideV[SideLocal]);
+		}
+	}
+}
@@ -0,0 +1,54 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+#include "Math/Vector2DHalf.h"
+#include "PackedNormal.h"
+
+/**
+ * Builds the rope tube (rings of NumSides + 1 vertices, the seam is duplicated for the UVs) straight into caller owned streams.
+ * The streams use the default static mesh vertex buffer formats (float positions, packed tangents, half UVs) so the scene proxy can point
+ * them at locked GPU memory; nothing here needs the RHI, so it also runs headless. Every vertex is one chain of vector operations,
+ * the per-side sine/cosine are computed once per shape.
+ */
+class FGrappleRopeMeshBuilder
+{
+public:
+	/** Tangent basis of one vertex, laid out like FStaticMeshVertexBuffer stores it at default precision */
+	struct FTangents
+	{
+		FPackedNormal TangentX;
+		FPackedNormal TangentZ;
+	};
+
+	/** Output streams, each sized for at least GetNumVertices */
+	struct FOutput
+	{
+		FVector3f* Positions{ nullptr };
+		FTangents* Tangents{ nullptr };
+		FVector2DHalf* TexCoords{ nullptr };
+	};
+
+	/** Sets the tube shape. RingStride (>= NumSides + 1) is the vertex distance between rings, so ropes with fewer sides can share buffers laid out for more */
+	void SetShape(int32 InNumSides, int32 InRingStride, float InRadius, float InTileMaterial);
+
+	/** Writes the tube along NumPoints points */
+	void Build(const FVector3f* Points, int32 NumPoints, const FOutput& Output) const;
+
+	/** Vertices written for NumPoints points (the last ring only fills NumSides + 1 of its stride) */
+	FORCEINLINE int32 GetNumVertices(int32 NumPoints) const { return NumPoints > 0 ? ((NumPoints - 1) * RingStride) + NumSides + 1 : 0; }
+	FORCEINLINE int32 GetNumSides() const { return NumSides; }
+
+private:
+	int32 NumSides{ 0 };
+	int32 RingStride{ 0 };
+	float Radius{ 1.f };
+	float TileMaterial{ 1.f };
+	/** Cos and sin of every side angle, replicated in all lanes */
+	TArray<VectorRegister4Float> SideCos;
+	TArray<VectorRegister4Float> SideSin;
+	/** V coordinate of every side */
+	TArray<FFloat16> SideV;
+};
@@ -0,0 +1,139 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleRopeSolver.h"
+
+void FGrappleRopeSolver::Reset(FRope& Rope, const FVector& Start, const FVector& End, int32 NumSegments)
+{
+	const int32 NumPointsLocal = FMath::Max(NumSegments, 1) + 1;
+	Rope.Positions.SetNumUninitialized(NumPointsLocal, false);
+	Rope.PreviousPositions.SetNumUninitialized(NumPointsLocal, false);
+	Rope.RestLength = FVector::Dist(Start, End);
+	Rope.bTaut = true;
+	LayOutStraight(Rope, ToRegister(Start), ToRegister(End));
+}
+
+void FGrappleRopeSolver::Step(FRope& Rope, const FVector& Start, const FVector& End, float DeltaTime, const FSettings& Settings)
+{
+	const int32 NumSegmentsLocal = FMath::Max(Settings.NumSegments, 1);
+	if (Rope.Positions.Num() < 2)
+	{
+		Reset(Rope, Start, End, NumSegmentsLocal);
+		return;
+	}
+	if (Rope.GetNumSegments() != NumSegmentsLocal)
+	{
+		Resample(Rope, NumSegmentsLocal);
+	}
+
+	const VectorRegister4Double StartLocal = ToRegister(Start);
+	const VectorRegister4Double EndLocal = ToRegister(End);
+	const double DistanceLocal = FVector::Dist(Start, End);
+	Rope.RestLength = FMath::Max(DistanceLocal, Rope.RestLength - (Settings.ReelInSpeed * DeltaTime));
+
+	// under tension the rope is a straight line whatever the solver would do, skip it
+	if (Settings.Iterations <= 0 || Rope.RestLength - DistanceLocal <= Settings.TautTolerance)
+	{
+		Rope.bTaut = true;
+		LayOutStraight(Rope, StartLocal, EndLocal);
+		return;
+	}
+	Rope.bTaut = false;
+
+	VectorRegister4Double* RESTRICT PositionsLocal = Rope.Positions.GetData();
+	VectorRegister4Double* RESTRICT PreviousLocal = Rope.PreviousPositions.GetData();
+	const int32 LastLocal = NumSegmentsLocal;
+
+	// Verlet: x' = x + (x - x_prev) * (1 - damping) + g * dt^2, ends pinned
+	const VectorRegister4Double KeepLocal = VectorSetFloat1(1.0 - Settings.Damping);
+	const VectorRegister4Double GravityStepLocal = VectorMultiply(ToRegister(Settings.Gravity), VectorSetFloat1(static_cast<double>(DeltaTime) * DeltaTime));
+	for (int32 IndexLocal = 1; IndexLocal < LastLocal; ++IndexLocal)
+	{
+		const VectorRegister4Double PositionLocal = PositionsLocal[IndexLocal];
+		const VectorRegister4Double VelocityLocal = VectorSubtract(PositionLocal, PreviousLocal[IndexLocal]);
+		PreviousLocal[IndexLocal] = PositionLocal;
+		PositionsLocal[IndexLocal] = VectorAdd(VectorMultiplyAdd(VelocityLocal, KeepLocal, PositionLocal), GravityStepLocal);
+	}
+	PositionsLocal[0] = PreviousLocal[0] = StartLocal;
+	PositionsLocal[LastLocal] = PreviousLocal[LastLocal] = EndLocal;
+
+	// distance constraints, a pinned end takes none of the correction
+	const double SegmentLengthLocal = Rope.RestLength / NumSegmentsLocal;
+	for (int32 IterationLocal = 0; IterationLocal < Settings.Iterations; ++IterationLocal)
+	{
+		for (int32 IndexLocal = 0; IndexLocal < LastLocal; ++IndexLocal)
+		{
+			const VectorRegister4Double DeltaLocal = VectorSubtract(PositionsLocal[IndexLocal + 1], PositionsLocal[IndexLocal]);
+			const double LengthSquaredLocal = VectorDot3Scalar(DeltaLocal, DeltaLocal);
+			if (LengthSquaredLocal <= DOUBLE_SMALL_NUMBER)
+			{
+				continue;
+			}
+
+			const double ErrorLocal = 1.0 - (SegmentLengthLocal / FMath::Sqrt(LengthSquaredLocal));
+			const bool bStartPinnedLocal = IndexLocal == 0;
+			const bool bEndPinnedLocal = IndexLocal + 1 == LastLocal;
+			if (bStartPinnedLocal && bEndPinnedLocal)
+			{
+				continue;
+			}
+			const double ShareLocal = (bStartPinnedLocal || bEndPinnedLocal) ? ErrorLocal : 0.5 * ErrorLocal;
+			const VectorRegister4Double CorrectionLocal = VectorMultiply(DeltaLocal, VectorSetFloat1(ShareLocal));
+			if (!bStartPinnedLocal)
+			{
+				PositionsLocal[IndexLocal] = VectorAdd(PositionsLocal[IndexLocal], CorrectionLocal);
+			}
+			if (!bEndPinnedLocal)
+			{
+				PositionsLocal[IndexLocal + 1] = VectorSubtract(PositionsLocal[IndexLocal + 1], CorrectionLocal);
+			}
+		}
+	}
+}
+
+void FGrappleRopeSolver::Resample(FRope& Rope, int32 NumSegments)
+{
+	const int32 OldNumPointsLocal = Rope.Positions.Num();
+	TArray<double, TInlineAllocator<64>> DistancesLocal;
+	DistancesLocal.SetNumUninitialized(OldNumPointsLocal);
+	DistancesLocal[0] = 0.0;
+	for (int32 IndexLocal = 1; IndexLocal < OldNumPointsLocal; ++IndexLocal)
+	{
+		const VectorRegister4Double DeltaLocal = VectorSubtract(Rope.Positions[IndexLocal], Rope.Positions[IndexLocal - 1]);
+		DistancesLocal[IndexLocal] = DistancesLocal[IndexLocal - 1] + FMath::Sqrt(VectorDot3Scalar(DeltaLocal, DeltaLocal));
+	}
+	const double TotalLengthLocal = DistancesLocal.Last();
+
+	TArray<VectorRegister4Double> NewPositionsLocal;
+	NewPositionsLocal.SetNumUninitialized(NumSegments + 1);
+	int32 SegmentLocal = 0;
+	for (int32 IndexLocal = 0; IndexLocal <= NumSegments; ++IndexLocal)
+	{
+		// walk the old polyline to the point at the same fraction of its length
+		const double TargetLocal = TotalLengthLocal * IndexLocal / NumSegments;
+		while (SegmentLocal < OldNumPointsLocal - 2 && DistancesLocal[SegmentLocal + 1] < TargetLocal)
+		{
+			++SegmentLocal;
+		}
+		const double SegmentLengthLocal = DistancesLocal[SegmentLocal + 1] - DistancesLocal[SegmentLocal];
+		const double AlphaLocal = SegmentLengthLocal > DOUBLE_SMALL_NUMBER ? FMath::Clamp((TargetLocal - DistancesLocal[SegmentLocal]) / SegmentLengthLocal, 0.0, 1.0) : 0.0;
+		NewPositionsLocal[IndexLocal] = VectorMultiplyAdd(VectorSubtract(Rope.Positions[SegmentLocal + 1], Rope.Positions[SegmentLocal]), VectorSetFloat1(AlphaLocal), Rope.Positions[SegmentLocal]);
+	}
+
+	Rope.Positions = MoveTemp(NewPositionsLocal);
+	Rope.PreviousPositions = Rope.Positions;
+}
+
+void FGrappleRopeSolver::LayOutStraight(FRope& Rope, const VectorRegister4Double& Start, const VectorRegister4Double& End)
+{
+	const int32 NumSegmentsLocal = Rope.GetNumSegments();
+	const VectorRegister4Double StepLocal = VectorMultiply(VectorSubtract(End, Start), VectorSetFloat1(1.0 / NumSegmentsLocal));
+	VectorRegister4Double PositionLocal = Start;
+	for (int32 IndexLocal = 0; IndexLocal < NumSegmentsLocal; ++IndexLocal)
+	{
+		Rope.Positions[IndexLocal] = Rope.PreviousPositions[IndexLocal] = PositionLocal;
+		PositionLocal = VectorAdd(PositionLocal, StepLocal);
+	}
+	// exact end, no accumulated error
+	Rope.Positions[NumSegmentsLocal] = Rope.PreviousPositions[NumSegmentsLocal] = End;
+}
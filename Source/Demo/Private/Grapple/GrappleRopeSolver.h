@@ -0,0 +1,69 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+
+/**
+ * Position based Verlet rope pinned at both ends, no actor or world dependency (see UGrappleRopeComponent for the component side).
+ * Particles are kept as vector registers so integration and the distance constraints run as whole-particle vector operations.
+ * While the rope is under tension (its length doesn't exceed the endpoint distance) it is a straight line, which is laid out directly
+ * instead of being integrated and relaxed.
+ */
+struct FGrappleRopeSolver
+{
+	/** One rope */
+	struct FRope
+	{
+		/** Particle positions (world space, W unused), the first is pinned to the start and the last to the end */
+		TArray<VectorRegister4Double> Positions;
+		/** Positions of the previous step (velocity is implicit) */
+		TArray<VectorRegister4Double> PreviousPositions;
+		/** Current rope length. Pays out instantly when the ends move apart, reels in at ReelInSpeed */
+		double RestLength{ 0.0 };
+		/** The last step took the taut path */
+		bool bTaut{ true };
+
+		FORCEINLINE int32 GetNumSegments() const { return FMath::Max(Positions.Num() - 1, 0); }
+		FORCEINLINE FVector GetPosition(int32 Index) const { return ToVector(Positions[Index]); }
+	};
+
+	/** Simulation settings shared by the ropes of a component */
+	struct FSettings
+	{
+		FVector Gravity{ 0.f, 0.f, -980.f };
+		/** Fraction of the particle velocity lost per step */
+		float Damping{ 0.02f };
+		/** How fast slack is wound back in (cm/s) */
+		float ReelInSpeed{ 5000.f };
+		/** Slack up to this length still counts as taut */
+		float TautTolerance{ 1.f };
+		int32 NumSegments{ 6 };
+		/** Constraint relaxation passes per step, 0 always takes the taut path */
+		int32 Iterations{ 3 };
+	};
+
+	/** Lays the rope out straight between Start and End with NumSegments segments and no velocity */
+	static void Reset(FRope& Rope, const FVector& Start, const FVector& End, int32 NumSegments);
+	/** Advances the rope by DeltaTime with its ends at Start and End. Changes the segment count first if Settings asks for a different one */
+	static void Step(FRope& Rope, const FVector& Start, const FVector& End, float DeltaTime, const FSettings& Settings);
+
+	static FORCEINLINE VectorRegister4Double ToRegister(const FVector& Vector)
+	{
+		return MakeVectorRegisterDouble(Vector.X, Vector.Y, Vector.Z, 0.0);
+	}
+
+	static FORCEINLINE FVector ToVector(const VectorRegister4Double& Register)
+	{
+		FVector VectorLocal;
+		VectorStoreFloat3(Register, &VectorLocal.X);
+		return VectorLocal;
+	}
+
+private:
+	/** Redistributes the particles evenly (by length) along the current rope shape using NumSegments segments, velocity is dropped */
+	static void Resample(FRope& Rope, int32 NumSegments);
+	/** Straight line between the pinned ends */
+	static void LayOutStraight(FRope& Rope, const VectorRegister4Double& Start, const VectorRegister4Double& End);
+};
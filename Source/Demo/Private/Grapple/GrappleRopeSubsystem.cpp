@@ -0,0 +1,102 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleRopeSubsystem.h"
+#include "GrappleRopeComponent.h"
+#include "GrappleStats.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "Async/ParallelFor.h"
+
+bool UGrappleRopeSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool UGrappleRopeSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGrappleRopeSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	ViewLocations.Reset();
+	ViewTanHalfFOVs.Reset();
+	for (FConstPlayerControllerIterator IteratorLocal = GetWorld()->GetPlayerControllerIterator(); IteratorLocal; ++IteratorLocal)
+	{
+		const APlayerController* PlayerControllerLocal = IteratorLocal->Get();
+		if (PlayerControllerLocal && PlayerControllerLocal->IsLocalController())
+		{
+			FVector LocationLocal{ 0.f };
+			FRotator RotationLocal{ 0.f };
+			PlayerControllerLocal->GetPlayerViewPoint(LocationLocal, RotationLocal);
+			ViewLocations.Add(LocationLocal);
+			const float FOVLocal = PlayerControllerLocal->PlayerCameraManager ? PlayerControllerLocal->PlayerCameraManager->GetFOVAngle() : 90.f;
+			ViewTanHalfFOVs.Add(FMath::Tan(FMath::DegreesToRadians(0.5f * FMath::Clamp(FOVLocal, 1.f, 170.f))));
+		}
+	}
+
+	ActiveRopes.Reset();
+	ActiveRopeViewDistances.Reset();
+	ActiveRopeScreenSizes.Reset();
+	for (UGrappleRopeComponent* RopeLocal : Ropes)
+	{
+		if (!RopeLocal->IsVisible())
+		{
+			continue;
+		}
+		if (!RopeLocal->WasRecentlyRendered(NotRenderedTimeout))
+		{
+			// off screen: only lay it out straight so the bounds still follow the ends
+			RopeLocal->ResetRope();
+		}
+
+		// distance to the closest point of the rope, a long rope passing right by the camera needs the detail even if both ends are far
+		float ViewDistanceLocal = ViewLocations.Num() > 0 ? TNumericLimits<float>::Max() : 0.f;
+		float ScreenSizeLocal = ViewLocations.Num() > 0 ? 0.f : 1.f;
+		for (int32 ViewIndexLocal = 0; ViewIndexLocal < ViewLocations.Num(); ++ViewIndexLocal)
+		{
+			const float DistanceLocal = static_cast<float>(FMath::PointDistToSegment(ViewLocations[ViewIndexLocal], RopeLocal->GetComponentLocation(), RopeLocal->GetHookLocation()));
+			ViewDistanceLocal = FMath::Min(ViewDistanceLocal, DistanceLocal);
+			ScreenSizeLocal = FMath::Max(ScreenSizeLocal, RopeLocal->GetRopeWidth() / (2.f * FMath::Max(DistanceLocal, 1.f) * ViewTanHalfFOVs[ViewIndexLocal]));
+		}
+		ActiveRopes.Add(RopeLocal);
+		ActiveRopeViewDistances.Add(ViewDistanceLocal);
+		ActiveRopeScreenSizes.Add(ScreenSizeLocal);
+	}
+	if (ActiveRopes.Num() == 0)
+	{
+		return;
+	}
+
+	GRAPPLE_SCOPE_CYCLE_COUNTER(RopeBatch);
+	const FVector GravityLocal(0.f, 0.f, GetWorld()->GetGravityZ());
+	ParallelFor(ActiveRopes.Num(), [this, DeltaTime, &GravityLocal](int32 IndexLocal)
+	{
+		ActiveRopes[IndexLocal]->SimulateRope(DeltaTime, GravityLocal, ActiveRopeViewDistances[IndexLocal], ActiveRopeScreenSizes[IndexLocal]);
+	});
+
+	for (UGrappleRopeComponent* RopeLocal : ActiveRopes)
+	{
+		RopeLocal->FinishSimulation();
+	}
+}
+
+TStatId UGrappleRopeSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGrappleRopeSubsystem, STATGROUP_Tickables);
+}
+
+void UGrappleRopeSubsystem::RegisterRope(UGrappleRopeComponent* Rope)
+{
+	GRAPPLE_LLM_SCOPE(Rope);
+	Ropes.AddUnique(Rope);
+}
+
+void UGrappleRopeSubsystem::UnregisterRope(UGrappleRopeComponent* Rope)
+{
+	Ropes.RemoveSwap(Rope);
+}
@@ -0,0 +1,57 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GrappleRopeSubsystem.generated.h"
+
+class UGrappleRopeComponent;
+
+/**
+ * Simulates every visible grapple rope of the world in one parallel batch per frame (ropes are independent, one task per rope),
+ * then pushes the results to the renderer on the game thread. Ropes that weren't rendered recently are only laid out straight.
+ * Ropes are purely cosmetic, so there is no instance on dedicated servers.
+ */
+UCLASS()
+class UGrappleRopeSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	/** Every registered rope */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UGrappleRopeComponent>> Ropes;
+	/** Ropes stepped this frame, their view distance and the fraction of the screen width they cover */
+	TArray<UGrappleRopeComponent*> ActiveRopes;
+	TArray<float> ActiveRopeViewDistances;
+	TArray<float> ActiveRopeScreenSizes;
+	/** Local player view locations of this frame and the tangent of half their horizontal FOV */
+	TArray<FVector> ViewLocations;
+	TArray<float> ViewTanHalfFOVs;
+
+	/** Ropes not rendered for this long (seconds) aren't simulated */
+	static constexpr float NotRenderedTimeout = 0.25f;
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/********************************
+	* MEMBER METHODS
+	********************************/
+public:
+	void RegisterRope(UGrappleRopeComponent* Rope);
+	void UnregisterRope(UGrappleRopeComponent* Rope);
+};
@@ -0,0 +1,143 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleSignificanceSubsystem.h"
+#include "Character/GrappleCharacter.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "Misc/App.h"
+
+const FName UGrappleSignificanceSubsystem::SignificanceTag(TEXT("GrappleCharacter"));
+
+bool UGrappleSignificanceSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGrappleSignificanceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	GrappleSubstepsRemaining = GrappleSubstepBudget;
+}
+
+void UGrappleSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// new frame, new budget
+	GrappleSubstepsRemaining = GrappleSubstepBudget;
+
+	USignificanceManager* SignificanceManagerLocal = FSignificanceManagerModule::Get(GetWorld());
+	if (!SignificanceManagerLocal || !bSignificanceEnabled)
+	{
+		return;
+	}
+
+	// local players on clients, every player on the server
+	Viewpoints = ExtraViewpoints;
+	for (FConstPlayerControllerIterator IteratorLocal = GetWorld()->GetPlayerControllerIterator(); IteratorLocal; ++IteratorLocal)
+	{
+		const APlayerController* PlayerControllerLocal = IteratorLocal->Get();
+		if (PlayerControllerLocal && (PlayerControllerLocal->IsLocalController() || GetWorld()->GetNetMode() < NM_Client))
+		{
+			FVector LocationLocal{ 0.f };
+			FRotator RotationLocal{ 0.f };
+			PlayerControllerLocal->GetPlayerViewPoint(LocationLocal, RotationLocal);
+			Viewpoints.Emplace(RotationLocal, LocationLocal);
+		}
+	}
+	SignificanceManagerLocal->Update(Viewpoints);
+}
+
+TStatId UGrappleSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGrappleSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UGrappleSignificanceSubsystem::RegisterCharacter(AGrappleCharacter* Character)
+{
+	if (USignificanceManager* SignificanceManagerLocal = FSignificanceManagerModule::Get(GetWorld()))
+	{
+		SignificanceManagerLocal->RegisterObject(Character, SignificanceTag,
+			[this](USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint) { return CalculateSignificance(ObjectInfo, Viewpoint); },
+			USignificanceManager::EPostSignificanceType::Sequential, &UGrappleSignificanceSubsystem::OnSignificanceChanged);
+		if (!bSignificanceEnabled)
+		{
+			// registering scores it against the manager's last viewpoints
+			Character->SetGrappleSignificance(EGrappleSignificance::High);
+		}
+	}
+}
+
+void UGrappleSignificanceSubsystem::UnregisterCharacter(AGrappleCharacter* Character)
+{
+	if (USignificanceManager* SignificanceManagerLocal = FSignificanceManagerModule::Get(GetWorld()))
+	{
+		SignificanceManagerLocal->UnregisterObject(Character);
+	}
+}
+
+int32 UGrappleSignificanceSubsystem::ConsumeGrappleSubsteps(int32 Wanted)
+{
+	if (!bSignificanceEnabled)
+	{
+		return FMath::Max(Wanted, 1);
+	}
+	const int32 GrantedLocal = FMath::Clamp(GrappleSubstepsRemaining, 1, FMath::Max(Wanted, 1));
+	GrappleSubstepsRemaining = FMath::Max(GrappleSubstepsRemaining - GrantedLocal, 0);
+	return GrantedLocal;
+}
+
+void UGrappleSignificanceSubsystem::SetSignificanceEnabled(bool bEnabled)
+{
+	bSignificanceEnabled = bEnabled;
+	USignificanceManager* SignificanceManagerLocal = FSignificanceManagerModule::Get(GetWorld());
+	if (bSignificanceEnabled || !SignificanceManagerLocal)
+	{
+		// back on, the next update sets the tiers again
+		return;
+	}
+	for (const USignificanceManager::FManagedObjectInfo* ObjectInfoLocal : SignificanceManagerLocal->GetManagedObjects(SignificanceTag))
+	{
+		CastChecked<AGrappleCharacter>(ObjectInfoLocal->GetObject())->SetGrappleSignificance(EGrappleSignificance::High);
+	}
+}
+
+float UGrappleSignificanceSubsystem::CalculateSignificance(const USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint) const
+{
+	const AGrappleCharacter* CharacterLocal = CastChecked<AGrappleCharacter>(ObjectInfo->GetObject());
+	if (CharacterLocal->IsLocallyControlled() && CharacterLocal->IsPlayerControlled())
+	{
+		return static_cast<float>(EGrappleSignificance::High);
+	}
+
+	const double DistanceSquaredLocal = FVector::DistSquared(CharacterLocal->GetActorLocation(), Viewpoint.GetLocation());
+	EGrappleSignificance SignificanceLocal = EGrappleSignificance::Off;
+	if (DistanceSquaredLocal < FMath::Square(HighSignificanceDistance))
+	{
+		SignificanceLocal = EGrappleSignificance::High;
+	}
+	else if (DistanceSquaredLocal < FMath::Square(MediumSignificanceDistance))
+	{
+		SignificanceLocal = EGrappleSignificance::Medium;
+	}
+	else if (DistanceSquaredLocal < FMath::Square(LowSignificanceDistance))
+	{
+		SignificanceLocal = EGrappleSignificance::Low;
+	}
+
+	// nothing renders on a dedicated server or without a renderer (-nullrhi), distance alone decides there
+	if (SignificanceLocal > EGrappleSignificance::Low && !IsRunningDedicatedServer() && FApp::CanEverRender() && !CharacterLocal->WasRecentlyRendered(NotRenderedTimeout))
+	{
+		SignificanceLocal = EGrappleSignificance::Low;
+	}
+	return static_cast<float>(SignificanceLocal);
+}
+
+void UGrappleSignificanceSubsystem::OnSignificanceChanged(USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance, float NewSignificance, bool bFinal)
+{
+	// no OldSignificance != NewSignificance filter: the manager starts every object at 0 (Off), so a character registered far away would keep its
+	// default High tier forever. SetGrappleSignificance already ignores a tier the character is on
+	CastChecked<AGrappleCharacter>(ObjectInfo->GetObject())->SetGrappleSignificance(static_cast<EGrappleSignificance>(FMath::RoundToInt(NewSignificance)));
+}
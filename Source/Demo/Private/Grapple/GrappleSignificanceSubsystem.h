@@ -0,0 +1,89 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SignificanceManager.h"
+#include "GrappleSignificanceSubsystem.generated.h"
+
+class AGrappleCharacter;
+
+/**
+ * Drives the significance manager for grapple characters and owns the per-frame grapple budget.
+ * Every frame the player viewpoints are pushed to the significance manager; each registered character gets a tier (EGrappleSignificance)
+ * from its distance to the closest viewpoint and whether it was rendered recently, and applies the matching FGrappleSignificanceSettings when its tier changes.
+ * AI controlled grapples also draw their movement substeps from a shared per-frame budget.
+ * With bSignificanceEnabled off every character stays at High and the budget is unlimited, the full cost the tiers are measured against.
+ */
+UCLASS(Config = Game)
+class UGrappleSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	/** Off keeps every character at High with an unlimited substep budget (GrappleSoak -NoSignificance) */
+	UPROPERTY(Config)
+	bool bSignificanceEnabled{ true };
+	/** Characters closer than this to a viewpoint are High */
+	UPROPERTY(Config)
+	float HighSignificanceDistance{ 1500.f };
+	/** Characters closer than this are Medium */
+	UPROPERTY(Config)
+	float MediumSignificanceDistance{ 4000.f };
+	/** Characters closer than this are Low, anything further is Off */
+	UPROPERTY(Config)
+	float LowSignificanceDistance{ 10000.f };
+	/** Characters not rendered for this long (seconds) are at most Low. Not used on dedicated servers */
+	UPROPERTY(Config)
+	float NotRenderedTimeout{ 0.5f };
+	/** Grapple movement substeps all AI controlled characters may run together per frame. Once spent, the remaining grapples take a single substep */
+	UPROPERTY(Config)
+	int32 GrappleSubstepBudget{ 256 };
+
+	/** Substeps left in this frame's budget */
+	int32 GrappleSubstepsRemaining{ 0 };
+	/** Player viewpoints of the last update */
+	TArray<FTransform> Viewpoints;
+	/** Viewpoints added to the players' every update, for worlds that have none (headless soaks) */
+	TArray<FTransform> ExtraViewpoints;
+
+	/** Tag grapple characters are registered under in the significance manager */
+	static const FName SignificanceTag;
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/********************************
+	* MEMBER METHODS
+	********************************/
+public:
+	void RegisterCharacter(AGrappleCharacter* Character);
+	void UnregisterCharacter(AGrappleCharacter* Character);
+
+	/** Takes up to Wanted substeps from this frame's budget. Always grants at least one */
+	int32 ConsumeGrappleSubsteps(int32 Wanted);
+
+	/** Turning significance off puts every registered character back on High */
+	void SetSignificanceEnabled(bool bEnabled);
+	FORCEINLINE bool IsSignificanceEnabled() const { return bSignificanceEnabled; }
+	FORCEINLINE void SetExtraViewpoints(TArray<FTransform>&& InViewpoints) { ExtraViewpoints = MoveTemp(InViewpoints); }
+
+protected:
+	/** Significance function, may run on worker threads */
+	float CalculateSignificance(const USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint) const;
+	/** Applies tier changes on the game thread */
+	static void OnSignificanceChanged(USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance, float NewSignificance, bool bFinal);
+};
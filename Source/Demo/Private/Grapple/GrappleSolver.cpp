@@ -0,0 +1,97 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleSolver.h"
+#include "Math/VectorRegister.h"
+
+namespace GrappleSolver
+{
+	/** Doubles per vector register */
+	constexpr int32 LaneCount = 4;
+
+	enum class EReachTest : uint8
+	{
+		/** Euclidean distance (hook attach) */
+		Sphere,
+		/** Per-axis distance (pull arrival) */
+		Box,
+	};
+
+	template<EReachTest ReachTest>
+	void Step(FGrappleSolver::FBatch& Batch, float Remaining, float Tolerance)
+	{
+		const VectorRegister4Double RemainingLocal = VectorSetFloat1(static_cast<double>(Remaining));
+		const VectorRegister4Double ToleranceLocal = VectorSetFloat1(ReachTest == EReachTest::Sphere ? FMath::Square(static_cast<double>(Tolerance)) : static_cast<double>(Tolerance));
+
+		double* RESTRICT LocationXLocal = Batch.LocationX.GetData();
+		double* RESTRICT LocationYLocal = Batch.LocationY.GetData();
+		double* RESTRICT LocationZLocal = Batch.LocationZ.GetData();
+		const double* RESTRICT TargetXLocal = Batch.TargetX.GetData();
+		const double* RESTRICT TargetYLocal = Batch.TargetY.GetData();
+		const double* RESTRICT TargetZLocal = Batch.TargetZ.GetData();
+		bool* RESTRICT ReachedLocal = Batch.Reached.GetData();
+
+		const int32 NumLocal = Batch.Num();
+		for (int32 IndexLocal = 0; IndexLocal < NumLocal; IndexLocal += LaneCount)
+		{
+			const VectorRegister4Double TXLocal = VectorLoad(TargetXLocal + IndexLocal);
+			const VectorRegister4Double TYLocal = VectorLoad(TargetYLocal + IndexLocal);
+			const VectorRegister4Double TZLocal = VectorLoad(TargetZLocal + IndexLocal);
+
+			// Target + (Location - Target) * Remaining
+			const VectorRegister4Double XLocal = VectorMultiplyAdd(VectorSubtract(VectorLoad(LocationXLocal + IndexLocal), TXLocal), RemainingLocal, TXLocal);
+			const VectorRegister4Double YLocal = VectorMultiplyAdd(VectorSubtract(VectorLoad(LocationYLocal + IndexLocal), TYLocal), RemainingLocal, TYLocal);
+			const VectorRegister4Double ZLocal = VectorMultiplyAdd(VectorSubtract(VectorLoad(LocationZLocal + IndexLocal), TZLocal), RemainingLocal, TZLocal);
+			VectorStore(XLocal, LocationXLocal + IndexLocal);
+			VectorStore(YLocal, LocationYLocal + IndexLocal);
+			VectorStore(ZLocal, LocationZLocal + IndexLocal);
+
+			// measured from the stored result so the batch agrees with the scalar tests within tolerance (the batch fuses the multiply add, the scalar path rounds twice)
+			const VectorRegister4Double DXLocal = VectorSubtract(XLocal, TXLocal);
+			const VectorRegister4Double DYLocal = VectorSubtract(YLocal, TYLocal);
+			const VectorRegister4Double DZLocal = VectorSubtract(ZLocal, TZLocal);
+			VectorRegister4Double DistanceLocal;
+			if constexpr (ReachTest == EReachTest::Sphere)
+			{
+				DistanceLocal = VectorMultiplyAdd(DZLocal, DZLocal, VectorMultiplyAdd(DYLocal, DYLocal, VectorMultiply(DXLocal, DXLocal)));
+			}
+			else
+			{
+				DistanceLocal = VectorMax(VectorAbs(DXLocal), VectorMax(VectorAbs(DYLocal), VectorAbs(DZLocal)));
+			}
+			const int32 OutsideMaskLocal = VectorMaskBits(VectorCompareGT(DistanceLocal, ToleranceLocal));
+
+			const int32 LanesLocal = FMath::Min(LaneCount, NumLocal - IndexLocal);
+			for (int32 LaneLocal = 0; LaneLocal < LanesLocal; ++LaneLocal)
+			{
+				ReachedLocal[IndexLocal + LaneLocal] = (OutsideMaskLocal & (1 << LaneLocal)) == 0;
+			}
+		}
+	}
+}
+
+void FGrappleSolver::FBatch::SetNum(int32 NewNum)
+{
+	NumGrapples = NewNum;
+	const int32 PaddedNumLocal = Align(NewNum, GrappleSolver::LaneCount);
+	for (TArray<double>* StreamLocal : { &LocationX, &LocationY, &LocationZ, &TargetX, &TargetY, &TargetZ })
+	{
+		StreamLocal->SetNumUninitialized(PaddedNumLocal, false);
+		// padding lanes stay at the origin, they are stepped but never read
+		for (int32 IndexLocal = NewNum; IndexLocal < PaddedNumLocal; ++IndexLocal)
+		{
+			(*StreamLocal)[IndexLocal] = 0.0;
+		}
+	}
+	Reached.SetNumUninitialized(NewNum, false);
+}
+
+void FGrappleSolver::StepHooks(FBatch& Batch, float Remaining, float Tolerance)
+{
+	GrappleSolver::Step<GrappleSolver::EReachTest::Sphere>(Batch, Remaining, Tolerance);
+}
+
+void FGrappleSolver::StepPulls(FBatch& Batch, float Remaining, float AcceptanceRadius)
+{
+	GrappleSolver::Step<GrappleSolver::EReachTest::Box>(Batch, Remaining, AcceptanceRadius);
+}
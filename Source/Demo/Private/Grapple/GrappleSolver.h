@@ -0,0 +1,141 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Grapple math without any actor, component or world: hook flight, pull, rope wrapping and the arrival tests, both for a single grapple and for a batch.
+ * Both phases are an exponential approach (each step closes the fraction 1 - Remaining of the distance left), the Remaining factor is
+ * computed once with GetHookRemaining/GetPullRemaining and shared by every grapple stepped with the same settings and time.
+ */
+struct FGrappleSolver
+{
+	/** The old timer based pull scaled the launch velocity by the frame delta, so tuning values were authored against a 60 fps frame. Keeping that reference keeps PlayerGrappleSpeed meaning the same thing */
+	static constexpr float PullReferenceDeltaTime = 1.f / 60.f;
+
+	/** Fraction of the hook distance left after DeltaSeconds (exact solution of the old VInterpTo step at AttachSpeed) */
+	static FORCEINLINE float GetHookRemaining(float AttachSpeed, float DeltaSeconds)
+	{
+		return FMath::Exp(-AttachSpeed * DeltaSeconds);
+	}
+
+	/** Fraction of the pull distance left after DeltaSeconds */
+	static FORCEINLINE float GetPullRemaining(float PullSpeed, float DeltaSeconds)
+	{
+		return FMath::Exp(-PullSpeed * PullReferenceDeltaTime * DeltaSeconds);
+	}
+
+	/** Time the hook takes from Distance away to within Tolerance of its target: Distance * exp(-AttachSpeed * t) = Tolerance. Known as soon as the hook is fired */
+	static FORCEINLINE float GetHookAttachTime(float Distance, float AttachSpeed, float Tolerance)
+	{
+		if (Distance <= Tolerance)
+		{
+			return 0.f;
+		}
+		return AttachSpeed > 0.f ? FMath::Loge(Distance / FMath::Max(Tolerance, KINDA_SMALL_NUMBER)) / AttachSpeed : TNumericLimits<float>::Max();
+	}
+
+	/** Hook location FlightTime after it left Start */
+	static FORCEINLINE FVector GetHookLocation(const FVector& Start, const FVector& Target, float AttachSpeed, float FlightTime)
+	{
+		return Approach(Start, Target, GetHookRemaining(AttachSpeed, FlightTime));
+	}
+
+	/** Moves Location towards Target, Remaining from GetHookRemaining/GetPullRemaining */
+	static FORCEINLINE FVector Approach(const FVector& Location, const FVector& Target, float Remaining)
+	{
+		return Target + ((Location - Target) * Remaining);
+	}
+
+	/** Corner the rope is wrapped around while pulling */
+	struct FWrapPoint
+	{
+		/** Where the character is pulled to (far enough off the surface for the capsule) */
+		FVector Location{ 0.f };
+		/** Where the rope touches the surface, for drawing */
+		FVector RopeLocation{ 0.f };
+		/** Side the rope bent to when it wrapped (see GetBendNormal) */
+		FVector BendNormal{ 0.f };
+	};
+
+	/** Normal of the plane the rope bends in at Corner, coming from Pivot (the previous corner or the anchor) and going to Location */
+	static FORCEINLINE FVector GetBendNormal(const FVector& Pivot, const FVector& Corner, const FVector& Location)
+	{
+		return FVector::CrossProduct(Corner - Pivot, Location - Corner);
+	}
+
+	/** The rope comes off Wrap once the character swung back through the plane it bent in, the straight line to Pivot is clear again */
+	static FORCEINLINE bool ShouldUnwrap(const FVector& Pivot, const FWrapPoint& Wrap, const FVector& Location)
+	{
+		return FVector::DotProduct(GetBendNormal(Pivot, Wrap.Location, Location), Wrap.BendNormal) < 0.0;
+	}
+
+	/**
+	 * Pull along a wrapped rope: the approach closes its fraction of the whole rope length (WrappedLength runs from Pivot around the corners to the anchor),
+	 * the distance gained is spent moving towards Pivot. With nothing wrapped (Pivot is the anchor, WrappedLength is 0) this is Approach.
+	 */
+	static FORCEINLINE FVector ApproachAlongRope(const FVector& Location, const FVector& Pivot, double WrappedLength, float Remaining)
+	{
+		const FVector ToPivotLocal = Pivot - Location;
+		const double PivotDistanceLocal = ToPivotLocal.Size();
+		if (PivotDistanceLocal <= DOUBLE_SMALL_NUMBER)
+		{
+			return Pivot;
+		}
+		const double StepLocal = FMath::Min((WrappedLength + PivotDistanceLocal) * (1.0 - Remaining), PivotDistanceLocal);
+		return Location + (ToPivotLocal * (StepLocal / PivotDistanceLocal));
+	}
+
+	/** Hook attach test (sphere) */
+	static FORCEINLINE bool IsHookAttached(const FVector& HookLocation, const FVector& Target, float Tolerance)
+	{
+		return FVector::DistSquared(HookLocation, Target) <= FMath::Square(Tolerance);
+	}
+
+	/** Pull arrival test, the same per-axis tolerance test the old EqualEqual_VectorVector check used */
+	static FORCEINLINE bool HasArrived(const FVector& Location, const FVector& Target, float AcceptanceRadius)
+	{
+		return Location.Equals(Target, AcceptanceRadius);
+	}
+
+	/**
+	 * N grapples as structure of arrays (one stream per axis) so a batch step runs four grapples per vector instruction.
+	 * Streams are padded to a multiple of the vector width, padding lanes sit on their target and are never reported.
+	 */
+	struct FBatch
+	{
+		TArray<double> LocationX;
+		TArray<double> LocationY;
+		TArray<double> LocationZ;
+		TArray<double> TargetX;
+		TArray<double> TargetY;
+		TArray<double> TargetZ;
+		/** Per grapple result of the last step: arrived (pull) or attached (hook) */
+		TArray<bool> Reached;
+
+		/** Resizes every stream for NewNum grapples (contents are undefined until set) */
+		void SetNum(int32 NewNum);
+		FORCEINLINE int32 Num() const { return NumGrapples; }
+
+		FORCEINLINE void Set(int32 Index, const FVector& Location, const FVector& Target)
+		{
+			LocationX[Index] = Location.X;
+			LocationY[Index] = Location.Y;
+			LocationZ[Index] = Location.Z;
+			TargetX[Index] = Target.X;
+			TargetY[Index] = Target.Y;
+			TargetZ[Index] = Target.Z;
+		}
+
+		FORCEINLINE FVector GetLocation(int32 Index) const { return FVector(LocationX[Index], LocationY[Index], LocationZ[Index]); }
+
+	private:
+		int32 NumGrapples{ 0 };
+	};
+
+	/** Steps every hook of Batch, Reached is set for hooks within Tolerance of their target */
+	static void StepHooks(FBatch& Batch, float Remaining, float Tolerance);
+	/** Steps every pull of Batch, Reached is set for grapples within AcceptanceRadius (per axis) of their target */
+	static void StepPulls(FBatch& Batch, float Remaining, float AcceptanceRadius);
+};
@@ -0,0 +1,90 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleStats.h"
+
+#if GRAPPLE_INSTRUMENTATION_ENABLED
+
+DEFINE_STAT(STAT_GrappleFire);
+DEFINE_STAT(STAT_GrappleBegin);
+DEFINE_STAT(STAT_GrappleHookFlight);
+DEFINE_STAT(STAT_GrapplePull);
+DEFINE_STAT(STAT_GrappleArrivalTrace);
+DEFINE_STAT(STAT_GrappleRopeWrap);
+DEFINE_STAT(STAT_GrappleRopeBatch);
+DEFINE_STAT(STAT_GrappleMassMovement);
+DEFINE_STAT(STAT_GrappleMassQueries);
+DEFINE_STAT(STAT_GrappleMassPromotion);
+DEFINE_STAT(STAT_GrappleActiveGrapples);
+DEFINE_STAT(STAT_GrappleTraces);
+DEFINE_STAT(STAT_GrappleHookFlightSteps);
+DEFINE_STAT(STAT_GrapplePullSubsteps);
+
+CSV_DEFINE_CATEGORY(Grapple, true);
+
+LLM_DEFINE_TAG(Grapple);
+LLM_DEFINE_TAG(Grapple_Character, TEXT("Character"), TEXT("Grapple"));
+LLM_DEFINE_TAG(Grapple_Rope, TEXT("Rope"), TEXT("Grapple"));
+LLM_DEFINE_TAG(Grapple_Anchors, TEXT("Anchors"), TEXT("Grapple"));
+LLM_DEFINE_TAG(Grapple_Tethers, TEXT("Tethers"), TEXT("Grapple"));
+
+#if GRAPPLE_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_DEFINE(GrappleChannel);
+
+UE_TRACE_EVENT_BEGIN(Grapple, Lifecycle)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, CharacterId)
+	UE_TRACE_EVENT_FIELD(uint8, Phase)
+	UE_TRACE_EVENT_FIELD(float, X)
+	UE_TRACE_EVENT_FIELD(float, Y)
+	UE_TRACE_EVENT_FIELD(float, Z)
+UE_TRACE_EVENT_END()
+
+#endif
+
+TAtomic<bool> FGrappleStatTotals::bEnabled(false);
+TAtomic<uint64> FGrappleStatTotals::ScopeCycles[static_cast<int32>(EGrappleStatScope::Num)];
+TAtomic<uint64> FGrappleStatTotals::Counts[static_cast<int32>(EGrappleStatCounter::Num)];
+
+void FGrappleStatTotals::SetEnabled(bool bInEnabled)
+{
+	bEnabled.Store(bInEnabled, EMemoryOrder::Relaxed);
+}
+
+void FGrappleStatTotals::Reset()
+{
+	for (TAtomic<uint64>& CyclesLocal : ScopeCycles)
+	{
+		CyclesLocal = 0;
+	}
+	for (TAtomic<uint64>& CountLocal : Counts)
+	{
+		CountLocal = 0;
+	}
+}
+
+double FGrappleStatTotals::GetScopeMs(EGrappleStatScope Scope)
+{
+	return FPlatformTime::ToMilliseconds64(ScopeCycles[static_cast<int32>(Scope)].Load());
+}
+
+uint64 FGrappleStatTotals::GetCount(EGrappleStatCounter Counter)
+{
+	return Counts[static_cast<int32>(Counter)].Load();
+}
+
+void FGrappleTrace::OutputLifecycle(const UObject* Character, EGrappleTracePhase Phase, const FVector& Location)
+{
+#if GRAPPLE_TRACE_ENABLED
+	UE_TRACE_LOG(Grapple, Lifecycle, GrappleChannel)
+		<< Lifecycle.Cycle(FPlatformTime::Cycles64())
+		<< Lifecycle.CharacterId(Character ? Character->GetUniqueID() : 0)
+		<< Lifecycle.Phase(static_cast<uint8>(Phase))
+		<< Lifecycle.X(static_cast<float>(Location.X))
+		<< Lifecycle.Y(static_cast<float>(Location.Y))
+		<< Lifecycle.Z(static_cast<float>(Location.Z));
+#endif
+}
+
+#endif
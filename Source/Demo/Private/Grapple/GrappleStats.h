@@ -0,0 +1,173 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Trace/Trace.h"
+
+/**
+ * Grapple instrumentation, all of it compiled out in Shipping:
+ * - stat group (stat Grapple): scope timers and per frame counts
+ * - CSV category Grapple (csvprofile start): the same timers and counts
+ * - Insights channel Grapple (-trace=cpu,grapple): the scope timers as CPU events and a Lifecycle event per grapple phase
+ * - LLM tags under Grapple (-llm): memory of the characters, ropes, anchors and tethers
+ * - FGrappleStatTotals: running sums of the same timers and counts for benchmarks that run without the stats system (commandlets)
+ */
+#define GRAPPLE_INSTRUMENTATION_ENABLED !UE_BUILD_SHIPPING
+#define GRAPPLE_TRACE_ENABLED (GRAPPLE_INSTRUMENTATION_ENABLED && UE_TRACE_ENABLED)
+
+/** Grapple phases written to the Insights Lifecycle event */
+enum class EGrappleTracePhase : uint8
+{
+	Fire,
+	Attach,
+	Arrive,
+	Break,
+	Release,
+};
+
+/** The GRAPPLE_SCOPE_CYCLE_COUNTER names, indexing FGrappleStatTotals */
+enum class EGrappleStatScope : uint8
+{
+	Fire,
+	Begin,
+	HookFlight,
+	Pull,
+	ArrivalTrace,
+	RopeWrap,
+	RopeBatch,
+	MassMovement,
+	MassQueries,
+	MassPromotion,
+	Num,
+};
+
+/** The GRAPPLE_INC_COUNTER names, indexing FGrappleStatTotals */
+enum class EGrappleStatCounter : uint8
+{
+	ActiveGrapples,
+	Traces,
+	HookFlightSteps,
+	PullSubsteps,
+	Num,
+};
+
+#if GRAPPLE_INSTRUMENTATION_ENABLED
+
+DECLARE_STATS_GROUP(TEXT("Grapple"), STATGROUP_Grapple, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Fire"), STAT_GrappleFire, STATGROUP_Grapple, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Begin"), STAT_GrappleBegin, STATGROUP_Grapple, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hook Flight"), STAT_GrappleHookFlight, STATGROUP_Grapple, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pull"), STAT_GrapplePull, STATGROUP_Grapple, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Arrival Trace"), STAT_GrappleArrivalTrace, STATGROUP_Grapple, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rope Wrap"), STAT_GrappleRopeWrap, STATGROUP_Grapple, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rope Batch"), STAT_GrappleRopeBatch, STATGROUP_Grapple, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mass Movement"), STAT_GrappleMassMovement, STATGROUP_Grapple, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mass Queries"), STAT_GrappleMassQueries, STATGROUP_Grapple, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mass Promotion"), STAT_GrappleMassPromotion, STATGROUP_Grapple, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Active Grapples"), STAT_GrappleActiveGrapples, STATGROUP_Grapple, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces"), STAT_GrappleTraces, STATGROUP_Grapple, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hook Flight Steps"), STAT_GrappleHookFlightSteps, STATGROUP_Grapple, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pull Substeps"), STAT_GrapplePullSubsteps, STATGROUP_Grapple, );
+
+CSV_DECLARE_CATEGORY_EXTERN(Grapple);
+
+LLM_DECLARE_TAG(Grapple);
+LLM_DECLARE_TAG(Grapple_Character);
+LLM_DECLARE_TAG(Grapple_Rope);
+LLM_DECLARE_TAG(Grapple_Anchors);
+LLM_DECLARE_TAG(Grapple_Tethers);
+
+#if GRAPPLE_TRACE_ENABLED
+UE_TRACE_CHANNEL_EXTERN(GrappleChannel);
+#endif
+
+/** Sums of the scope timers and counters since the last Reset, only collected while enabled (a branch per scope otherwise). Pull contains RopeWrap and ArrivalTrace, the Mass scopes are whole processors */
+struct FGrappleStatTotals
+{
+	static void SetEnabled(bool bInEnabled);
+	static FORCEINLINE bool IsEnabled() { return bEnabled.Load(EMemoryOrder::Relaxed); }
+	static void Reset();
+	static double GetScopeMs(EGrappleStatScope Scope);
+	static uint64 GetCount(EGrappleStatCounter Counter);
+
+	static FORCEINLINE void AddCycles(EGrappleStatScope Scope, uint64 Cycles) { ScopeCycles[static_cast<int32>(Scope)] += Cycles; }
+	static FORCEINLINE void AddCount(EGrappleStatCounter Counter, uint64 Amount) { Counts[static_cast<int32>(Counter)] += Amount; }
+
+private:
+	/** Set by the benchmark thread, read by every thread that runs a scope, so an atomic (relaxed: it orders nothing) */
+	static TAtomic<bool> bEnabled;
+	static TAtomic<uint64> ScopeCycles[static_cast<int32>(EGrappleStatScope::Num)];
+	static TAtomic<uint64> Counts[static_cast<int32>(EGrappleStatCounter::Num)];
+};
+
+/** Adds the cycles of its scope to FGrappleStatTotals */
+class FGrappleScopeTotal
+{
+public:
+	explicit FORCEINLINE FGrappleScopeTotal(EGrappleStatScope InScope)
+		: Scope(InScope)
+		, StartCycles(FGrappleStatTotals::IsEnabled() ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+	FORCEINLINE ~FGrappleScopeTotal()
+	{
+		if (StartCycles != 0)
+		{
+			FGrappleStatTotals::AddCycles(Scope, FPlatformTime::Cycles64() - StartCycles);
+		}
+	}
+
+private:
+	EGrappleStatScope Scope;
+	uint64 StartCycles;
+};
+
+/** Insights output */
+struct FGrappleTrace
+{
+	/** Writes a Lifecycle event (cycle timestamp, character id, phase, location) on the Grapple channel */
+	static void OutputLifecycle(const UObject* Character, EGrappleTracePhase Phase, const FVector& Location);
+};
+
+#if GRAPPLE_TRACE_ENABLED
+#define GRAPPLE_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Grapple##Name, GrappleChannel)
+#define GRAPPLE_TRACE_LIFECYCLE(Character, Phase, Location) FGrappleTrace::OutputLifecycle(Character, EGrappleTracePhase::Phase, Location)
+#else
+#define GRAPPLE_TRACE_SCOPE(Name)
+#define GRAPPLE_TRACE_LIFECYCLE(Character, Phase, Location)
+#endif
+
+/** Times the rest of the scope under STAT_Grapple<Name>, the CSV stat <Name>, an Insights CPU event and FGrappleStatTotals */
+#define GRAPPLE_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_Grapple##Name); \
+	CSV_SCOPED_TIMING_STAT(Grapple, Name); \
+	FGrappleScopeTotal GrappleScopeTotal_##Name(EGrappleStatScope::Name); \
+	GRAPPLE_TRACE_SCOPE(Name)
+/** Adds to the per frame count STAT_Grapple<Name>, the CSV stat <Name> and FGrappleStatTotals */
+#define GRAPPLE_INC_COUNTER(Name, Amount) \
+	do \
+	{ \
+		INC_DWORD_STAT_BY(STAT_Grapple##Name, Amount); \
+		CSV_CUSTOM_STAT(Grapple, Name, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate); \
+		if (FGrappleStatTotals::IsEnabled()) \
+		{ \
+			FGrappleStatTotals::AddCount(EGrappleStatCounter::Name, Amount); \
+		} \
+	} while (0)
+/** Tags the allocations of the rest of the scope with Grapple/<Tag> */
+#define GRAPPLE_LLM_SCOPE(Tag) LLM_SCOPE_BYTAG(Grapple_##Tag)
+
+#else
+
+#define GRAPPLE_SCOPE_CYCLE_COUNTER(Name)
+#define GRAPPLE_INC_COUNTER(Name, Amount) do { } while (0)
+#define GRAPPLE_LLM_SCOPE(Tag)
+#define GRAPPLE_TRACE_LIFECYCLE(Character, Phase, Location)
+
+#endif
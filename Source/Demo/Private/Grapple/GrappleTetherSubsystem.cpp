@@ -0,0 +1,253 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleTetherSubsystem.h"
+#include "GrappleStats.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "PBDRigidsSolver.h"
+#include "Chaos/SimCallbackInput.h"
+#include "Chaos/SimCallbackObject.h"
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
+
+/** One tether as the physics thread sees it */
+struct FGrappleTetherAsyncTether
+{
+	Chaos::FSingleParticlePhysicsProxy* Proxy{ nullptr };
+	FVector LocalOffset{ 0.f };
+	/** Holder location on the frame the snapshot was taken */
+	FVector HolderLocation{ 0.f };
+	float Length{ 0.f };
+	FGrappleTetherSettings Settings;
+};
+
+/** Snapshot of every tether, one per game frame */
+struct FGrappleTetherAsyncInput : public Chaos::FSimCallbackInput
+{
+	TArray<FGrappleTetherAsyncTether> Tethers;
+
+	void Reset()
+	{
+		Tethers.Reset();
+	}
+};
+
+/** Applies the tether forces before every physics step */
+class FGrappleTetherCallback : public Chaos::TSimCallbackObject<FGrappleTetherAsyncInput>
+{
+	/** Last snapshot received, reused by physics steps that come without a new one. The proxies stay valid until the next snapshot: a frame that
+	deletes a tethered body's proxy always sends one without it (UGrappleTetherSubsystem::OnBodyPhysicsStateChanged), and the deletion is processed
+	with that frame's data */
+	TArray<FGrappleTetherAsyncTether> ActiveTethers;
+
+	virtual void OnPreSimulate_Internal() override
+	{
+		if (const FGrappleTetherAsyncInput* InputLocal = GetConsumerInput_Internal())
+		{
+			ActiveTethers = InputLocal->Tethers;
+		}
+
+		for (const FGrappleTetherAsyncTether& TetherLocal : ActiveTethers)
+		{
+			// the body may have been removed from the scene since the snapshot was taken
+			Chaos::FRigidBodyHandle_Internal* BodyLocal = TetherLocal.Proxy && !TetherLocal.Proxy->GetMarkedDeleted() ? TetherLocal.Proxy->GetPhysicsThreadAPI() : nullptr;
+			if (!BodyLocal || BodyLocal->ObjectState() == Chaos::EObjectStateType::Kinematic || BodyLocal->ObjectState() == Chaos::EObjectStateType::Static)
+			{
+				continue;
+			}
+
+			const FVector BodyLocationLocal = BodyLocal->X();
+			const FVector ArmLocal = BodyLocal->R().RotateVector(TetherLocal.LocalOffset);
+			const FVector ToHolderLocal = TetherLocal.HolderLocation - (BodyLocationLocal + ArmLocal);
+			const double DistanceLocal = ToHolderLocal.Size();
+			if (DistanceLocal <= TetherLocal.Length || DistanceLocal <= KINDA_SMALL_NUMBER)
+			{
+				// slack, a rope doesn't push
+				continue;
+			}
+
+			// spring on the stretch, damped along the tether, never pushing
+			const FVector DirectionLocal = ToHolderLocal / DistanceLocal;
+			const FVector PointVelocityLocal = BodyLocal->V() + FVector::CrossProduct(BodyLocal->W(), ArmLocal);
+			const double AccelerationLocal = FMath::Clamp((TetherLocal.Settings.Stiffness * (DistanceLocal - TetherLocal.Length)) - (TetherLocal.Settings.Damping * FVector::DotProduct(PointVelocityLocal, DirectionLocal)), 0.0, static_cast<double>(TetherLocal.Settings.MaxAcceleration));
+			if (AccelerationLocal <= 0.0)
+			{
+				continue;
+			}
+
+			if (BodyLocal->ObjectState() == Chaos::EObjectStateType::Sleeping)
+			{
+				BodyLocal->SetObjectState(Chaos::EObjectStateType::Dynamic);
+			}
+			const FVector ForceLocal = DirectionLocal * (AccelerationLocal * BodyLocal->M());
+			BodyLocal->AddForce(ForceLocal);
+			BodyLocal->AddTorque(FVector::CrossProduct(ArmLocal, ForceLocal));
+		}
+	}
+};
+
+bool UGrappleTetherSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGrappleTetherSubsystem::Deinitialize()
+{
+	if (TetherCallback)
+	{
+		FPhysScene* PhysSceneLocal = GetWorld()->GetPhysicsScene();
+		if (Chaos::FPhysicsSolver* SolverLocal = PhysSceneLocal ? PhysSceneLocal->GetSolver() : nullptr)
+		{
+			SolverLocal->UnregisterAndFreeSimCallbackObject_External(TetherCallback);
+		}
+		TetherCallback = nullptr;
+	}
+	for (const FTether& TetherLocal : Tethers)
+	{
+		if (UPrimitiveComponent* BodyLocal = TetherLocal.Body.Get())
+		{
+			BodyLocal->OnComponentPhysicsStateChanged.RemoveDynamic(this, &UGrappleTetherSubsystem::OnBodyPhysicsStateChanged);
+		}
+	}
+	Tethers.Reset();
+
+	Super::Deinitialize();
+}
+
+void UGrappleTetherSubsystem::Tick(float DeltaTime)
+{
+	GRAPPLE_LLM_SCOPE(Tethers);
+	Super::Tick(DeltaTime);
+
+	for (int32 IndexLocal = Tethers.Num() - 1; IndexLocal >= 0; --IndexLocal)
+	{
+		const FTether& TetherLocal = Tethers[IndexLocal];
+		if (!TetherLocal.Body.IsValid() || !TetherLocal.Holder.IsValid() || !TetherLocal.Body->IsSimulatingPhysics())
+		{
+			UPrimitiveComponent* BodyLocal = TetherLocal.Body.Get();
+			Tethers.RemoveAtSwap(IndexLocal);
+			UnbindBody(BodyLocal);
+		}
+	}
+	if (Tethers.Num() == 0 && bSentEmpty)
+	{
+		return;
+	}
+
+	for (FTether& TetherLocal : Tethers)
+	{
+		TetherLocal.Length = FMath::Max(TetherLocal.Length - (TetherLocal.Settings.ReelInSpeed * DeltaTime), FMath::Min(TetherLocal.Length, TetherLocal.Settings.MinLength));
+	}
+	SendSnapshot();
+}
+
+TStatId UGrappleTetherSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGrappleTetherSubsystem, STATGROUP_Tickables);
+}
+
+void UGrappleTetherSubsystem::SendSnapshot()
+{
+	FGrappleTetherCallback* CallbackLocal = GetOrCreateCallback();
+	FGrappleTetherAsyncInput* InputLocal = CallbackLocal ? CallbackLocal->GetProducerInputData_External() : nullptr;
+	if (!InputLocal)
+	{
+		return;
+	}
+
+	InputLocal->Tethers.Reset(Tethers.Num());
+	for (const FTether& TetherLocal : Tethers)
+	{
+		// the proxy is looked up every frame, it changes whenever the body's physics state is recreated
+		const FBodyInstance* BodyInstanceLocal = TetherLocal.Body.IsValid() && TetherLocal.Holder.IsValid() ? TetherLocal.Body->GetBodyInstance() : nullptr;
+		if (!BodyInstanceLocal || !BodyInstanceLocal->ActorHandle)
+		{
+			continue;
+		}
+
+		FGrappleTetherAsyncTether& AsyncTetherLocal = InputLocal->Tethers.AddDefaulted_GetRef();
+		AsyncTetherLocal.Proxy = BodyInstanceLocal->ActorHandle;
+		AsyncTetherLocal.LocalOffset = TetherLocal.LocalOffset;
+		AsyncTetherLocal.HolderLocation = TetherLocal.Holder->GetComponentLocation();
+		AsyncTetherLocal.Length = TetherLocal.Length;
+		AsyncTetherLocal.Settings = TetherLocal.Settings;
+	}
+	bSentEmpty = InputLocal->Tethers.Num() == 0;
+}
+
+int32 UGrappleTetherSubsystem::AddTether(UPrimitiveComponent* Body, const FVector& Location, const USceneComponent* Holder, const FGrappleTetherSettings& Settings)
+{
+	const FBodyInstance* BodyInstanceLocal = Body ? Body->GetBodyInstance() : nullptr;
+	if (!BodyInstanceLocal || !Holder || !Body->IsSimulatingPhysics())
+	{
+		return INDEX_NONE;
+	}
+	GRAPPLE_LLM_SCOPE(Tethers);
+
+	// the physics particle has the body's transform without its scale
+	FTransform BodyTransformLocal = BodyInstanceLocal->GetUnrealWorldTransform();
+	BodyTransformLocal.RemoveScaling();
+
+	FTether& TetherLocal = Tethers.AddDefaulted_GetRef();
+	TetherLocal.Id = NextTetherId++;
+	TetherLocal.Body = Body;
+	TetherLocal.LocalOffset = BodyTransformLocal.InverseTransformPosition(Location);
+	TetherLocal.Holder = Holder;
+	TetherLocal.Length = FVector::Dist(Location, Holder->GetComponentLocation());
+	TetherLocal.Settings = Settings;
+
+	Body->OnComponentPhysicsStateChanged.AddUniqueDynamic(this, &UGrappleTetherSubsystem::OnBodyPhysicsStateChanged);
+	return TetherLocal.Id;
+}
+
+void UGrappleTetherSubsystem::RemoveTether(int32 TetherId)
+{
+	const int32 IndexLocal = Tethers.IndexOfByPredicate([TetherId](const FTether& TetherLocal) { return TetherLocal.Id == TetherId; });
+	if (IndexLocal != INDEX_NONE)
+	{
+		UPrimitiveComponent* BodyLocal = Tethers[IndexLocal].Body.Get();
+		Tethers.RemoveAtSwap(IndexLocal);
+		UnbindBody(BodyLocal);
+	}
+}
+
+void UGrappleTetherSubsystem::UnbindBody(UPrimitiveComponent* Body)
+{
+	if (Body && !Tethers.ContainsByPredicate([Body](const FTether& TetherLocal) { return TetherLocal.Body.Get(true) == Body; }))
+	{
+		Body->OnComponentPhysicsStateChanged.RemoveDynamic(this, &UGrappleTetherSubsystem::OnBodyPhysicsStateChanged);
+	}
+}
+
+void UGrappleTetherSubsystem::OnBodyPhysicsStateChanged(UPrimitiveComponent* ChangedComponent, EComponentPhysicsStateChange StateChange)
+{
+	if (StateChange != EComponentPhysicsStateChange::Destroyed)
+	{
+		return;
+	}
+	GRAPPLE_LLM_SCOPE(Tethers);
+
+	// the component may already be on its way out
+	const int32 NumRemovedLocal = Tethers.RemoveAllSwap([ChangedComponent](const FTether& TetherLocal) { return TetherLocal.Body.Get(true) == ChangedComponent; });
+	UnbindBody(ChangedComponent);
+
+	// the particle proxy is deleted with this frame's physics data, the snapshot going with it must not hold it (even if Tick already sent one)
+	if (NumRemovedLocal > 0 && TetherCallback)
+	{
+		SendSnapshot();
+	}
+}
+
+FGrappleTetherCallback* UGrappleTetherSubsystem::GetOrCreateCallback()
+{
+	if (!TetherCallback)
+	{
+		FPhysScene* PhysSceneLocal = GetWorld()->GetPhysicsScene();
+		if (Chaos::FPhysicsSolver* SolverLocal = PhysSceneLocal ? PhysSceneLocal->GetSolver() : nullptr)
+		{
+			TetherCallback = SolverLocal->CreateAndRegisterSimCallbackObject_External<FGrappleTetherCallback>();
+		}
+	}
+	return TetherCallback;
+}
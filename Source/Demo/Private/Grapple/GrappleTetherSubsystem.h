@@ -0,0 +1,102 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "GrappleTetherSubsystem.generated.h"
+
+class FGrappleTetherCallback;
+
+/** How hard a tether pulls on its body. Mass normalized, so the same settings drag a light crate and swing a heavy door alike */
+USTRUCT(BlueprintType)
+struct FGrappleTetherSettings
+{
+	GENERATED_BODY()
+
+	/** Pull per cm the tether is stretched past its length (1/s^2) */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Tether", meta = (ClampMin = "0.0"))
+	float Stiffness{ 30.f };
+	/** Damping of the body's speed along the tether (1/s) */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Tether", meta = (ClampMin = "0.0"))
+	float Damping{ 6.f };
+	/** How fast the tether is wound in (cm/s) */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Tether", meta = (ClampMin = "0.0"))
+	float ReelInSpeed{ 400.f };
+	/** The tether isn't wound in shorter than this */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Tether", meta = (ClampMin = "0.0"))
+	float MinLength{ 150.f };
+	/** Cap on the pull (cm/s^2) */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Tether", meta = (ClampMin = "0.0"))
+	float MaxAcceleration{ 4000.f };
+};
+
+/**
+ * Tethers between simulating bodies and a holder (the grapple gun). The game thread only winds the tethers in and hands the physics thread a
+ * snapshot once per frame; the tension forces are applied in a Chaos sim callback on every physics step, with the frame, or at the async physics rate
+ * where a project turns bTickPhysicsAsync on. Nothing is read back from the physics thread, so the game thread never waits on it however many tethers there are.
+ * A body losing its physics state drops its tethers right away and the frame's snapshot is rewritten without them, so the physics thread never
+ * keeps a particle proxy past the frame that deletes it.
+ * Tethers belong to the authority, clients see the bodies through their replicated movement.
+ */
+UCLASS()
+class UGrappleTetherSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	/** One tether, game thread side */
+	struct FTether
+	{
+		int32 Id{ INDEX_NONE };
+		TWeakObjectPtr<UPrimitiveComponent> Body;
+		/** Where the tether is tied, in body space (unscaled) */
+		FVector LocalOffset{ 0.f };
+		TWeakObjectPtr<const USceneComponent> Holder;
+		/** Current length, wound in at Settings.ReelInSpeed */
+		float Length{ 0.f };
+		FGrappleTetherSettings Settings;
+	};
+
+	TArray<FTether> Tethers;
+	int32 NextTetherId{ 0 };
+	/** Registered with the world's solver on the first tether */
+	FGrappleTetherCallback* TetherCallback{ nullptr };
+	/** The physics thread was last sent an empty snapshot, nothing to send until a tether is added */
+	bool bSentEmpty{ true };
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* INHERITED METHODS
+	********************************/
+public:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/********************************
+	* MEMBER METHODS
+	********************************/
+public:
+	/** Ties Body (at Location, world space) to Holder with the current distance as the tether length. Returns the tether id, INDEX_NONE if Body doesn't simulate physics */
+	int32 AddTether(UPrimitiveComponent* Body, const FVector& Location, const USceneComponent* Holder, const FGrappleTetherSettings& Settings);
+	void RemoveTether(int32 TetherId);
+	FORCEINLINE int32 GetNumTethers() const { return Tethers.Num(); }
+
+protected:
+	FGrappleTetherCallback* GetOrCreateCallback();
+	/** Fills this frame's physics thread input from Tethers. Writing again in the same frame replaces the earlier snapshot */
+	void SendSnapshot();
+	/** Stops watching Body once no tether uses it */
+	void UnbindBody(UPrimitiveComponent* Body);
+	/** Drops the tethers of a body whose physics state is destroyed (unregistered, destroyed or recreated), in the same frame */
+	UFUNCTION()
+	void OnBodyPhysicsStateChanged(UPrimitiveComponent* ChangedComponent, EComponentPhysicsStateChange StateChange);
+};
@@ -0,0 +1,333 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleMassProcessors.h"
+#include "GrappleMassTypes.h"
+#include "MassEntitySubsystem.h"
+#include "MassCommonFragments.h"
+#include "MassCommonTypes.h"
+#include "Character/GrappleCharacter.h"
+#include "Character/GrappleMovementComponent.h"
+#include "Grapple/GrappleAnchorSubsystem.h"
+#include "Grapple/GrappleStats.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+/********************************
+* MOVEMENT
+********************************/
+UGrappleMassMovementProcessor::UGrappleMassMovementProcessor()
+{
+	// the server (or standalone game) owns the simulation
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::Server | EProcessorExecutionFlags::Standalone);
+	ExecutionOrder.ExecuteInGroup = UE::Mass::ProcessorGroupNames::Movement;
+}
+
+void UGrappleMassMovementProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FGrappleMassFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddConstSharedRequirement<FGrappleMassParameters>(EMassFragmentPresence::All);
+	EntityQuery.AddTagRequirement<FGrapplePromotedTag>(EMassFragmentPresence::None);
+}
+
+void UGrappleMassMovementProcessor::Execute(UMassEntitySubsystem& EntitySubsystem, FMassExecutionContext& Context)
+{
+	GRAPPLE_SCOPE_CYCLE_COUNTER(MassMovement);
+	EntityQuery.ForEachEntityChunk(EntitySubsystem, Context, [this](FMassExecutionContext& Context)
+	{
+		const TArrayView<FTransformFragment> TransformsLocal = Context.GetMutableFragmentView<FTransformFragment>();
+		const TArrayView<FGrappleMassFragment> GrapplesLocal = Context.GetMutableFragmentView<FGrappleMassFragment>();
+		const FGrappleMassParameters& ParametersLocal = Context.GetConstSharedFragment<FGrappleMassParameters>();
+		const float DeltaTimeLocal = Context.GetDeltaTimeSeconds();
+
+		PullEntities.Reset();
+		for (int32 EntityIndexLocal = 0; EntityIndexLocal < Context.GetNumEntities(); ++EntityIndexLocal)
+		{
+			FGrappleMassFragment& GrappleLocal = GrapplesLocal[EntityIndexLocal];
+			GrappleLocal.PhaseTime += DeltaTimeLocal;
+			if (GrappleLocal.Phase == EGrappleMassPhase::HookFlight)
+			{
+				// the flight the movement component runs: placed from the flight time, attached at the time fixed when firing
+				if (GrappleLocal.PhaseTime >= GrappleLocal.HookAttachTime)
+				{
+					GrappleLocal.HookLocation = GrappleLocal.Anchor;
+					GrappleLocal.Phase = EGrappleMassPhase::Pull;
+					GrappleLocal.PhaseTime = 0.f;
+				}
+				else
+				{
+					GrappleLocal.HookLocation = FGrappleSolver::GetHookLocation(GrappleLocal.HookStartLocation, GrappleLocal.Anchor, ParametersLocal.GrappleAttachSpeed, GrappleLocal.PhaseTime);
+				}
+			}
+			else if (GrappleLocal.Phase == EGrappleMassPhase::Pull)
+			{
+				PullEntities.Add(EntityIndexLocal);
+			}
+		}
+
+		PullBatch.SetNum(PullEntities.Num());
+		for (int32 LaneLocal = 0; LaneLocal < PullEntities.Num(); ++LaneLocal)
+		{
+			const int32 EntityIndexLocal = PullEntities[LaneLocal];
+			PullBatch.Set(LaneLocal, TransformsLocal[EntityIndexLocal].GetTransform().GetLocation(), GrapplesLocal[EntityIndexLocal].Anchor);
+		}
+		FGrappleSolver::StepPulls(PullBatch, FGrappleSolver::GetPullRemaining(ParametersLocal.PlayerGrappleSpeed, DeltaTimeLocal), ParametersLocal.GrappleAcceptanceRadius);
+		for (int32 LaneLocal = 0; LaneLocal < PullEntities.Num(); ++LaneLocal)
+		{
+			const int32 EntityIndexLocal = PullEntities[LaneLocal];
+			TransformsLocal[EntityIndexLocal].GetMutableTransform().SetLocation(PullBatch.GetLocation(LaneLocal));
+			if (PullBatch.Reached[LaneLocal])
+			{
+				FGrappleMassFragment& GrappleLocal = GrapplesLocal[EntityIndexLocal];
+				GrappleLocal.Phase = EGrappleMassPhase::GroundCheck;
+				GrappleLocal.PhaseTime = 0.f;
+				GrappleLocal.GroundTrace = FTraceHandle();
+			}
+		}
+	});
+}
+
+/********************************
+* QUERIES
+********************************/
+UGrappleMassQueryProcessor::UGrappleMassQueryProcessor()
+{
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::Server | EProcessorExecutionFlags::Standalone);
+	ExecutionOrder.ExecuteInGroup = UE::Mass::ProcessorGroupNames::Movement;
+	ExecutionOrder.ExecuteAfter.Add(UGrappleMassMovementProcessor::StaticClass()->GetFName());
+	// world traces and the anchor tree are game thread only
+	bRequiresGameThreadExecution = true;
+}
+
+void UGrappleMassQueryProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FGrappleMassFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddConstSharedRequirement<FGrappleMassParameters>(EMassFragmentPresence::All);
+	EntityQuery.AddTagRequirement<FGrapplePromotedTag>(EMassFragmentPresence::None);
+}
+
+void UGrappleMassQueryProcessor::Execute(UMassEntitySubsystem& EntitySubsystem, FMassExecutionContext& Context)
+{
+	GRAPPLE_SCOPE_CYCLE_COUNTER(MassQueries);
+	UWorld* WorldLocal = EntitySubsystem.GetWorld();
+	const UGrappleAnchorSubsystem* AnchorSubsystemLocal = WorldLocal->GetSubsystem<UGrappleAnchorSubsystem>();
+	const FCollisionQueryParams QueryParamsLocal(SCENE_QUERY_STAT(GrappleMassGroundCheck), false);
+
+	EntityQuery.ForEachEntityChunk(EntitySubsystem, Context, [this, WorldLocal, AnchorSubsystemLocal, &QueryParamsLocal](FMassExecutionContext& Context)
+	{
+		const TArrayView<FTransformFragment> TransformsLocal = Context.GetMutableFragmentView<FTransformFragment>();
+		const TArrayView<FGrappleMassFragment> GrapplesLocal = Context.GetMutableFragmentView<FGrappleMassFragment>();
+		const FGrappleMassParameters& ParametersLocal = Context.GetConstSharedFragment<FGrappleMassParameters>();
+
+		for (int32 EntityIndexLocal = 0; EntityIndexLocal < Context.GetNumEntities(); ++EntityIndexLocal)
+		{
+			FGrappleMassFragment& GrappleLocal = GrapplesLocal[EntityIndexLocal];
+			FTransform& TransformLocal = TransformsLocal[EntityIndexLocal].GetMutableTransform();
+
+			if ((GrappleLocal.Phase == EGrappleMassPhase::Idle || GrappleLocal.Phase == EGrappleMassPhase::Arrived) && GrappleLocal.PhaseTime >= ParametersLocal.IdleTime)
+			{
+				// fire at a random anchor in range, try again after another idle period if there is none
+				FVector AnchorLocal{ 0.f };
+				GrappleLocal.PhaseTime = 0.f;
+				if (AnchorSubsystemLocal && AnchorSubsystemLocal->FindAnchorInRange(TransformLocal.GetLocation(), ParametersLocal.GrappleLength, RandomStream, AnchorLocal))
+				{
+					GrappleLocal.Anchor = AnchorLocal;
+					GrappleLocal.HookLocation = TransformLocal.GetLocation();
+					GrappleLocal.HookStartLocation = GrappleLocal.HookLocation;
+					GrappleLocal.HookAttachTime = FGrappleSolver::GetHookAttachTime(FVector::Dist(GrappleLocal.HookLocation, AnchorLocal), ParametersLocal.GrappleAttachSpeed, ParametersLocal.HookAttachTolerance);
+					GrappleLocal.Phase = EGrappleMassPhase::HookFlight;
+				}
+			}
+			else if (GrappleLocal.Phase == EGrappleMassPhase::GroundCheck)
+			{
+				const FVector LocationLocal = TransformLocal.GetLocation();
+				if (!GrappleLocal.GroundTrace.IsValid())
+				{
+					const FVector EndLocationLocal = LocationLocal - FVector(0.f, 0.f, ParametersLocal.GrappleAcceptedFallDistance);
+					GrappleLocal.GroundTrace = WorldLocal->AsyncLineTraceByChannel(EAsyncTraceType::Single, LocationLocal, EndLocationLocal, ECollisionChannel::ECC_Visibility, QueryParamsLocal);
+					GrappleLocal.PhaseTime = 0.f;
+					continue;
+				}
+
+				FTraceDatum TraceDatumLocal;
+				if (!WorldLocal->QueryTraceData(GrappleLocal.GroundTrace, TraceDatumLocal))
+				{
+					// not finished yet (or the result expired, in which case the next frame traces again)
+					if (GrappleLocal.PhaseTime > 0.25f)
+					{
+						GrappleLocal.GroundTrace = FTraceHandle();
+					}
+					continue;
+				}
+				GrappleLocal.GroundTrace = FTraceHandle();
+				GrappleLocal.PhaseTime = 0.f;
+
+				if (TraceDatumLocal.OutHits.Num() > 0 && TraceDatumLocal.OutHits[0].bBlockingHit)
+				{
+					// close enough to the ground, break off and land on it
+					TransformLocal.SetLocation(TraceDatumLocal.OutHits[0].Location + FVector(0.f, 0.f, ParametersLocal.CapsuleHalfHeight));
+					GrappleLocal.Phase = EGrappleMassPhase::Idle;
+				}
+				else
+				{
+					// too high to drop off, hold at the anchor
+					GrappleLocal.Phase = EGrappleMassPhase::Arrived;
+				}
+			}
+		}
+	});
+}
+
+/********************************
+* PROMOTION
+********************************/
+UGrappleMassPromotionProcessor::UGrappleMassPromotionProcessor()
+{
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::Server | EProcessorExecutionFlags::Standalone);
+	ExecutionOrder.ExecuteInGroup = UE::Mass::ProcessorGroupNames::Movement;
+	ExecutionOrder.ExecuteAfter.Add(UGrappleMassQueryProcessor::StaticClass()->GetFName());
+	// spawns and destroys actors
+	bRequiresGameThreadExecution = true;
+}
+
+void UGrappleMassPromotionProcessor::ConfigureQueries()
+{
+	PromoteQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	PromoteQuery.AddRequirement<FGrappleMassFragment>(EMassFragmentAccess::ReadOnly);
+	PromoteQuery.AddRequirement<FGrappleMassActorFragment>(EMassFragmentAccess::ReadWrite);
+	PromoteQuery.AddConstSharedRequirement<FGrappleMassParameters>(EMassFragmentPresence::All);
+	PromoteQuery.AddTagRequirement<FGrapplePromotedTag>(EMassFragmentPresence::None);
+
+	DemoteQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+	DemoteQuery.AddRequirement<FGrappleMassFragment>(EMassFragmentAccess::ReadWrite);
+	DemoteQuery.AddRequirement<FGrappleMassActorFragment>(EMassFragmentAccess::ReadWrite);
+	DemoteQuery.AddConstSharedRequirement<FGrappleMassParameters>(EMassFragmentPresence::All);
+	DemoteQuery.AddTagRequirement<FGrapplePromotedTag>(EMassFragmentPresence::All);
+}
+
+void UGrappleMassPromotionProcessor::Execute(UMassEntitySubsystem& EntitySubsystem, FMassExecutionContext& Context)
+{
+	GRAPPLE_SCOPE_CYCLE_COUNTER(MassPromotion);
+	UWorld* WorldLocal = EntitySubsystem.GetWorld();
+
+	PlayerLocations.Reset();
+	for (FConstPlayerControllerIterator IteratorLocal = WorldLocal->GetPlayerControllerIterator(); IteratorLocal; ++IteratorLocal)
+	{
+		if (const APawn* PawnLocal = IteratorLocal->Get() ? IteratorLocal->Get()->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(PawnLocal->GetActorLocation());
+		}
+	}
+
+	PromoteQuery.ForEachEntityChunk(EntitySubsystem, Context, [this, WorldLocal](FMassExecutionContext& Context)
+	{
+		const TConstArrayView<FTransformFragment> TransformsLocal = Context.GetFragmentView<FTransformFragment>();
+		const TConstArrayView<FGrappleMassFragment> GrapplesLocal = Context.GetFragmentView<FGrappleMassFragment>();
+		const TArrayView<FGrappleMassActorFragment> ActorsLocal = Context.GetMutableFragmentView<FGrappleMassActorFragment>();
+		const FGrappleMassParameters& ParametersLocal = Context.GetConstSharedFragment<FGrappleMassParameters>();
+		UClass* ActorClassLocal = ParametersLocal.ActorClass ? ParametersLocal.ActorClass.Get() : AGrappleCharacter::StaticClass();
+
+		for (int32 EntityIndexLocal = 0; EntityIndexLocal < Context.GetNumEntities(); ++EntityIndexLocal)
+		{
+			const FTransform& TransformLocal = TransformsLocal[EntityIndexLocal].GetTransform();
+			if (!IsNearPlayer(TransformLocal.GetLocation(), ParametersLocal.PromotionDistance))
+			{
+				continue;
+			}
+
+			FActorSpawnParameters SpawnParametersLocal;
+			SpawnParametersLocal.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+			AGrappleCharacter* CharacterLocal = WorldLocal->SpawnActor<AGrappleCharacter>(ActorClassLocal, TransformLocal, SpawnParametersLocal);
+			if (!CharacterLocal)
+			{
+				continue;
+			}
+			if (!CharacterLocal->GetController())
+			{
+				CharacterLocal->SpawnDefaultController();
+			}
+
+			// hand over the grapple in progress
+			const FGrappleMassFragment& GrappleLocal = GrapplesLocal[EntityIndexLocal];
+			if (GrappleLocal.Phase != EGrappleMassPhase::Idle)
+			{
+				const bool bAttachedLocal = GrappleLocal.Phase != EGrappleMassPhase::HookFlight;
+				const bool bArrivedLocal = GrappleLocal.Phase == EGrappleMassPhase::Arrived;
+				CharacterLocal->AdoptGrappleState(GrappleLocal.Anchor, GrappleLocal.HookLocation, bAttachedLocal, bArrivedLocal);
+			}
+
+			ActorsLocal[EntityIndexLocal].Actor = CharacterLocal;
+			Context.Defer().AddTag<FGrapplePromotedTag>(Context.GetEntity(EntityIndexLocal));
+		}
+	});
+
+	DemoteQuery.ForEachEntityChunk(EntitySubsystem, Context, [this](FMassExecutionContext& Context)
+	{
+		const TArrayView<FTransformFragment> TransformsLocal = Context.GetMutableFragmentView<FTransformFragment>();
+		const TArrayView<FGrappleMassFragment> GrapplesLocal = Context.GetMutableFragmentView<FGrappleMassFragment>();
+		const TArrayView<FGrappleMassActorFragment> ActorsLocal = Context.GetMutableFragmentView<FGrappleMassActorFragment>();
+		const FGrappleMassParameters& ParametersLocal = Context.GetConstSharedFragment<FGrappleMassParameters>();
+
+		for (int32 EntityIndexLocal = 0; EntityIndexLocal < Context.GetNumEntities(); ++EntityIndexLocal)
+		{
+			AGrappleCharacter* CharacterLocal = ActorsLocal[EntityIndexLocal].Actor.Get();
+			if (!CharacterLocal)
+			{
+				// actor went away on its own, resume in Mass from the last known state
+				Context.Defer().RemoveTag<FGrapplePromotedTag>(Context.GetEntity(EntityIndexLocal));
+				continue;
+			}
+
+			// the actor is the authority while promoted
+			FTransform& TransformLocal = TransformsLocal[EntityIndexLocal].GetMutableTransform();
+			TransformLocal = CharacterLocal->GetActorTransform();
+			if (IsNearPlayer(TransformLocal.GetLocation(), ParametersLocal.DemotionDistance))
+			{
+				continue;
+			}
+
+			FGrappleMassFragment& GrappleLocal = GrapplesLocal[EntityIndexLocal];
+			GrappleLocal.Anchor = CharacterLocal->GetAttachLocation();
+			GrappleLocal.HookLocation = CharacterLocal->GetGrappleMovement()->GetHookLocation();
+			GrappleLocal.HookStartLocation = GrappleLocal.HookLocation;
+			GrappleLocal.PhaseTime = 0.f;
+			GrappleLocal.GroundTrace = FTraceHandle();
+			if (!CharacterLocal->GetGrappleActive())
+			{
+				GrappleLocal.Phase = EGrappleMassPhase::Idle;
+			}
+			else if (!CharacterLocal->GetGrappleAttached())
+			{
+				GrappleLocal.HookAttachTime = FGrappleSolver::GetHookAttachTime(FVector::Dist(GrappleLocal.HookLocation, GrappleLocal.Anchor), ParametersLocal.GrappleAttachSpeed, ParametersLocal.HookAttachTolerance);
+				GrappleLocal.Phase = EGrappleMassPhase::HookFlight;
+			}
+			else
+			{
+				GrappleLocal.Phase = CharacterLocal->GetArrived() ? EGrappleMassPhase::Arrived : EGrappleMassPhase::Pull;
+			}
+
+			if (AController* ControllerLocal = CharacterLocal->GetController())
+			{
+				ControllerLocal->Destroy();
+			}
+			CharacterLocal->Destroy();
+			ActorsLocal[EntityIndexLocal].Actor.Reset();
+			Context.Defer().RemoveTag<FGrapplePromotedTag>(Context.GetEntity(EntityIndexLocal));
+		}
+	});
+}
+
+bool UGrappleMassPromotionProcessor::IsNearPlayer(const FVector& Location, float Distance) const
+{
+	const double DistanceSquaredLocal = FMath::Square(static_cast<double>(Distance));
+	for (const FVector& PlayerLocationLocal : PlayerLocations)
+	{
+		if (FVector::DistSquared(PlayerLocationLocal, Location) <= DistanceSquaredLocal)
+		{
+			return true;
+		}
+	}
+	return false;
+}
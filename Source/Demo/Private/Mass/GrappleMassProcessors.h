@@ -0,0 +1,124 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "Grapple/GrappleSolver.h"
+#include "GrappleMassProcessors.generated.h"
+
+/**
+ * Hook flight and pull for every non promoted grappler, chunk by chunk, with the same FGrappleSolver math as UGrappleMovementComponent: the hook
+ * is placed from its flight time (GetHookLocation), the pull is stepped as one batch per chunk (all entities of a chunk share their parameters).
+ * No sweeps, background grapplers fly through geometry. Entities that reach their anchor move on to GroundCheck, the trace itself is issued by
+ * UGrappleMassQueryProcessor.
+ */
+UCLASS()
+class UGrappleMassMovementProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	FMassEntityQuery EntityQuery;
+
+	/** Scratch batch (and the chunk entity each lane came from), reused between chunks */
+	FGrappleSolver::FBatch PullBatch;
+	TArray<int32> PullEntities;
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleMassMovementProcessor();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(UMassEntitySubsystem& EntitySubsystem, FMassExecutionContext& Context) override;
+};
+
+/**
+ * Game thread work of the Mass grapplers: picks anchors for idle entities from the grapple anchor subsystem and runs the arrival ground checks
+ * as async traces (issued in one frame, collected in the next), so no entity ever waits on a blocking scene query.
+ */
+UCLASS()
+class UGrappleMassQueryProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	FMassEntityQuery EntityQuery;
+	FRandomStream RandomStream;
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleMassQueryProcessor();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(UMassEntitySubsystem& EntitySubsystem, FMassExecutionContext& Context) override;
+};
+
+/**
+ * Promotes grapplers near player pawns to full AGrappleCharacter actors (handing over the grapple in progress) and demotes them back to Mass
+ * once every player is far enough away.
+ */
+UCLASS()
+class UGrappleMassPromotionProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	/** Entities still in Mass */
+	FMassEntityQuery PromoteQuery;
+	/** Entities represented by an actor */
+	FMassEntityQuery DemoteQuery;
+	/** Player pawn locations of this frame */
+	TArray<FVector> PlayerLocations;
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* CONSTRUCTORS
+	********************************/
+public:
+	UGrappleMassPromotionProcessor();
+
+	/********************************
+	* INHERITED METHODS
+	********************************/
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(UMassEntitySubsystem& EntitySubsystem, FMassExecutionContext& Context) override;
+
+	/********************************
+	* MEMBER METHODS
+	********************************/
+protected:
+	/** Is any player pawn within Distance of Location */
+	bool IsNearPlayer(const FVector& Location, float Distance) const;
+};
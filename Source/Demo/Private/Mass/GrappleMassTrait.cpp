@@ -0,0 +1,21 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "GrappleMassTrait.h"
+#include "MassEntityTemplateRegistry.h"
+#include "MassEntitySubsystem.h"
+#include "MassCommonFragments.h"
+#include "Engine/World.h"
+
+void UGrappleMassTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, UWorld& World) const
+{
+	BuildContext.RequireFragment<FTransformFragment>();
+	BuildContext.AddFragment<FGrappleMassFragment>();
+	BuildContext.AddFragment<FGrappleMassActorFragment>();
+
+	// one shared copy per distinct set of parameters
+	UMassEntitySubsystem* EntitySubsystemLocal = UWorld::GetSubsystem<UMassEntitySubsystem>(&World);
+	check(EntitySubsystemLocal);
+	const uint32 ParametersHashLocal = UE::StructUtils::GetStructCrc32(FConstStructView::Make(Parameters));
+	BuildContext.AddConstSharedFragment(EntitySubsystemLocal->GetOrCreateConstSharedFragment<FGrappleMassParameters>(ParametersHashLocal, Parameters));
+}
@@ -0,0 +1,31 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTraitBase.h"
+#include "GrappleMassTypes.h"
+#include "GrappleMassTrait.generated.h"
+
+/** Adds the grapple fragments to a Mass entity config (needs a transform, e.g. from the Assorted Fragments trait) */
+UCLASS(meta = (DisplayName = "Grappler"))
+class UGrappleMassTrait : public UMassEntityTraitBase
+{
+	GENERATED_BODY()
+
+/*************************************
+* ATTRIBUTES
+*************************************/
+protected:
+	UPROPERTY(EditAnywhere, Category = "Grappling")
+	FGrappleMassParameters Parameters;
+
+/*************************************
+* METHODS
+*************************************/
+	/********************************
+	* INHERITED METHODS
+	********************************/
+protected:
+	virtual void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, UWorld& World) const override;
+};
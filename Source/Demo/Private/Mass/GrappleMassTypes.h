@@ -0,0 +1,103 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "Engine/EngineTypes.h"
+#include "GrappleMassTypes.generated.h"
+
+class AGrappleCharacter;
+
+/** Where a Mass grappler is in its grapple cycle */
+UENUM()
+enum class EGrappleMassPhase : uint8
+{
+	/** Standing/hanging, fires again after the idle time */
+	Idle,
+	/** Hook travelling to the anchor */
+	HookFlight,
+	/** Pulled towards the anchor */
+	Pull,
+	/** Reached the anchor, waiting on the ground check trace */
+	GroundCheck,
+	/** Holding at the anchor (too high to drop off) */
+	Arrived,
+};
+
+/** Per-entity grapple state (the Mass version of the grapple states on AGrappleCharacter and the hook of UGrappleMovementComponent) */
+USTRUCT()
+struct FGrappleMassFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector Anchor{ 0.f };
+	FVector HookLocation{ 0.f };
+	/** Where the hook was fired from, its flight is a function of this, the anchor and PhaseTime */
+	FVector HookStartLocation{ 0.f };
+	/** Time spent in the current phase (the hook flight time during HookFlight) */
+	float PhaseTime{ 0.f };
+	/** HookFlight: phase time at which the hook attaches (computed when it is fired) */
+	float HookAttachTime{ 0.f };
+	EGrappleMassPhase Phase{ EGrappleMassPhase::Idle };
+	/** Async ground check trace in flight (GroundCheck phase) */
+	FTraceHandle GroundTrace;
+};
+
+/** Actor standing in for the entity while it is promoted */
+USTRUCT()
+struct FGrappleMassActorFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	TWeakObjectPtr<AGrappleCharacter> Actor;
+};
+
+/** Entity is currently represented by a full AGrappleCharacter, the Mass grapple processors leave it alone */
+USTRUCT()
+struct FGrapplePromotedTag : public FMassTag
+{
+	GENERATED_BODY()
+};
+
+/** Grapple tuning shared by every entity of a config (same meaning as the settings on AGrappleCharacter) */
+USTRUCT()
+struct FGrappleMassParameters : public FMassSharedFragment
+{
+	GENERATED_BODY()
+
+	/** How far away anchors are picked */
+	UPROPERTY(EditAnywhere, Category = "Grappling")
+	float GrappleLength{ 10000.f };
+	/** Hook flight speed (see AGrappleCharacter::GrappleAttachSpeed) */
+	UPROPERTY(EditAnywhere, Category = "Grappling")
+	float GrappleAttachSpeed{ 50.f };
+	/** Pull speed (see AGrappleCharacter::PlayerGrappleSpeed) */
+	UPROPERTY(EditAnywhere, Category = "Grappling")
+	float PlayerGrappleSpeed{ 250.f };
+	/** Arrival tolerance per axis */
+	UPROPERTY(EditAnywhere, Category = "Grappling")
+	float GrappleAcceptanceRadius{ 45.f };
+	/** Ground closer than this below the arrival point drops the entity to the ground */
+	UPROPERTY(EditAnywhere, Category = "Grappling")
+	float GrappleAcceptedFallDistance{ 150.f };
+	/** How close the hook must get to count as attached */
+	UPROPERTY(EditAnywhere, Category = "Grappling")
+	float HookAttachTolerance{ 10.f };
+	/** Half height of the capsule the entity stands in for (used when dropping to the ground) */
+	UPROPERTY(EditAnywhere, Category = "Grappling")
+	float CapsuleHalfHeight{ 90.f };
+	/** How long an idle or arrived entity waits before firing at a new anchor */
+	UPROPERTY(EditAnywhere, Category = "Grappling")
+	float IdleTime{ 2.f };
+
+	/** Actor the entity is promoted to near players */
+	UPROPERTY(EditAnywhere, Category = "Promotion")
+	TSubclassOf<AGrappleCharacter> ActorClass;
+	/** Entities closer than this to a player pawn are promoted to ActorClass */
+	UPROPERTY(EditAnywhere, Category = "Promotion")
+	float PromotionDistance{ 3000.f };
+	/** Promoted entities further than this from every player pawn go back to Mass (larger than PromotionDistance so they don't flip back and forth) */
+	UPROPERTY(EditAnywhere, Category = "Promotion")
+	float DemotionDistance{ 4000.f };
+};
@@ -0,0 +1,48 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "Misc/AutomationTest.h"
+#include "Commandlets/GrappleBehaviorScenarios.h"
+#include "Commandlets/GrappleCommandletUtils.h"
+#include "Engine/StaticMesh.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * The GrappleBehaviorCheck scenarios as automation tests: each spawns the grapple character in its own headless world and checks the attach,
+ * the arrival, the hold or drop and the break off. Only the behavior, the commandlet gates the timings.
+ * Runs from the Session Frontend or -ExecCmds="Automation RunTests Demo.Grapple.Behavior".
+ */
+BEGIN_DEFINE_SPEC(FGrappleBehaviorSpec, "Demo.Grapple.Behavior", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+	UClass* CharacterClass{ nullptr };
+	UStaticMesh* Mesh{ nullptr };
+END_DEFINE_SPEC(FGrappleBehaviorSpec)
+
+void FGrappleBehaviorSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		CharacterClass = GrappleCommandletUtils::LoadCharacterClass(TEXT("/Game/Core/Character/BP_GrappleCharacter"));
+		Mesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+		TestNotNull(TEXT("BP_GrappleCharacter"), CharacterClass);
+		TestNotNull(TEXT("/Engine/BasicShapes/Cube"), Mesh);
+	});
+
+	for (const GrappleBehaviorCheck::FScenario& ScenarioLocal : GrappleBehaviorCheck::GetScenarios())
+	{
+		It(ScenarioLocal.Name, [this, &ScenarioLocal]()
+		{
+			if (!CharacterClass || !Mesh)
+			{
+				return;
+			}
+			const GrappleBehaviorCheck::FResult ResultLocal = GrappleBehaviorCheck::Run(ScenarioLocal, CharacterClass, Mesh);
+			for (const FString& FailureLocal : ResultLocal.Failures)
+			{
+				AddError(FailureLocal);
+			}
+		});
+	}
+}
+
+#endif
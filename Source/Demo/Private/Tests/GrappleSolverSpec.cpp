@@ -0,0 +1,124 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+
+#include "Misc/AutomationTest.h"
+#include "Grapple/GrappleSolver.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * The grapple timing the GrappleBehaviorCheck commandlet relies on, without a world: the hook attach time, the approach and the arrival tests,
+ * and the batch steps agreeing with them. Runs from the Session Frontend or -ExecCmds="Automation RunTests Demo.Grapple".
+ */
+BEGIN_DEFINE_SPEC(FGrappleSolverSpec, "Demo.Grapple.Solver", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+	/** Defaults of the grapple profile and the movement component */
+	static constexpr float AttachSpeed = 50.f;
+	static constexpr float PullSpeed = 250.f;
+	static constexpr float Tolerance = 10.f;
+	static constexpr float AcceptanceRadius = 45.f;
+	static constexpr float DeltaTime = 1.f / 60.f;
+END_DEFINE_SPEC(FGrappleSolverSpec)
+
+void FGrappleSolverSpec::Define()
+{
+	Describe("GetHookAttachTime", [this]()
+	{
+		It("is zero when the hook starts within the tolerance", [this]()
+		{
+			TestEqual(TEXT("attach time"), FGrappleSolver::GetHookAttachTime(Tolerance * 0.5f, AttachSpeed, Tolerance), 0.f);
+		});
+
+		It("puts the hook on the tolerance sphere at the attach time", [this]()
+		{
+			const FVector StartLocal(0.0, 0.0, 0.0);
+			const FVector TargetLocal(2000.0, 300.0, 1500.0);
+			const float AttachTimeLocal = FGrappleSolver::GetHookAttachTime(FVector::Dist(StartLocal, TargetLocal), AttachSpeed, Tolerance);
+			const FVector HookLocal = FGrappleSolver::GetHookLocation(StartLocal, TargetLocal, AttachSpeed, AttachTimeLocal);
+			TestEqual(TEXT("distance left at the attach time"), FVector::Dist(HookLocal, TargetLocal), static_cast<double>(Tolerance), 0.01);
+			TestTrue(TEXT("attached at the attach time"), FGrappleSolver::IsHookAttached(HookLocal, TargetLocal, Tolerance + 0.01f));
+			TestFalse(TEXT("attached a frame early"), FGrappleSolver::IsHookAttached(FGrappleSolver::GetHookLocation(StartLocal, TargetLocal, AttachSpeed, AttachTimeLocal - DeltaTime), TargetLocal, Tolerance));
+		});
+
+		It("never attaches without attach speed", [this]()
+		{
+			TestEqual(TEXT("attach time"), FGrappleSolver::GetHookAttachTime(1000.f, 0.f, Tolerance), TNumericLimits<float>::Max());
+		});
+	});
+
+	Describe("Approach", [this]()
+	{
+		It("lands the same place in one step or in frames", [this]()
+		{
+			const FVector StartLocal(-500.0, 250.0, 80.0);
+			const FVector TargetLocal(1200.0, -40.0, 900.0);
+			FVector SteppedLocal = StartLocal;
+			for (int32 FrameLocal = 0; FrameLocal < 30; ++FrameLocal)
+			{
+				SteppedLocal = FGrappleSolver::Approach(SteppedLocal, TargetLocal, FGrappleSolver::GetPullRemaining(PullSpeed, DeltaTime));
+			}
+			const FVector DirectLocal = FGrappleSolver::Approach(StartLocal, TargetLocal, FGrappleSolver::GetPullRemaining(PullSpeed, DeltaTime * 30.f));
+			TestTrue(TEXT("frame rate independent"), SteppedLocal.Equals(DirectLocal, 0.01));
+		});
+
+		It("pulls a wrapped rope towards the pivot by its share of the whole rope", [this]()
+		{
+			const FVector LocationLocal(0.0, 0.0, 0.0);
+			const FVector PivotLocal(100.0, 0.0, 0.0);
+			TestTrue(TEXT("unwrapped is Approach"), FGrappleSolver::ApproachAlongRope(LocationLocal, PivotLocal, 0.0, 0.5f).Equals(FGrappleSolver::Approach(LocationLocal, PivotLocal, 0.5f)));
+			TestTrue(TEXT("never passes the pivot"), FGrappleSolver::ApproachAlongRope(LocationLocal, PivotLocal, 1000.0, 0.5f).Equals(PivotLocal));
+		});
+	});
+
+	Describe("HasArrived", [this]()
+	{
+		It("tests each axis against the acceptance radius", [this]()
+		{
+			const FVector TargetLocal(0.0, 0.0, 0.0);
+			// 45 cm on every axis is 78 cm away, still accepted per axis
+			TestTrue(TEXT("corner of the acceptance box"), FGrappleSolver::HasArrived(FVector(AcceptanceRadius), TargetLocal, AcceptanceRadius));
+			TestFalse(TEXT("past one axis"), FGrappleSolver::HasArrived(FVector(AcceptanceRadius + 1.f, 0.f, 0.f), TargetLocal, AcceptanceRadius));
+		});
+	});
+
+	Describe("FBatch", [this]()
+	{
+		It("steps like the scalar functions and reports only real grapples", [this]()
+		{
+			// not a multiple of the vector width, so the last lanes are padding
+			constexpr int32 NumLocal = 7;
+			FGrappleSolver::FBatch HooksLocal;
+			FGrappleSolver::FBatch PullsLocal;
+			HooksLocal.SetNum(NumLocal);
+			PullsLocal.SetNum(NumLocal);
+			TArray<FVector> StartsLocal;
+			TArray<FVector> TargetsLocal;
+			for (int32 IndexLocal = 0; IndexLocal < NumLocal; ++IndexLocal)
+			{
+				StartsLocal.Add(FVector(IndexLocal * 100.0, -IndexLocal * 50.0, 100.0));
+				// every other grapple starts nearly there
+				TargetsLocal.Add(IndexLocal % 2 == 0 ? StartsLocal.Last() + FVector(Tolerance * 0.5f) : FVector(3000.0, IndexLocal * 200.0, 1500.0));
+				HooksLocal.Set(IndexLocal, StartsLocal.Last(), TargetsLocal.Last());
+				PullsLocal.Set(IndexLocal, StartsLocal.Last(), TargetsLocal.Last());
+			}
+
+			const float HookRemainingLocal = FGrappleSolver::GetHookRemaining(AttachSpeed, DeltaTime);
+			const float PullRemainingLocal = FGrappleSolver::GetPullRemaining(PullSpeed, DeltaTime);
+			FGrappleSolver::StepHooks(HooksLocal, HookRemainingLocal, Tolerance);
+			FGrappleSolver::StepPulls(PullsLocal, PullRemainingLocal, AcceptanceRadius);
+
+			TestEqual(TEXT("grapples"), HooksLocal.Num(), NumLocal);
+			TestEqual(TEXT("reached flags"), HooksLocal.Reached.Num(), NumLocal);
+			for (int32 IndexLocal = 0; IndexLocal < NumLocal; ++IndexLocal)
+			{
+				const FVector HookLocal = HooksLocal.GetLocation(IndexLocal);
+				const FVector PullLocal = PullsLocal.GetLocation(IndexLocal);
+				TestTrue(*FString::Printf(TEXT("hook %d location"), IndexLocal), HookLocal.Equals(FGrappleSolver::Approach(StartsLocal[IndexLocal], TargetsLocal[IndexLocal], HookRemainingLocal), 0.001));
+				TestTrue(*FString::Printf(TEXT("pull %d location"), IndexLocal), PullLocal.Equals(FGrappleSolver::Approach(StartsLocal[IndexLocal], TargetsLocal[IndexLocal], PullRemainingLocal), 0.001));
+				TestEqual(*FString::Printf(TEXT("hook %d attached"), IndexLocal), HooksLocal.Reached[IndexLocal], FGrappleSolver::IsHookAttached(HookLocal, TargetsLocal[IndexLocal], Tolerance));
+				TestEqual(*FString::Printf(TEXT("pull %d arrived"), IndexLocal), PullsLocal.Reached[IndexLocal], FGrappleSolver::HasArrived(PullLocal, TargetsLocal[IndexLocal], AcceptanceRadius));
+			}
+		});
+	});
+}
+
+#endif
@@ -14,7 +14,8 @@ class UGrappleAnimationInterface : public UInterface
 };
 
 /**
- * 
+ * Jump notification for anim blueprints that don't derive from UGrappleAnimInstance (ABP_Rifle implements it). The character calls it in
+ * third person on jump press and release; UGrappleAnimInstance reads the jump state from its proxy instead.
  */
 class DEMO_API IGrappleAnimationInterface
 {
@@ -0,0 +1,16 @@
+// Copyright Two Neurons, LLC. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+public class DemoServerTarget : TargetRules
+{
+	public DemoServerTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Server;
+		DefaultBuildSettings = BuildSettingsVersion.V2;
+		ExtraModuleNames.Add("Demo");
+		// The grapple state replication marks properties dirty through the push model (the editor target has it on already)
+		bWithPushModel = true;
+	}
+}